@@ -41,6 +41,7 @@
 #include "ParkImporter.h"
 #include "platform/Crash.h"
 #include "PlatformEnvironment.h"
+#include "Profiling.h"
 #include "ride/TrackDesignRepository.h"
 #include "scenario/ScenarioRepository.h"
 #include "title/TitleScreen.h"
@@ -705,8 +706,9 @@ namespace OpenRCT2
             Update();
             if (!_isWindowMinimised && !gOpenRCT2Headless)
             {
-                drawing_engine_draw();
+                Draw();
             }
+            profiler_end_frame();
         }
 
         void RunVariableFrame()
@@ -748,14 +750,23 @@ namespace OpenRCT2
                 const float alpha = (float)_accumulator / GAME_UPDATE_TIME_MS;
                 sprite_position_tween_all(alpha);
 
-                drawing_engine_draw();
+                Draw();
 
                 sprite_position_tween_restore();
             }
+            profiler_end_frame();
+        }
+
+        void Draw()
+        {
+            ProfilerScope profilerScope(PROFILER_SECTION_FRAME_DRAW);
+            drawing_engine_draw();
         }
 
         void Update()
         {
+            ProfilerScope profilerScope(PROFILER_SECTION_FRAME_UPDATE);
+
             uint32 currentUpdateTick = platform_get_ticks();
             gTicksSinceLastUpdate = std::min<uint32>(currentUpdateTick - _lastUpdateTick, 500);
             _lastUpdateTick = currentUpdateTick;
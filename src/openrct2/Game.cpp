@@ -14,6 +14,7 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <memory>
 #include "audio/audio.h"
 #include "Cheats.h"
@@ -42,6 +43,7 @@
 #include "peep/Peep.h"
 #include "peep/Staff.h"
 #include "platform/platform.h"
+#include "Profiling.h"
 #include "rct1/RCT1.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
@@ -87,6 +89,36 @@ uint8 gUnk141F568;
 
 uint32 gCurrentTicks;
 
+bool   gGameLogicPhaseTimingEnabled = false;
+uint64 gGameLogicPhaseTimings[GAME_LOGIC_PHASE_COUNT];
+
+// clang-format off
+static constexpr const char * GameLogicPhaseNames[GAME_LOGIC_PHASE_COUNT] =
+{
+    "network_update",
+    "map_compact_tile_elements",
+    "scenario_update",
+    "climate_update",
+    "map_update_tiles",
+    "map_provisional_elements",
+    "map_update_path_wide_flags",
+    "peep_update_all",
+    "vehicle_update_all",
+    "sprite_misc_update_all",
+    "ride_update_all",
+    "park_update",
+    "research_update",
+    "ride_ratings_update_all",
+    "ride_measurements_update",
+    "news_item_update_current",
+    "map_animation_invalidate_all",
+    "sounds_update",
+    "editor_update",
+    "network_process_game_commands",
+    "network_flush",
+};
+// clang-format on
+
 GAME_COMMAND_CALLBACK_POINTER * game_command_callback = nullptr;
 static GAME_COMMAND_CALLBACK_POINTER * const game_command_callback_table[] = {
     nullptr,
@@ -445,13 +477,43 @@ void game_update()
     gInUpdateCode         = false;
 }
 
+const char * game_logic_phase_get_name(sint32 phase)
+{
+    if (phase < 0 || phase >= GAME_LOGIC_PHASE_COUNT)
+    {
+        return nullptr;
+    }
+    return GameLogicPhaseNames[phase];
+}
+
+void game_logic_phase_timings_reset()
+{
+    std::fill_n(gGameLogicPhaseTimings, GAME_LOGIC_PHASE_COUNT, 0);
+}
+
+static void game_logic_run_phase(GAME_LOGIC_PHASE phase, void (*func)())
+{
+    auto startTime = profiler_clock::now();
+    func();
+    auto endTime = profiler_clock::now();
+
+    uint64 elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+    profiler_record(phase, elapsed);
+    if (gGameLogicPhaseTimingEnabled)
+    {
+        gGameLogicPhaseTimings[phase] += elapsed;
+    }
+}
+
 void game_logic_update()
 {
+    ProfilerScope profilerScope(PROFILER_SECTION_GAME_LOGIC_UPDATE);
+
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
-    network_update();
+    game_logic_run_phase(GAME_LOGIC_PHASE_NETWORK_UPDATE, network_update);
 
     if (network_get_mode() == NETWORK_MODE_CLIENT && network_get_status() == NETWORK_STATUS_CONNECTED && network_get_authstatus() == NETWORK_AUTH_OK)
     {
@@ -474,29 +536,36 @@ void game_logic_update()
         network_check_desynchronization();
     }
 
-    sub_68B089();
-    scenario_update();
-    climate_update();
-    map_update_tiles();
-    // Temporarily remove provisional paths to prevent peep from interacting with them
-    map_remove_provisional_elements();
-    map_update_path_wide_flags();
-    peep_update_all();
-    map_restore_provisional_elements();
-    vehicle_update_all();
-    sprite_misc_update_all();
-    ride_update_all();
-    park_update();
-    research_update();
-    ride_ratings_update_all();
-    ride_measurements_update();
-    news_item_update_current();
-
-    map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
-    editor_open_windows_for_current_step();
+    game_logic_run_phase(GAME_LOGIC_PHASE_MAP_COMPACT_TILE_ELEMENTS, []() -> void
+    {
+        map_update_tile_summaries();
+        map_compact_tile_elements();
+    });
+    game_logic_run_phase(GAME_LOGIC_PHASE_SCENARIO_UPDATE, scenario_update);
+    game_logic_run_phase(GAME_LOGIC_PHASE_CLIMATE_UPDATE, climate_update);
+    game_logic_run_phase(GAME_LOGIC_PHASE_MAP_UPDATE_TILES, map_update_tiles);
+    // Temporarily remove provisional ride pieces to prevent peeps and rides from interacting with them
+    game_logic_run_phase(GAME_LOGIC_PHASE_MAP_PROVISIONAL_ELEMENTS, map_remove_provisional_elements);
+    game_logic_run_phase(GAME_LOGIC_PHASE_MAP_UPDATE_PATH_WIDE_FLAGS, map_update_path_wide_flags);
+    game_logic_run_phase(GAME_LOGIC_PHASE_PEEP_UPDATE_ALL, peep_update_all);
+    game_logic_run_phase(GAME_LOGIC_PHASE_MAP_PROVISIONAL_ELEMENTS, map_restore_provisional_elements);
+    game_logic_run_phase(GAME_LOGIC_PHASE_VEHICLE_UPDATE_ALL, vehicle_update_all);
+    game_logic_run_phase(GAME_LOGIC_PHASE_SPRITE_MISC_UPDATE_ALL, sprite_misc_update_all);
+    game_logic_run_phase(GAME_LOGIC_PHASE_RIDE_UPDATE_ALL, ride_update_all);
+    game_logic_run_phase(GAME_LOGIC_PHASE_PARK_UPDATE, park_update);
+    game_logic_run_phase(GAME_LOGIC_PHASE_RESEARCH_UPDATE, research_update);
+    game_logic_run_phase(GAME_LOGIC_PHASE_RIDE_RATINGS_UPDATE_ALL, ride_ratings_update_all);
+    game_logic_run_phase(GAME_LOGIC_PHASE_RIDE_MEASUREMENTS_UPDATE, ride_measurements_update);
+    game_logic_run_phase(GAME_LOGIC_PHASE_NEWS_ITEM_UPDATE_CURRENT, news_item_update_current);
+
+    game_logic_run_phase(GAME_LOGIC_PHASE_MAP_ANIMATION_INVALIDATE_ALL, map_animation_invalidate_all);
+    game_logic_run_phase(GAME_LOGIC_PHASE_SOUNDS_UPDATE, []() -> void
+    {
+        vehicle_sounds_update();
+        peep_update_crowd_noise();
+        climate_update_sound();
+    });
+    game_logic_run_phase(GAME_LOGIC_PHASE_EDITOR_UPDATE, editor_open_windows_for_current_step);
 
     // Update windows
     //window_dispatch_update_all();
@@ -523,9 +592,9 @@ void game_logic_update()
 
     // Separated out processing commands in network_update which could call scenario_rand where gInUpdateCode is false.
     // All commands that are received are first queued and then executed where gInUpdateCode is set to true.
-    network_process_game_commands();
+    game_logic_run_phase(GAME_LOGIC_PHASE_NETWORK_PROCESS_GAME_COMMANDS, network_process_game_commands);
 
-    network_flush();
+    game_logic_run_phase(GAME_LOGIC_PHASE_NETWORK_FLUSH, network_flush);
 
     gCurrentTicks++;
     gScenarioTicks++;
@@ -1282,6 +1351,7 @@ void game_fix_save_vars()
                 tileElement->base_height              = 2;
                 tileElement->clearance_height         = 2;
                 tileElement->properties.surface.slope = TILE_ELEMENT_SLOPE_FLAT;
+                map_invalidate_surface_height(x, y);
             }
         }
     }
@@ -1349,6 +1419,10 @@ void game_load_init()
 {
     rct_window * mainWindow;
 
+    litter_index_invalidate();
+    sprite_list_order_invalidate();
+    map_update_tiles_reset();
+
     gScreenFlags = SCREEN_FLAGS_PLAYING;
     audio_stop_all_music_and_sounds();
     if (!gLoadKeepWindowsOpen)
@@ -1418,7 +1492,7 @@ void game_load_init()
  */
 void reset_all_sprite_quadrant_placements()
 {
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < sprite_get_capacity(); i++)
     {
         rct_sprite * spr = get_sprite(i);
         if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL)
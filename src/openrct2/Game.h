@@ -123,6 +123,36 @@ enum
     ERROR_TYPE_FILE_LOAD = 255
 };
 
+/**
+ * The phases game_logic_update steps through each tick, in call order. Used to attribute simulation time
+ * to the subsystem that spent it.
+ */
+enum GAME_LOGIC_PHASE
+{
+    GAME_LOGIC_PHASE_NETWORK_UPDATE,
+    GAME_LOGIC_PHASE_MAP_COMPACT_TILE_ELEMENTS,
+    GAME_LOGIC_PHASE_SCENARIO_UPDATE,
+    GAME_LOGIC_PHASE_CLIMATE_UPDATE,
+    GAME_LOGIC_PHASE_MAP_UPDATE_TILES,
+    GAME_LOGIC_PHASE_MAP_PROVISIONAL_ELEMENTS,
+    GAME_LOGIC_PHASE_MAP_UPDATE_PATH_WIDE_FLAGS,
+    GAME_LOGIC_PHASE_PEEP_UPDATE_ALL,
+    GAME_LOGIC_PHASE_VEHICLE_UPDATE_ALL,
+    GAME_LOGIC_PHASE_SPRITE_MISC_UPDATE_ALL,
+    GAME_LOGIC_PHASE_RIDE_UPDATE_ALL,
+    GAME_LOGIC_PHASE_PARK_UPDATE,
+    GAME_LOGIC_PHASE_RESEARCH_UPDATE,
+    GAME_LOGIC_PHASE_RIDE_RATINGS_UPDATE_ALL,
+    GAME_LOGIC_PHASE_RIDE_MEASUREMENTS_UPDATE,
+    GAME_LOGIC_PHASE_NEWS_ITEM_UPDATE_CURRENT,
+    GAME_LOGIC_PHASE_MAP_ANIMATION_INVALIDATE_ALL,
+    GAME_LOGIC_PHASE_SOUNDS_UPDATE,
+    GAME_LOGIC_PHASE_EDITOR_UPDATE,
+    GAME_LOGIC_PHASE_NETWORK_PROCESS_GAME_COMMANDS,
+    GAME_LOGIC_PHASE_NETWORK_FLUSH,
+    GAME_LOGIC_PHASE_COUNT
+};
+
 using GAME_COMMAND_POINTER          = void(sint32 * eax, sint32 * ebx, sint32 * ecx, sint32 * edx, sint32 * esi, sint32 * edi, sint32 * ebp);
 using GAME_COMMAND_CALLBACK_POINTER = void(sint32 eax, sint32 ebx, sint32 ecx, sint32 edx, sint32 esi, sint32 edi, sint32 ebp);
 
@@ -155,12 +185,18 @@ extern bool gLoadKeepWindowsOpen;
 extern uint8 gUnk13CA740;
 extern uint8 gUnk141F568;
 
+// Accumulated nanoseconds spent in each game logic phase, only gathered while gGameLogicPhaseTimingEnabled is set
+extern bool   gGameLogicPhaseTimingEnabled;
+extern uint64 gGameLogicPhaseTimings[GAME_LOGIC_PHASE_COUNT];
+
 void game_increase_game_speed();
 void game_reduce_game_speed();
 
 void game_create_windows();
 void game_update();
 void game_logic_update();
+const char * game_logic_phase_get_name(sint32 phase);
+void game_logic_phase_timings_reset();
 void reset_all_sprite_quadrant_placements();
 void update_palette_effects();
 
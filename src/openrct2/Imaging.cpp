@@ -17,6 +17,7 @@
 #pragma warning(disable : 4611) // interaction between '_setjmp' and C++ object destruction is non-portable
 
 #include <algorithm>
+#include <vector>
 #include <png.h>
 #include "core/FileStream.hpp"
 #include "core/Guard.hpp"
@@ -142,6 +143,92 @@ namespace Imaging
         }
     }
 
+    bool PngReadRows(const utf8 * path, const PngHeaderCallback &onHeader, const PngRowCallback &onRow)
+    {
+        png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        if (png_ptr == nullptr)
+        {
+            return false;
+        }
+
+        png_infop info_ptr = png_create_info_struct(png_ptr);
+        if (info_ptr == nullptr)
+        {
+            png_destroy_read_struct(&png_ptr, nullptr, nullptr);
+            return false;
+        }
+
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+            std::vector<uint8> pixels;
+            std::vector<png_bytep> rowPointers;
+
+            // Set error handling
+            if (setjmp(png_jmpbuf(png_ptr)))
+            {
+                png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+                return false;
+            }
+
+            png_set_read_fn(png_ptr, &fs, PngReadData);
+            png_read_info(png_ptr, info_ptr);
+
+            png_uint_32 pngWidth, pngHeight;
+            int bitDepth, colourType, interlaceType;
+            png_get_IHDR(png_ptr, info_ptr, &pngWidth, &pngHeight, &bitDepth, &colourType, &interlaceType, nullptr, nullptr);
+            if (!onHeader(pngWidth, pngHeight))
+            {
+                png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+                return false;
+            }
+
+            // Convert every colour type and bit depth to 8-bit RGB
+            png_set_strip_16(png_ptr);
+            png_set_packing(png_ptr);
+            png_set_expand(png_ptr);
+            png_set_gray_to_rgb(png_ptr);
+            png_set_strip_alpha(png_ptr);
+            sint32 numPasses = png_set_interlace_handling(png_ptr);
+            png_read_update_info(png_ptr, info_ptr);
+
+            png_size_t rowBytes = png_get_rowbytes(png_ptr, info_ptr);
+            Guard::Assert(rowBytes == pngWidth * 3, GUARD_LINE);
+            if (numPasses == 1)
+            {
+                pixels.resize(rowBytes);
+                for (png_uint_32 y = 0; y < pngHeight; y++)
+                {
+                    png_read_row(png_ptr, pixels.data(), nullptr);
+                    onRow(y, pixels.data());
+                }
+            }
+            else
+            {
+                // Rows of an interlaced image are only complete after the last pass, so it has to be read in full
+                pixels.resize(rowBytes * pngHeight);
+                rowPointers.resize(pngHeight);
+                for (png_uint_32 y = 0; y < pngHeight; y++)
+                {
+                    rowPointers[y] = &pixels[y * rowBytes];
+                }
+                png_read_image(png_ptr, rowPointers.data());
+                for (png_uint_32 y = 0; y < pngHeight; y++)
+                {
+                    onRow(y, rowPointers[y]);
+                }
+            }
+
+            png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+            return true;
+        }
+        catch (const std::exception &)
+        {
+            png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+            return false;
+        }
+    }
+
     bool PngWrite(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path)
     {
         bool result = false;
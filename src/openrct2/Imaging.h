@@ -22,9 +22,20 @@
 
 #ifdef __cplusplus
 
+#include <functional>
+
 namespace Imaging
 {
+    using PngHeaderCallback = std::function<bool(uint32 width, uint32 height)>;
+    using PngRowCallback = std::function<void(uint32 y, const uint8 * rgb)>;
+
     bool PngRead(uint8 * * pixels, uint32 * width, uint32 * height, bool expand, const utf8 * path, sint32 * bitDepth);
+
+    /**
+     * Decodes a PNG one row at a time, passing each row to onRow as 24bpp RGB, top row first. Only a single row is
+     * held in memory unless the image is interlaced. Reading stops when onHeader returns false.
+     */
+    bool PngReadRows(const utf8 * path, const PngHeaderCallback &onHeader, const PngRowCallback &onRow);
     bool PngWrite(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path);
     bool PngWrite32bpp(sint32 width, sint32 height, const void * pixels, const utf8 * path);
 }
@@ -0,0 +1,205 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <vector>
+#include "core/File.h"
+#include "core/String.hpp"
+#include "Profiling.h"
+
+// clang-format off
+static constexpr const char * ProfilerFrameSectionNames[PROFILER_SECTION_COUNT - GAME_LOGIC_PHASE_COUNT] =
+{
+    "game_logic_update",
+    "frame_update",
+    "frame_draw",
+    "window_draw",
+    "viewport_paint",
+};
+
+static constexpr const char * ProfilerHighWaterMarkNames[PROFILER_HIGH_WATER_MARK_COUNT] =
+{
+    "paint_entries",
+    "paint_entry_chunks",
+};
+// clang-format on
+
+struct ProfilerSection
+{
+    uint64 Pending;
+    bool   HasPending;
+    uint32 Head;
+    uint32 Count;
+    uint64 Samples[PROFILER_WINDOW_SIZE];
+};
+
+static ProfilerSection _sections[PROFILER_SECTION_COUNT];
+
+// Can be recorded from any thread, e.g. by paint sessions painting viewport columns in parallel
+static std::atomic<uint64> _highWaterMarks[PROFILER_HIGH_WATER_MARK_COUNT];
+
+const char * profiler_section_get_name(sint32 section)
+{
+    if (section < 0 || section >= PROFILER_SECTION_COUNT)
+    {
+        return nullptr;
+    }
+    if (section < GAME_LOGIC_PHASE_COUNT)
+    {
+        return game_logic_phase_get_name(section);
+    }
+    return ProfilerFrameSectionNames[section - GAME_LOGIC_PHASE_COUNT];
+}
+
+void profiler_record(sint32 section, uint64 nanoseconds)
+{
+    ProfilerSection * ps = &_sections[section];
+    ps->Pending += nanoseconds;
+    ps->HasPending = true;
+}
+
+/**
+ * Closes the current frame: every section that was entered during the frame gets one sample containing the total time
+ * spent in it. Sections that did not run (e.g. the simulation while paused) are left untouched.
+ */
+void profiler_end_frame()
+{
+    for (auto &ps : _sections)
+    {
+        if (ps.HasPending)
+        {
+            ps.Samples[ps.Head] = ps.Pending;
+            ps.Head = (ps.Head + 1) % PROFILER_WINDOW_SIZE;
+            ps.Count = std::min<uint32>(ps.Count + 1, PROFILER_WINDOW_SIZE);
+            ps.Pending = 0;
+            ps.HasPending = false;
+        }
+    }
+}
+
+void profiler_reset()
+{
+    std::fill_n(_sections, PROFILER_SECTION_COUNT, ProfilerSection());
+    for (auto &highWaterMark : _highWaterMarks)
+    {
+        highWaterMark = 0;
+    }
+}
+
+static std::vector<uint64> profiler_get_samples(const ProfilerSection * ps)
+{
+    std::vector<uint64> samples;
+    samples.reserve(ps->Count);
+    uint32 first = (ps->Head + PROFILER_WINDOW_SIZE - ps->Count) % PROFILER_WINDOW_SIZE;
+    for (uint32 i = 0; i < ps->Count; i++)
+    {
+        samples.push_back(ps->Samples[(first + i) % PROFILER_WINDOW_SIZE]);
+    }
+    return samples;
+}
+
+profiler_section_stats profiler_get_stats(sint32 section)
+{
+    profiler_section_stats stats = { 0 };
+    auto samples = profiler_get_samples(&_sections[section]);
+    if (samples.empty())
+    {
+        return stats;
+    }
+
+    uint64 total = 0;
+    for (uint64 sample : samples)
+    {
+        total += sample;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    size_t p99Index = (samples.size() * 99 + 99) / 100 - 1;
+    stats.samples = (uint32)samples.size();
+    stats.min = samples.front();
+    stats.avg = total / samples.size();
+    stats.p99 = samples[p99Index];
+    stats.max = samples.back();
+    return stats;
+}
+
+const char * profiler_high_water_mark_get_name(sint32 mark)
+{
+    if (mark < 0 || mark >= PROFILER_HIGH_WATER_MARK_COUNT)
+    {
+        return nullptr;
+    }
+    return ProfilerHighWaterMarkNames[mark];
+}
+
+void profiler_record_high_water_mark(sint32 mark, uint64 value)
+{
+    std::atomic<uint64> &highWaterMark = _highWaterMarks[mark];
+    uint64 current = highWaterMark.load(std::memory_order_relaxed);
+    while (value > current && !highWaterMark.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64 profiler_get_high_water_mark(sint32 mark)
+{
+    return _highWaterMarks[mark].load(std::memory_order_relaxed);
+}
+
+/**
+ * Writes a CSV file with the statistics of each section followed by its samples, oldest first. All times are in
+ * microseconds. The high-water marks follow in a second table.
+ */
+bool profiler_dump(const std::string &path)
+{
+    std::string csv = "section,samples,min,avg,p99,max,values\n";
+    for (sint32 i = 0; i < PROFILER_SECTION_COUNT; i++)
+    {
+        profiler_section_stats stats = profiler_get_stats(i);
+        csv += String::StdFormat("%s,%u,%.3f,%.3f,%.3f,%.3f",
+            profiler_section_get_name(i),
+            stats.samples,
+            stats.min / 1000.0,
+            stats.avg / 1000.0,
+            stats.p99 / 1000.0,
+            stats.max / 1000.0);
+        for (uint64 sample : profiler_get_samples(&_sections[i]))
+        {
+            csv += String::StdFormat(",%.3f", sample / 1000.0);
+        }
+        csv += "\n";
+    }
+
+    csv += "\nhigh_water_mark,value\n";
+    for (sint32 i = 0; i < PROFILER_HIGH_WATER_MARK_COUNT; i++)
+    {
+        csv += String::StdFormat("%s,%llu\n",
+            profiler_high_water_mark_get_name(i),
+            (unsigned long long)profiler_get_high_water_mark(i));
+    }
+
+    try
+    {
+        File::WriteAllBytes(path, csv.data(), csv.size());
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include "common.h"
+#include "Game.h"
+
+/**
+ * Sections timed by the profiler. The first GAME_LOGIC_PHASE_COUNT sections mirror the game logic phases,
+ * the remainder cover a whole frame. Sections can nest, e.g. viewport paint is part of window draw.
+ */
+enum PROFILER_SECTION
+{
+    PROFILER_SECTION_GAME_LOGIC_UPDATE = GAME_LOGIC_PHASE_COUNT,
+    PROFILER_SECTION_FRAME_UPDATE,
+    PROFILER_SECTION_FRAME_DRAW,
+    PROFILER_SECTION_WINDOW_DRAW,
+    PROFILER_SECTION_VIEWPORT_PAINT,
+    PROFILER_SECTION_COUNT
+};
+
+// Number of frames kept for each section
+constexpr sint32 PROFILER_WINDOW_SIZE = 256;
+
+/**
+ * Peak sizes tracked by the profiler, used to size buffers that grow on demand.
+ */
+enum PROFILER_HIGH_WATER_MARK
+{
+    PROFILER_HIGH_WATER_MARK_PAINT_ENTRIES,         // Most paint entries used by a single paint session
+    PROFILER_HIGH_WATER_MARK_PAINT_ENTRY_CHUNKS,    // Paint entry chunks allocated by all paint sessions
+    PROFILER_HIGH_WATER_MARK_COUNT
+};
+
+struct profiler_section_stats
+{
+    uint32 samples;
+    uint64 min;
+    uint64 avg;
+    uint64 p99;
+    uint64 max;
+};
+
+using profiler_clock = std::chrono::high_resolution_clock;
+
+const char * profiler_section_get_name(sint32 section);
+void profiler_record(sint32 section, uint64 nanoseconds);
+void profiler_end_frame();
+void profiler_reset();
+profiler_section_stats profiler_get_stats(sint32 section);
+const char * profiler_high_water_mark_get_name(sint32 mark);
+void profiler_record_high_water_mark(sint32 mark, uint64 value);
+uint64 profiler_get_high_water_mark(sint32 mark);
+bool profiler_dump(const std::string &path);
+
+/**
+ * Adds the time between construction and destruction to the given section of the current frame.
+ */
+class ProfilerScope final
+{
+private:
+    sint32                     _section;
+    profiler_clock::time_point _startTime;
+
+public:
+    explicit ProfilerScope(sint32 section)
+        : _section(section),
+          _startTime(profiler_clock::now())
+    {
+    }
+
+    ~ProfilerScope()
+    {
+        auto elapsed = profiler_clock::now() - _startTime;
+        profiler_record(_section, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+};
@@ -0,0 +1,185 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../core/Memory.hpp"
+#include "../core/String.hpp"
+#include "../Game.h"
+#include "../Intro.h"
+#include "../OpenRCT2.h"
+#include "../peep/Peep.h"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+#define SZ_JSON "json"
+#define SZ_CSV  "csv"
+
+using namespace OpenRCT2;
+
+static const char * _format;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition BenchSimOptions[]
+{
+    { CMDLINE_TYPE_STRING, &_format, NAC, "format", "the output format <" SZ_JSON "|" SZ_CSV ">" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchSimCommands[]
+{
+    // Main commands
+    DefineCommand("", "<file> [ticks]", BenchSimOptions, HandleBenchSim),
+    CommandTableEnd
+};
+// clang-format on
+
+/**
+ * Escapes a string for use inside a JSON string literal, e.g. a Windows path with backslashes.
+ */
+static std::string EscapeJsonString(const char * s)
+{
+    std::string result;
+    for (; *s != '\0'; s++)
+    {
+        char c = *s;
+        if (c == '\\' || c == '"')
+        {
+            result += '\\';
+            result += c;
+        }
+        else if ((uint8)c < 0x20)
+        {
+            result += String::StdFormat("\\u%04x", (uint8)c);
+        }
+        else
+        {
+            result += c;
+        }
+    }
+    return result;
+}
+
+static void PrintBenchSimJson(const char * inputPath, uint32 ticks, double totalSeconds)
+{
+    Console::WriteLine("{");
+    Console::WriteLine("    \"file\": \"%s\",", EscapeJsonString(inputPath).c_str());
+    Console::WriteLine("    \"ticks\": %u,", ticks);
+    Console::WriteLine("    \"seconds\": %.6f,", totalSeconds);
+    Console::WriteLine("    \"ticks_per_second\": %.2f,", totalSeconds > 0 ? ticks / totalSeconds : 0.0);
+    Console::WriteLine("    \"phases\": {");
+    for (sint32 i = 0; i < GAME_LOGIC_PHASE_COUNT; i++)
+    {
+        Console::WriteLine("        \"%s\": %.6f%s",
+            game_logic_phase_get_name(i),
+            gGameLogicPhaseTimings[i] / 1000000000.0,
+            i == GAME_LOGIC_PHASE_COUNT - 1 ? "" : ",");
+    }
+    Console::WriteLine("    },");
+
+    peep_pathfind_cache_stats cacheStats = peep_pathfind_get_cache_stats();
+    Console::WriteLine("    \"pathfind_cache\": {");
+    Console::WriteLine("        \"hits\": %llu,", (unsigned long long)cacheStats.hits);
+    Console::WriteLine("        \"misses\": %llu", (unsigned long long)cacheStats.misses);
+    Console::WriteLine("    }");
+    Console::WriteLine("}");
+}
+
+static void PrintBenchSimCsv(uint32 ticks, double totalSeconds)
+{
+    Console::WriteLine("phase,seconds,microseconds_per_tick");
+    for (sint32 i = 0; i < GAME_LOGIC_PHASE_COUNT; i++)
+    {
+        double seconds = gGameLogicPhaseTimings[i] / 1000000000.0;
+        Console::WriteLine("%s,%.6f,%.3f", game_logic_phase_get_name(i), seconds, (seconds * 1000000.0) / ticks);
+    }
+    Console::WriteLine("total,%.6f,%.3f", totalSeconds, (totalSeconds * 1000000.0) / ticks);
+}
+
+static exitcode_t HandleBenchSim(CommandLineArgEnumerator *argEnumerator)
+{
+    bool csv = String::Equals(_format, SZ_CSV, true);
+    if (_format != nullptr && !csv && !String::Equals(_format, SZ_JSON, true))
+    {
+        Console::Error::WriteLine("Unknown output format: %s", _format);
+        Memory::Free(_format);
+        return EXITCODE_FAIL;
+    }
+    Memory::Free(_format);
+
+    const utf8 * inputPath;
+    if (!argEnumerator->TryPopString(&inputPath) || inputPath[0] == '-')
+    {
+        Console::Error::WriteLine("Expected a park file.");
+        return EXITCODE_FAIL;
+    }
+
+    uint32 ticks = 1000;
+    const utf8 * ticksArg;
+    if (argEnumerator->TryPopString(&ticksArg) && ticksArg[0] != '-')
+    {
+        sint32 value = atoi(ticksArg);
+        if (value <= 0)
+        {
+            Console::Error::WriteLine("Expected a positive tick count.");
+            return EXITCODE_FAIL;
+        }
+        ticks = (uint32)value;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise() || !context->LoadParkFromFile(inputPath))
+    {
+        return EXITCODE_FAIL;
+    }
+
+    gIntroState = INTRO_STATE_NONE;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    game_logic_phase_timings_reset();
+    peep_pathfind_reset_cache_stats();
+    gGameLogicPhaseTimingEnabled = true;
+    gInUpdateCode = true;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (uint32 i = 0; i < ticks; i++)
+    {
+        game_logic_update();
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    gInUpdateCode = false;
+    gGameLogicPhaseTimingEnabled = false;
+
+    std::chrono::duration<double> duration = endTime - startTime;
+    if (csv)
+    {
+        PrintBenchSimCsv(ticks, duration.count());
+    }
+    else
+    {
+        PrintBenchSimJson(inputPath, ticks, duration.count());
+    }
+    return EXITCODE_OK;
+}
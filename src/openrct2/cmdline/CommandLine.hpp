@@ -100,6 +100,8 @@ namespace CommandLine
     extern const CommandLineCommand ScreenshotCommands[];
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
+    extern const CommandLineCommand BenchSimCommands[];
+    extern const CommandLineCommand MapGenCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -0,0 +1,208 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../core/Math.hpp"
+#include "../core/Memory.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../Imaging.h"
+#include "../OpenRCT2.h"
+#include "../platform/platform.h"
+#include "../util/Util.h"
+#include "../world/Map.h"
+#include "../world/MapGen.h"
+#include "CommandLine.hpp"
+
+#define SZ_JSON "json"
+#define SZ_CSV  "csv"
+
+using namespace OpenRCT2;
+
+static sint32       _size  = 150;
+static uint32       _seed  = 0;
+static sint32       _count = 1;
+static const char * _format;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition MapGenOptions[]
+{
+    { CMDLINE_TYPE_INTEGER, &_size,   NAC, "size",   "the map size in tiles, including the edge (default 150)"        },
+    { CMDLINE_TYPE_INTEGER, &_seed,   NAC, "seed",   "the seed of the first map, the following maps count up from it" },
+    { CMDLINE_TYPE_INTEGER, &_count,  NAC, "count",  "the number of maps to generate (default 1)"                     },
+    { CMDLINE_TYPE_STRING,  &_format, NAC, "format", "the output format <" SZ_JSON "|" SZ_CSV ">"                      },
+    OptionTableEnd
+};
+
+static exitcode_t HandleMapGen(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::MapGenCommands[]
+{
+    // Main commands
+    DefineCommand("", "[<output.png>]", MapGenOptions, HandleMapGen),
+    CommandTableEnd
+};
+// clang-format on
+
+/**
+ * Writes the land height of each tile inside the map edge as a grey scale image, in the layout read by
+ * mapgen_load_heightmap.
+ */
+static bool WriteHeightMap(const utf8 * path)
+{
+    sint32 size = gMapSize - 2;
+    std::vector<uint8> pixels(size * size * 4);
+    for (sint32 y = 0; y < size; y++)
+    {
+        for (sint32 x = 0; x < size; x++)
+        {
+            // The x and y axis are flipped in the height map
+            const rct_tile_element * surfaceElement = map_get_surface_element_at(y + 1, x + 1);
+            uint8 value = (uint8)Math::Min(surfaceElement->base_height * 4, 255);
+            uint8 * pixel = &pixels[(x + y * size) * 4];
+            pixel[0] = value;
+            pixel[1] = value;
+            pixel[2] = value;
+            pixel[3] = 255;
+        }
+    }
+    return image_io_png_write_32bpp(size, size, pixels.data(), path);
+}
+
+static std::string GetOutputPath(const utf8 * outputPath, uint32 seed)
+{
+    if (_count == 1)
+    {
+        return outputPath;
+    }
+
+    // Number the maps by their seed so any of them can be generated again on its own
+    std::string directory = Path::GetDirectory(outputPath);
+    std::string name = Path::GetFileNameWithoutExtension(outputPath);
+    std::string extension = Path::GetExtension(outputPath);
+    return Path::Combine(directory, String::StdFormat("%s-%u%s", name.c_str(), seed, extension.c_str()));
+}
+
+static exitcode_t HandleMapGen(CommandLineArgEnumerator *argEnumerator)
+{
+    bool csv = String::Equals(_format, SZ_CSV, true);
+    if (_format != nullptr && !csv && !String::Equals(_format, SZ_JSON, true))
+    {
+        Console::Error::WriteLine("Unknown output format: %s", _format);
+        Memory::Free(_format);
+        return EXITCODE_FAIL;
+    }
+    Memory::Free(_format);
+
+    if (_size < MINIMUM_MAP_SIZE_TECHNICAL || _size > MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        Console::Error::WriteLine("The map size must be between %d and %d.", MINIMUM_MAP_SIZE_TECHNICAL,
+            MAXIMUM_MAP_SIZE_TECHNICAL);
+        return EXITCODE_FAIL;
+    }
+    if (_count <= 0)
+    {
+        Console::Error::WriteLine("Expected a positive map count.");
+        return EXITCODE_FAIL;
+    }
+
+    const utf8 * outputPath = nullptr;
+    if (argEnumerator->TryPopString(&outputPath) && outputPath[0] == '-')
+    {
+        outputPath = nullptr;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        return EXITCODE_FAIL;
+    }
+    map_init(_size);
+
+    uint32 firstSeed = _seed != 0 ? _seed : platform_get_ticks();
+    if (csv)
+    {
+        Console::WriteLine("seed,seconds");
+    }
+    else
+    {
+        Console::WriteLine("{");
+        Console::WriteLine("    \"size\": %d,", _size);
+        Console::WriteLine("    \"maps\": [");
+    }
+
+    double totalSeconds = 0;
+    for (sint32 i = 0; i < _count; i++)
+    {
+        // Pick the noise settings the same way as the map generator window
+        uint32 seed = firstSeed + i;
+        util_srand((sint32)seed);
+
+        mapgen_settings settings;
+        settings.mapSize = _size;
+        settings.height = 14;
+        settings.water_level = 8;
+        settings.floor = -1;
+        settings.wall = -1;
+        settings.trees = 0;
+        settings.seed = seed;
+        settings.simplex_low = util_rand() % 4;
+        settings.simplex_high = 12 + (util_rand() % (32 - 12));
+        settings.simplex_base_freq = 1.75f;
+        settings.simplex_octaves = 6;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        mapgen_generate(&settings);
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> duration = endTime - startTime;
+        totalSeconds += duration.count();
+        if (csv)
+        {
+            Console::WriteLine("%u,%.6f", seed, duration.count());
+        }
+        else
+        {
+            Console::WriteLine("        { \"seed\": %u, \"seconds\": %.6f }%s", seed, duration.count(),
+                i == _count - 1 ? "" : ",");
+        }
+
+        if (outputPath != nullptr)
+        {
+            std::string path = GetOutputPath(outputPath, seed);
+            if (!WriteHeightMap(path.c_str()))
+            {
+                Console::Error::WriteLine("Unable to write %s", path.c_str());
+                return EXITCODE_FAIL;
+            }
+        }
+    }
+
+    if (!csv)
+    {
+        Console::WriteLine("    ],");
+        Console::WriteLine("    \"seconds\": %.6f", totalSeconds);
+        Console::WriteLine("}");
+    }
+    return EXITCODE_OK;
+}
@@ -141,6 +141,8 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("screenshot", CommandLine::ScreenshotCommands),
     DefineSubCommand("sprite",     CommandLine::SpriteCommands    ),
     DefineSubCommand("benchgfx",   CommandLine::BenchGfxCommands  ),
+    DefineSubCommand("bench-sim",  CommandLine::BenchSimCommands  ),
+    DefineSubCommand("mapgen",     CommandLine::MapGenCommands    ),
 
     CommandTableEnd
 };
@@ -37,6 +37,8 @@ struct GeneralConfiguration
     bool        uncap_fps;
     bool        use_vsync;
     bool        show_fps;
+    bool        multithreading;
+    bool        paint_cache;
     bool        minimize_fullscreen_focus_loss;
 
     // Map rendering
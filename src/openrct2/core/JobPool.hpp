@@ -0,0 +1,155 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../common.h"
+
+/**
+ * A fixed set of worker threads that run queued tasks. Tasks must only touch memory that no other task or the
+ * calling thread writes to until Join returns.
+ */
+class JobPool final
+{
+private:
+    std::vector<std::thread>           _threads;
+    std::deque<std::function<void()>>  _pending;
+    size_t                             _processing = 0;
+    bool                               _shouldStop = false;
+    std::mutex                         _mutex;
+    std::condition_variable            _condPending;
+    std::condition_variable            _condComplete;
+
+    using unique_lock = std::unique_lock<std::mutex>;
+
+public:
+    /**
+     * Creates a pool with one worker per hardware thread, capped at maxThreads.
+     * A pool with no workers runs every task on the calling thread during Join.
+     */
+    explicit JobPool(size_t maxThreads = 16)
+    {
+        size_t numThreads = std::min<size_t>(std::thread::hardware_concurrency(), maxThreads);
+        if (numThreads > 1)
+        {
+            for (size_t i = 0; i < numThreads; i++)
+            {
+                _threads.emplace_back(&JobPool::ProcessQueue, this);
+            }
+        }
+    }
+
+    ~JobPool()
+    {
+        {
+            unique_lock lock(_mutex);
+            _shouldStop = true;
+        }
+        _condPending.notify_all();
+        for (auto &thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    JobPool(const JobPool &) = delete;
+    JobPool & operator=(const JobPool &) = delete;
+
+    /**
+     * Returns the pool shared by the game logic, map generator and viewport painting, created on first use.
+     */
+    static JobPool * GetShared()
+    {
+        static JobPool jobPool;
+        return &jobPool;
+    }
+
+    size_t GetThreadCount() const
+    {
+        return std::max<size_t>(_threads.size(), 1);
+    }
+
+    void AddTask(std::function<void()> task)
+    {
+        {
+            unique_lock lock(_mutex);
+            _pending.push_back(std::move(task));
+        }
+        _condPending.notify_one();
+    }
+
+    /**
+     * Blocks until every queued task has finished.
+     */
+    void Join()
+    {
+        if (_threads.empty())
+        {
+            while (!_pending.empty())
+            {
+                auto task = std::move(_pending.front());
+                _pending.pop_front();
+                task();
+            }
+            return;
+        }
+
+        unique_lock lock(_mutex);
+        _condComplete.wait(lock, [this]() -> bool
+        {
+            return _pending.empty() && _processing == 0;
+        });
+    }
+
+private:
+    void ProcessQueue()
+    {
+        unique_lock lock(_mutex);
+        while (true)
+        {
+            _condPending.wait(lock, [this]() -> bool
+            {
+                return _shouldStop || !_pending.empty();
+            });
+            if (_pending.empty())
+            {
+                // Only reachable when stopping
+                break;
+            }
+
+            auto task = std::move(_pending.front());
+            _pending.pop_front();
+            _processing++;
+
+            lock.unlock();
+            task();
+            lock.lock();
+
+            _processing--;
+            if (_pending.empty() && _processing == 0)
+            {
+                _condComplete.notify_all();
+            }
+        }
+    }
+};
@@ -47,6 +47,69 @@ void mask_avx2(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, cons
     }
 }
 
+/**
+ * Loads the 32 pixels at src, src + (1 << zoomLevel), ... for zoom levels 0 and 1. Reads (32 << zoomLevel) bytes from
+ * src.
+ */
+static inline __m256i sprite_row_load_avx2(const uint8 * RESTRICT src, sint32 zoomLevel)
+{
+    const __m256i * srcVector = (const __m256i *)src;
+    if (zoomLevel == 0)
+    {
+        return _mm256_loadu_si256(srcVector);
+    }
+    const __m256i mask = _mm256_set1_epi16(0xFF);
+    const __m256i a = _mm256_and_si256(_mm256_loadu_si256(srcVector + 0), mask);
+    const __m256i b = _mm256_and_si256(_mm256_loadu_si256(srcVector + 1), mask);
+    // Packing works on each 128 bit lane, which leaves the quarters in the order a0 b0 a1 b1
+    const __m256i packed = _mm256_packus_epi16(a, b);
+    return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+/**
+ * Returns how many pixels from the start of the row can be processed 32 at a time, see sprite_row_vector_end in
+ * SSE41Drawing.cpp. Zoomed out further than that a vector takes 128 or 256 source pixels, more than an RLE run can hold
+ * (127), so those zoom levels are left to the SSE4.1 functions.
+ */
+static inline sint32 sprite_row_vector_end_avx2(sint32 count, sint32 zoomLevel)
+{
+    return zoomLevel == 0 ? count : count - 1;
+}
+
+void sprite_row_copy_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    sint32 i = 0;
+    if (zoomLevel <= 1)
+    {
+        const sint32 vectorEnd = sprite_row_vector_end_avx2(count, zoomLevel);
+        for (; i + 32 <= vectorEnd; i += 32)
+        {
+            const __m256i pixels = sprite_row_load_avx2(src + (i << zoomLevel), zoomLevel);
+            _mm256_storeu_si256((__m256i *)(dst + i), pixels);
+        }
+    }
+    sprite_row_copy_sse4_1(src + (i << zoomLevel), dst + i, count - i, zoomLevel);
+}
+
+void sprite_row_copy_skip_zero_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    sint32 i = 0;
+    if (zoomLevel <= 1)
+    {
+        const __m256i zero = {};
+        const sint32 vectorEnd = sprite_row_vector_end_avx2(count, zoomLevel);
+        for (; i + 32 <= vectorEnd; i += 32)
+        {
+            const __m256i pixels  = sprite_row_load_avx2(src + (i << zoomLevel), zoomLevel);
+            const __m256i dest    = _mm256_loadu_si256((const __m256i *)(dst + i));
+            const __m256i isZero  = _mm256_cmpeq_epi8(pixels, zero);
+            const __m256i blended = _mm256_blendv_epi8(pixels, dest, isZero);
+            _mm256_storeu_si256((__m256i *)(dst + i), blended);
+        }
+    }
+    sprite_row_copy_skip_zero_sse4_1(src + (i << zoomLevel), dst + i, count - i, zoomLevel);
+}
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -59,4 +122,14 @@ void mask_avx2(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, cons
     openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void sprite_row_copy_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+void sprite_row_copy_skip_zero_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
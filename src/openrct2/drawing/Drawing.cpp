@@ -21,6 +21,7 @@
 #include "../localisation/Localisation.h"
 #include "../object/Object.h"
 #include "../OpenRCT2.h"
+#include "../paint/PaintCache.h"
 #include "../platform/platform.h"
 #include "../util/Util.h"
 #include "../world/Water.h"
@@ -46,7 +47,7 @@ sint32 gPickupPeepY;
  * rct2: 0x0009ABE0C
  */
 // clang-format off
-uint8 gPeepPalette[256] = {
+thread_local uint8 gPeepPalette[256] = {
     0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
     0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -66,7 +67,7 @@ uint8 gPeepPalette[256] = {
 };
 
 /** rct2: 0x009ABF0C */
-uint8 gOtherPalette[256] = {
+thread_local uint8 gOtherPalette[256] = {
     0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
     0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -495,6 +496,32 @@ void mask_init()
     }
 }
 
+void (*sprite_row_copy_fn)(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel) = nullptr;
+void (*sprite_row_copy_skip_zero_fn)(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count,
+                                     sint32 zoomLevel) = nullptr;
+
+void sprite_row_copy_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 sprite row copy functions");
+        sprite_row_copy_fn = sprite_row_copy_avx2;
+        sprite_row_copy_skip_zero_fn = sprite_row_copy_skip_zero_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 sprite row copy functions");
+        sprite_row_copy_fn = sprite_row_copy_sse4_1;
+        sprite_row_copy_skip_zero_fn = sprite_row_copy_skip_zero_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar sprite row copy functions");
+        sprite_row_copy_fn = sprite_row_copy_scalar;
+        sprite_row_copy_skip_zero_fn = sprite_row_copy_skip_zero_scalar;
+    }
+}
+
 void gfx_draw_pixel(rct_drawpixelinfo *dpi, sint32 x, sint32 y, sint32 colour)
 {
     gfx_fill_rect(dpi, x, y, x, y, colour);
@@ -577,6 +604,8 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    // Whatever changed may show anywhere, e.g. an option or a cheat
+    paint_cache_invalidate_all();
     gfx_set_dirty_blocks(0, 0, context_get_width(), context_get_height());
 }
 
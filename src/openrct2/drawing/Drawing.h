@@ -236,8 +236,9 @@ extern uint8 gGamePalette[256 * 4];
 extern uint32 gPaletteEffectFrame;
 extern const FILTER_PALETTE_ID GlassPaletteIds[COLOUR_COUNT];
 extern const uint16 palette_to_g1_offset[];
-extern uint8 gPeepPalette[256];
-extern uint8 gOtherPalette[256];
+// Remapped while drawing a sprite, so each thread drawing viewport columns has its own copy
+extern thread_local uint8 gPeepPalette[256];
+extern thread_local uint8 gOtherPalette[256];
 extern uint8 text_palette[];
 extern const translucent_window_palette TranslucentWindowPalettes[COLOUR_COUNT];
 
@@ -352,6 +353,20 @@ void mask_init();
 extern void (*mask_fn)(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, const uint8 * RESTRICT colourSrc,
                        uint8 * RESTRICT dst, sint32 maskWrap, sint32 colourWrap, sint32 dstWrap);
 
+// Copy count pixels to dst, taking every (1 << zoomLevel)th pixel of src. The skip_zero variants leave dst untouched
+// where the source pixel is 0.
+void sprite_row_copy_scalar(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+void sprite_row_copy_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+void sprite_row_copy_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+void sprite_row_copy_skip_zero_scalar(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+void sprite_row_copy_skip_zero_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+void sprite_row_copy_skip_zero_avx2(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+void sprite_row_copy_init();
+
+extern void (*sprite_row_copy_fn)(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel);
+extern void (*sprite_row_copy_skip_zero_fn)(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count,
+                                            sint32 zoomLevel);
+
 #include "NewDrawing.h"
 
 #endif
@@ -137,10 +137,11 @@ static void FASTCALL DrawRLESprite2(const uint8* RESTRICT source_bits_pointer,
                     if (numPixels > 0)
                         memcpy(copyDest, copySrc, numPixels);
                 }
-                else
+                else if (numPixels > 0)
                 {
-                    for (int j = 0; j < numPixels; j += zoom_amount, copySrc += zoom_amount, copyDest++)
-                        *copyDest = *copySrc;
+                    // Every zoom_amount-th pixel, rounding up like stepping j by zoom_amount would
+                    sint32 count = (numPixels + zoom_amount - 1) >> zoom_level;
+                    sprite_row_copy_fn(copySrc, copyDest, count, zoom_level);
                 }
             }
         }
@@ -188,6 +188,16 @@ bool drawing_engine_has_dirty_optimisations()
     return result;
 }
 
+bool drawing_engine_has_parallel_drawing()
+{
+    bool result = false;
+    if (_drawingEngine != nullptr)
+    {
+        result = (_drawingEngine->GetFlags() & DEF_PARALLEL_DRAWING);
+    }
+    return result;
+}
+
 void drawing_engine_invalidate_image(uint32 image)
 {
     if (_drawingEngine != nullptr)
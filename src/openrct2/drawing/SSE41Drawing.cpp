@@ -62,6 +62,92 @@ void mask_sse4_1(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     }
 }
 
+/**
+ * Loads the 16 pixels at src, src + (1 << zoomLevel), ... by masking out the skipped pixels and packing the rest. Reads
+ * (16 << zoomLevel) bytes from src.
+ */
+static inline __m128i sprite_row_load_sse4_1(const uint8 * RESTRICT src, sint32 zoomLevel)
+{
+    const __m128i * srcVector = (const __m128i *)src;
+    switch (zoomLevel)
+    {
+    case 0:
+        return _mm_loadu_si128(srcVector);
+    case 1:
+    {
+        const __m128i mask = _mm_set1_epi16(0xFF);
+        const __m128i a = _mm_and_si128(_mm_loadu_si128(srcVector + 0), mask);
+        const __m128i b = _mm_and_si128(_mm_loadu_si128(srcVector + 1), mask);
+        return _mm_packus_epi16(a, b);
+    }
+    case 2:
+    {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        __m128i words[2];
+        for (sint32 i = 0; i < 2; i++)
+        {
+            const __m128i a = _mm_and_si128(_mm_loadu_si128(srcVector + i * 2 + 0), mask);
+            const __m128i b = _mm_and_si128(_mm_loadu_si128(srcVector + i * 2 + 1), mask);
+            // _mm_packus_epi32 is SSE4.1
+            words[i] = _mm_packus_epi32(a, b);
+        }
+        return _mm_packus_epi16(words[0], words[1]);
+    }
+    default:
+    {
+        const __m128i mask = _mm_set1_epi64x(0xFF);
+        __m128i dwords[4];
+        for (sint32 i = 0; i < 4; i++)
+        {
+            const __m128i a = _mm_and_si128(_mm_loadu_si128(srcVector + i * 2 + 0), mask);
+            const __m128i b = _mm_and_si128(_mm_loadu_si128(srcVector + i * 2 + 1), mask);
+            dwords[i] = _mm_packus_epi32(a, b);
+        }
+        const __m128i words1 = _mm_packus_epi32(dwords[0], dwords[1]);
+        const __m128i words2 = _mm_packus_epi32(dwords[2], dwords[3]);
+        return _mm_packus_epi16(words1, words2);
+    }
+    }
+}
+
+/**
+ * Returns how many pixels from the start of the row can be processed 16 at a time. When zoomed out the last vector
+ * would read past the last pixel that is sampled, which may be the end of the image data, so it is left to the scalar
+ * tail.
+ */
+static inline sint32 sprite_row_vector_end(sint32 count, sint32 zoomLevel)
+{
+    return zoomLevel == 0 ? count : count - 1;
+}
+
+void sprite_row_copy_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    const sint32 vectorEnd = sprite_row_vector_end(count, zoomLevel);
+    sint32 i = 0;
+    for (; i + 16 <= vectorEnd; i += 16)
+    {
+        const __m128i pixels = sprite_row_load_sse4_1(src + (i << zoomLevel), zoomLevel);
+        _mm_storeu_si128((__m128i *)(dst + i), pixels);
+    }
+    sprite_row_copy_scalar(src + (i << zoomLevel), dst + i, count - i, zoomLevel);
+}
+
+void sprite_row_copy_skip_zero_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    const __m128i zero128 = {};
+    const sint32 vectorEnd = sprite_row_vector_end(count, zoomLevel);
+    sint32 i = 0;
+    for (; i + 16 <= vectorEnd; i += 16)
+    {
+        const __m128i pixels   = sprite_row_load_sse4_1(src + (i << zoomLevel), zoomLevel);
+        const __m128i dest     = _mm_loadu_si128((const __m128i *)(dst + i));
+        const __m128i isZero   = _mm_cmpeq_epi8(pixels, zero128);
+        const __m128i blended  = _mm_blendv_epi8(pixels, dest, isZero);
+        _mm_storeu_si128((__m128i *)(dst + i), blended);
+    }
+    sprite_row_copy_skip_zero_scalar(src + (i << zoomLevel), dst + i, count - i, zoomLevel);
+}
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -74,4 +160,14 @@ void mask_sse4_1(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void sprite_row_copy_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void sprite_row_copy_skip_zero_sse4_1(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
@@ -191,6 +191,26 @@ void mask_scalar(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     }
 }
 
+void sprite_row_copy_scalar(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    for (sint32 i = 0; i < count; i++)
+    {
+        dst[i] = src[i << zoomLevel];
+    }
+}
+
+void sprite_row_copy_skip_zero_scalar(const uint8 * RESTRICT src, uint8 * RESTRICT dst, sint32 count, sint32 zoomLevel)
+{
+    for (sint32 i = 0; i < count; i++)
+    {
+        uint8 pixel = src[i << zoomLevel];
+        if (pixel != 0)
+        {
+            dst[i] = pixel;
+        }
+    }
+}
+
 static std::string gfx_get_csg_header_path()
 {
     auto path = Path::ResolveCasing(Path::Combine(gConfigGeneral.rct1_path, "Data", "csg1i.dat"));
@@ -452,35 +472,27 @@ void FASTCALL gfx_bmp_sprite_to_buffer(const uint8* palette_pointer, uint8* unkn
         return;
     }
 
+    if (width <= 0){
+        return;
+    }
+    // Each row takes every zoom_amount-th pixel, rounding up like stepping no_pixels by zoom_amount would
+    sint32 row_pixels = (width + zoom_amount - 1) >> zoom_level;
+
     // Basic bitmap no fancy stuff
     if (!(source_image->flags & G1_FLAG_BMP)){ // Not tested
         for (; height > 0; height -= zoom_amount){
-            uint8* next_source_pointer = source_pointer + source_line_width;
-            uint8* next_dest_pointer = dest_pointer + dest_line_width;
-
-            for (sint32 no_pixels = width; no_pixels > 0; no_pixels -= zoom_amount, dest_pointer++, source_pointer += zoom_amount){
-                *dest_pointer = *source_pointer;
-            }
-
-            dest_pointer = next_dest_pointer;
-            source_pointer = next_source_pointer;
+            sprite_row_copy_fn(source_pointer, dest_pointer, row_pixels, zoom_level);
+            dest_pointer += dest_line_width;
+            source_pointer += source_line_width;
         }
         return;
     }
 
     // Basic bitmap with no draw pixels
     for (; height > 0; height -= zoom_amount){
-        uint8* next_source_pointer = source_pointer + source_line_width;
-        uint8* next_dest_pointer = dest_pointer + dest_line_width;
-
-        for (sint32 no_pixels = width; no_pixels > 0; no_pixels -= zoom_amount, dest_pointer++, source_pointer += zoom_amount){
-            uint8 pixel = *source_pointer;
-            if (pixel){
-                *dest_pointer = pixel;
-            }
-        }
-        dest_pointer = next_dest_pointer;
-        source_pointer = next_source_pointer;
+        sprite_row_copy_skip_zero_fn(source_pointer, dest_pointer, row_pixels, zoom_level);
+        dest_pointer += dest_line_width;
+        source_pointer += source_line_width;
     }
 }
 
@@ -136,7 +136,6 @@ void X8RainDrawer::Restore()
 
 X8DrawingEngine::X8DrawingEngine(Ui::IUiContext * uiContext)
 {
-    _drawingContext = new X8DrawingContext(this);
 #ifdef __ENABLE_LIGHTFX__
     lightfx_set_available(true);
     _lastLightFXenabled = (gConfigGeneral.enable_light_fx != 0);
@@ -145,7 +144,6 @@ X8DrawingEngine::X8DrawingEngine(Ui::IUiContext * uiContext)
 
 X8DrawingEngine::~X8DrawingEngine()
 {
-    delete _drawingContext;
     delete [] _dirtyGrid.Blocks;
     delete [] _bits;
 }
@@ -284,8 +282,11 @@ sint32 X8DrawingEngine::Screenshot()
 
 IDrawingContext * X8DrawingEngine::GetDrawingContext(rct_drawpixelinfo * dpi)
 {
-    _drawingContext->SetDPI(dpi);
-    return _drawingContext;
+    // A context only holds its target, so each thread gets its own to be able to draw viewport columns in parallel
+    thread_local X8DrawingContext drawingContext(nullptr);
+    drawingContext.SetEngine(this);
+    drawingContext.SetDPI(dpi);
+    return &drawingContext;
 }
 
 rct_drawpixelinfo * X8DrawingEngine::GetDrawingPixelInfo()
@@ -295,7 +296,7 @@ rct_drawpixelinfo * X8DrawingEngine::GetDrawingPixelInfo()
 
 DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
 {
-    return DEF_DIRTY_OPTIMISATIONS;
+    return (DRAWING_ENGINE_FLAGS)(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING);
 }
 
 void X8DrawingEngine::InvalidateImage(uint32 image)
@@ -754,6 +755,11 @@ void X8DrawingContext::DrawGlyph(uint32 image, sint32 x, sint32 y, uint8 * palet
     gfx_draw_sprite_palette_set_software(_dpi, image, x, y, palette, nullptr);
 }
 
+void X8DrawingContext::SetEngine(X8DrawingEngine * engine)
+{
+    _engine = engine;
+}
+
 void X8DrawingContext::SetDPI(rct_drawpixelinfo * dpi)
 {
     _dpi = dpi;
@@ -45,6 +45,7 @@
 #include "../OpenRCT2.h"
 #include "../peep/Staff.h"
 #include "../platform/platform.h"
+#include "../Profiling.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../util/SawyerCoding.h"
@@ -1267,8 +1268,7 @@ static sint32 cc_remove_park_fences(const utf8 **argv, sint32 argc)
 
 static sint32 cc_show_limits(const utf8 ** argv, sint32 argc)
 {
-    map_reorganise_elements();
-    sint32 tileElementCount = gNextFreeTileElement - gTileElements - 1;
+    tile_element_stats tileElementStats = map_get_tile_element_stats();
 
     sint32 rideCount = 0;
     for (sint32 i = 0; i < MAX_RIDES; ++i) 
@@ -1304,14 +1304,84 @@ static sint32 cc_show_limits(const utf8 ** argv, sint32 argc)
         }
     }
 
-    console_printf("Sprites: %d/%d", spriteCount, MAX_SPRITES);
-    console_printf("Map Elements: %d/%d", tileElementCount, MAX_TILE_ELEMENTS);
+    console_printf("Sprites: %d/%d", spriteCount, MAX_SPRITES_LIMIT);
+    console_printf("Map Elements: %d", (sint32)tileElementStats.elements);
+    console_printf("Map Element Storage: %d free slots, %d blocks, %d KiB",
+        (sint32)tileElementStats.free_slots,
+        (sint32)tileElementStats.blocks,
+        (sint32)(tileElementStats.capacity * sizeof(rct_tile_element) / 1024));
+    console_printf("Map Element Compaction: %u tiles moved, %u runs reused, %u reorganisations (last took %u us)",
+        tileElementStats.tiles_compacted,
+        tileElementStats.runs_reused,
+        tileElementStats.reorganisations,
+        (uint32)tileElementStats.last_reorganise_time);
     console_printf("Banners: %d/%d", bannerCount, MAX_BANNERS);
     console_printf("Rides: %d/%d", rideCount, MAX_RIDES);
     console_printf("Staff: %d/%d", staffCount, STAFF_MAX_COUNT);
     return 0;
 }
 
+static sint32 cc_profile(const utf8 ** argv, sint32 argc)
+{
+    if (argc == 0)
+    {
+        console_printf("Timings over the last %d frames (min / avg / p99 / max in ms):", PROFILER_WINDOW_SIZE);
+        for (sint32 i = 0; i < PROFILER_SECTION_COUNT; i++)
+        {
+            profiler_section_stats stats = profiler_get_stats(i);
+            if (stats.samples == 0)
+            {
+                continue;
+            }
+            console_printf("%s: %.3f / %.3f / %.3f / %.3f",
+                profiler_section_get_name(i),
+                stats.min / 1000000.0,
+                stats.avg / 1000000.0,
+                stats.p99 / 1000000.0,
+                stats.max / 1000000.0);
+        }
+
+        console_printf("High-water marks:");
+        for (sint32 i = 0; i < PROFILER_HIGH_WATER_MARK_COUNT; i++)
+        {
+            console_printf("%s: %llu",
+                profiler_high_water_mark_get_name(i),
+                (unsigned long long)profiler_get_high_water_mark(i));
+        }
+
+        peep_pathfind_cache_stats cacheStats = peep_pathfind_get_cache_stats();
+        uint64 lookups = cacheStats.hits + cacheStats.misses;
+        console_printf("pathfinding cache: %llu hits, %llu misses (%.1f%% hit rate), %u entries",
+            (unsigned long long)cacheStats.hits,
+            (unsigned long long)cacheStats.misses,
+            lookups == 0 ? 0.0 : (cacheStats.hits * 100.0) / lookups,
+            cacheStats.entries);
+    }
+    else if (strcmp(argv[0], "reset") == 0)
+    {
+        profiler_reset();
+        peep_pathfind_reset_cache_stats();
+        console_printf("Profiler timings have been reset.");
+    }
+    else if (strcmp(argv[0], "dump") == 0 && argc > 1)
+    {
+        if (profiler_dump(argv[1]))
+        {
+            console_printf("Profiler timings written to %s", argv[1]);
+        }
+        else
+        {
+            console_writeline_error("Unable to write profiler timings.");
+            return 1;
+        }
+    }
+    else
+    {
+        console_printf("subcommands: reset, dump <file>");
+    }
+    return 0;
+}
+
 static sint32 cc_for_date(const utf8 **argv, sint32 argc)
 {
     sint32 year = 0;
@@ -1446,6 +1516,7 @@ static constexpr const console_command console_command_table[] = {
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences"},
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
+    { "profile", cc_profile, "Shows or dumps the rolling timings of the simulation, drawing and network.", "profile [reset | dump <file>]" },
     { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]."}
 };
 
@@ -17,6 +17,7 @@
 #include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "../audio/audio.h"
 #include "../Context.h"
@@ -29,6 +30,7 @@
 #include "../Game.h"
 #include "../Intro.h"
 #include "../localisation/Localisation.h"
+#include "../paint/Paint.h"
 #include "../platform/platform.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
@@ -265,6 +267,87 @@ void screenshot_giant()
     context_show_error(STR_SCREENSHOT_SAVED_AS, STR_NONE);
 }
 
+/**
+ * Times arranging the paint structs of each column of the view, with the current arrange and with the reference one.
+ * Generating the paint structs is not included.
+ */
+static void benchgfx_time_arrange(const rct_viewport * viewport, uint32 iterationCount)
+{
+    using clock = std::chrono::high_resolution_clock;
+    clock::duration arrangeDuration = clock::duration::zero();
+    clock::duration referenceDuration = clock::duration::zero();
+    for (uint32 i = 0; i < iterationCount; i++)
+    {
+        rct_drawpixelinfo dpi = {};
+        dpi.y = viewport->view_y;
+        dpi.width = 32;
+        dpi.height = viewport->view_height;
+        dpi.zoom_level = i & 3;
+        for (sint32 x = floor2(viewport->view_x, 32); x < viewport->view_x + viewport->view_width; x += 32)
+        {
+            dpi.x = x;
+            for (bool reference : { false, true })
+            {
+                paint_session * session = paint_session_alloc(&dpi);
+                paint_session_generate(session);
+                auto startTime = clock::now();
+                if (reference)
+                {
+                    paint_session_arrange_reference(session);
+                    referenceDuration += clock::now() - startTime;
+                }
+                else
+                {
+                    paint_session_arrange(session);
+                    arrangeDuration += clock::now() - startTime;
+                }
+                paint_session_free(session);
+            }
+        }
+    }
+    std::chrono::duration<float, std::milli> arrangeMilliseconds = arrangeDuration;
+    std::chrono::duration<float, std::milli> referenceMilliseconds = referenceDuration;
+    Console::WriteLine("Arranging the paint structs %d times took %.2f ms, %.2f ms with the reference implementation.",
+        iterationCount, arrangeMilliseconds.count(), referenceMilliseconds.count());
+}
+
+/**
+ * Times the sprite row copies on rows as long as the longest RLE run at each zoom level, with the scalar functions and
+ * with the ones picked for this CPU.
+ */
+static void benchgfx_time_sprite_row_copy(uint32 iterationCount)
+{
+    using clock = std::chrono::high_resolution_clock;
+    constexpr sint32 rowCount = 4096;
+    constexpr sint32 rowLength = 127;
+    std::vector<uint8> src(rowLength);
+    std::vector<uint8> dst(rowLength);
+    for (sint32 i = 0; i < rowLength; i++)
+    {
+        src[i] = (i % 5 == 0) ? 0 : (uint8)i;
+    }
+
+    for (bool scalar : { true, false })
+    {
+        auto copy = scalar ? sprite_row_copy_scalar : sprite_row_copy_fn;
+        auto copySkipZero = scalar ? sprite_row_copy_skip_zero_scalar : sprite_row_copy_skip_zero_fn;
+        auto startTime = clock::now();
+        for (uint32 i = 0; i < iterationCount; i++)
+        {
+            for (sint32 row = 0; row < rowCount; row++)
+            {
+                sint32 zoomLevel = row & 3;
+                sint32 count = (rowLength + (1 << zoomLevel) - 1) >> zoomLevel;
+                copy(src.data(), dst.data(), count, zoomLevel);
+                copySkipZero(src.data(), dst.data(), count, zoomLevel);
+            }
+        }
+        std::chrono::duration<float, std::milli> duration = clock::now() - startTime;
+        Console::WriteLine("Copying %d sprite rows %d times took %.2f ms with the %s functions.",
+            rowCount, iterationCount, duration.count(), scalar ? "scalar" : "selected");
+    }
+}
+
 static void benchgfx_render_screenshots(const char *inputPath, std::unique_ptr<IContext>& context, uint32 iterationCount)
 {
     if (!context->LoadParkFromFile(inputPath))
@@ -332,6 +415,9 @@ static void benchgfx_render_screenshots(const char *inputPath, std::unique_ptr<I
         iterationCount, engine_name,
         duration.count());
 
+    benchgfx_time_arrange(&viewport, iterationCount);
+    benchgfx_time_sprite_row_copy(iterationCount);
+
     free(dpi.bits);
 }
 
@@ -15,10 +15,13 @@
 #pragma endregion
 
 #include <algorithm>
+#include <vector>
 #include "../config/Config.h"
 #include "../Context.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
 #include "../Game.h"
 #include "../Input.h"
 #include "../localisation/Localisation.h"
@@ -26,6 +29,7 @@
 #include "../paint/Paint.h"
 #include "../paint/Supports.h"
 #include "../peep/Staff.h"
+#include "../Profiling.h"
 #include "../ride/RideData.h"
 #include "../ride/TrackData.h"
 #include "../world/Banner.h"
@@ -68,6 +72,7 @@ static sint16 _interactionMapX;
 static sint16 _interactionMapY;
 static uint16 _unk9AC154;
 
+static void viewport_paint_columns(const std::vector<rct_drawpixelinfo> &columns, uint32 viewFlags);
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
@@ -824,6 +829,8 @@ void viewport_render(rct_drawpixelinfo *dpi, rct_viewport *viewport, sint32 left
  */
 void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left, sint16 top, sint16 right, sint16 bottom)
 {
+    ProfilerScope profilerScope(PROFILER_SECTION_VIEWPORT_PAINT);
+
     uint32 viewFlags = viewport->flags;
     uint16 width = right - left;
     uint16 height = bottom - top;
@@ -858,6 +865,7 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
     sint16 rightBorder = dpi1.x + dpi1.width;
 
     // Splits the area into 32 pixel columns and renders them
+    std::vector<rct_drawpixelinfo> columns;
     for (x = floor2(dpi1.x, 32); x < rightBorder; x += 32) {
         rct_drawpixelinfo dpi2 = dpi1;
         if (x >= dpi2.x) {
@@ -876,14 +884,63 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
         }
         dpi2.width = paintRight - dpi2.x;
 
-        viewport_paint_column(&dpi2, viewFlags);
+        columns.push_back(dpi2);
     }
+
+    gCurrentViewportFlags = viewFlags;
+    viewport_paint_columns(columns, viewFlags);
 }
 
-static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+/**
+ * Besides its own paint session and part of the screen, a column only reads shared state or takes gPaintTextMutex.
+ * The exceptions rule out painting in parallel: scrolling text is only set up at full zoom and its cache is shared by
+ * all columns, the map overlay copies tiles as they are read and light effects are collected into a single list.
+ */
+static bool viewport_can_paint_columns_in_parallel(const rct_drawpixelinfo * dpi)
 {
-    gCurrentViewportFlags = viewFlags;
+    if (!gConfigGeneral.multithreading || dpi->zoom_level == 0)
+        return false;
+    if (!drawing_engine_has_parallel_drawing() || map_overlay_is_active())
+        return false;
+#ifdef __ENABLE_LIGHTFX__
+    if (lightfx_is_available())
+        return false;
+#endif
+    return JobPool::GetShared()->GetThreadCount() > 1;
+}
+
+static void viewport_paint_columns(const std::vector<rct_drawpixelinfo> &columns, uint32 viewFlags)
+{
+    if (columns.size() <= 1 || !viewport_can_paint_columns_in_parallel(&columns[0]))
+    {
+        for (auto column : columns)
+        {
+            viewport_paint_column(&column, viewFlags);
+        }
+        return;
+    }
 
+    // Neighbouring columns share cache lines of the screen, so each task paints a run of them
+    JobPool * jobPool = JobPool::GetShared();
+    size_t numBands = std::min(columns.size(), jobPool->GetThreadCount() * 2);
+    for (size_t band = 0; band < numBands; band++)
+    {
+        size_t begin = columns.size() * band / numBands;
+        size_t end = columns.size() * (band + 1) / numBands;
+        jobPool->AddTask([&columns, begin, end, viewFlags]() -> void
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                rct_drawpixelinfo column = columns[i];
+                viewport_paint_column(&column, viewFlags);
+            }
+        });
+    }
+    jobPool->Join();
+}
+
+static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
+{
     if (viewFlags & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE | VIEWPORT_FLAG_PAINT_CLIP_TO_HEIGHT)) {
         uint8 colour = 10;
         if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES) {
@@ -896,7 +953,6 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
     paint_session_generate(session);
     paint_struct ps = paint_session_arrange(session);
     paint_draw_structs(dpi, &ps, viewFlags);
-    paint_session_free(session);
 
     if (gConfigGeneral.render_weather_gloom &&
         !gTrackDesignSaveMode &&
@@ -909,6 +965,7 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
     if (session->PSStringHead != nullptr) {
         paint_draw_money_structs(dpi, session->PSStringHead);
     }
+    paint_session_free(session);
 }
 
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi)
@@ -31,6 +31,7 @@
 #include "../localisation/StringIds.h"
 #include "../OpenRCT2.h"
 #include "../platform/platform.h"
+#include "../Profiling.h"
 #include "../world/Map.h"
 #include "../world/Sprite.h"
 #include "Viewport.h"
@@ -2602,6 +2603,8 @@ bool window_is_visible(rct_window* w)
  */
 void window_draw_all(rct_drawpixelinfo *dpi, sint16 left, sint16 top, sint16 right, sint16 bottom)
 {
+    ProfilerScope profilerScope(PROFILER_SECTION_WINDOW_DRAW);
+
     rct_drawpixelinfo windowDPI;
     windowDPI.bits = dpi->bits + left + ((dpi->width + dpi->pitch) * top);
     windowDPI.x = left;
@@ -2678,7 +2681,7 @@ void window_init_all()
 
 void window_follow_sprite(rct_window * w, size_t spriteIndex)
 {
-    if (spriteIndex < MAX_SPRITES || spriteIndex == SPRITE_INDEX_NULL)
+    if (spriteIndex < sprite_get_capacity() || spriteIndex == SPRITE_INDEX_NULL)
     {
         w->viewport_smart_follow_sprite = (uint16)spriteIndex;
     }
@@ -33,7 +33,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "34"
+#define NETWORK_STREAM_VERSION "42"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static rct_peep* _pickup_peep = nullptr;
@@ -657,9 +657,16 @@ bool Network::CheckSRAND(uint32 tick, uint32 srand0)
         server_srand0_tick = 0;
         // Check that the server and client sprite hashes match
         const char *client_sprite_hash = sprite_checksum();
-        const bool sprites_mismatch = server_sprite_hash[0] != '\0' && strcmp(client_sprite_hash, server_sprite_hash);
+        const uint32 sprites_mismatch = server_sprite_hash[0] != '\0' ? sprite_checksum_compare(client_sprite_hash, server_sprite_hash) : 0;
+        for (sint32 group = 0; group < SPRITE_CHECKSUM_GROUP_COUNT; group++)
+        {
+            if (sprites_mismatch & (1 << group))
+            {
+                log_warning("Sprite checksum mismatch for %s at tick %u", sprite_checksum_get_group_name(group), tick);
+            }
+        }
         // Check PRNG values and sprite hashes, if exist
-        if ((srand0 != server_srand0) || sprites_mismatch) {
+        if ((srand0 != server_srand0) || sprites_mismatch != 0) {
 #ifdef DEBUG_DESYNC
             dbg_report_desync(tick, srand0, server_srand0, client_sprite_hash, server_sprite_hash);
 #endif
@@ -15,12 +15,17 @@
 #pragma endregion
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include "../config/Config.h"
 #include "../core/Math.hpp"
 #include "../drawing/Drawing.h"
 #include "../interface/Viewport.h"
 #include "../localisation/Localisation.h"
+#include "../Profiling.h"
 #include "Paint.h"
+#include "PaintCache.h"
 #include "sprite/Sprite.h"
 #include "tile_element/TileElement.h"
 
@@ -28,7 +33,13 @@
 uint8 gClipHeight = 128; // Default to middle value
 
 paint_session gPaintSession;
-static bool _paintSessionInUse;
+std::mutex gPaintTextMutex;
+
+// Sessions are handed out to each thread painting at the same time, gPaintSession is the first one to be used
+static std::mutex                                  _paintSessionPoolMutex;
+static std::vector<paint_session *>                _freePaintSessions = { &gPaintSession };
+static std::vector<std::unique_ptr<paint_session>> _extraPaintSessions;
+static std::atomic<uint64>                         _paintEntryChunkCount;
 
 static constexpr const uint8 BoundBoxDebugColours[] =
 {
@@ -56,11 +67,41 @@ static void paint_ps_image_with_bounding_boxes(rct_drawpixelinfo * dpi, paint_st
 static void paint_ps_image(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 imageId, sint16 x, sint16 y);
 static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32 viewFlags);
 
+/**
+ * Continues allocating paint entries from the given chunk of the session, allocating the chunk if the session does not
+ * have it yet.
+ */
+static void paint_session_use_chunk(paint_session * session, size_t chunkIndex)
+{
+    if (chunkIndex == session->PaintEntryChunks.size())
+    {
+        session->PaintEntryChunks.push_back(std::make_unique<paint_entry_chunk>());
+        _paintEntryChunkCount++;
+    }
+
+    paint_entry * entries = session->PaintEntryChunks[chunkIndex]->Entries;
+    session->CurrentPaintEntryChunk = chunkIndex;
+    session->NextFreePaintStruct = entries;
+    session->EndOfPaintStructArray = entries + PAINT_ENTRY_CHUNK_SIZE;
+}
+
+/**
+ * Returns the next free paint entry, moving on to the next chunk when the current one is full. The entry is only taken
+ * once NextFreePaintStruct is advanced past it.
+ */
+paint_entry * paint_session_get_next_free_entry(paint_session * session)
+{
+    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    {
+        paint_session_use_chunk(session, session->CurrentPaintEntryChunk + 1);
+    }
+    return session->NextFreePaintStruct;
+}
+
 static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
 {
     session->Unk140E9A8 = dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    paint_session_use_chunk(session, 0);
     session->UnkF1AD28 = nullptr;
     session->UnkF1AD2C = nullptr;
     for (auto &quadrant : session->Quadrants)
@@ -74,9 +115,10 @@ static void paint_session_init(paint_session * session, rct_drawpixelinfo * dpi)
     session->WoodenSupportsPrependTo = nullptr;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
+    session->PaintCacheRecording = nullptr;
 }
 
-static void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
+void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash)
 {
     uint32 paintQuadrantIndex = Math::Clamp(0, positionHash / 32, MAX_PAINT_QUADRANTS - 1);
     ps->quadrant_index = paintQuadrantIndex;
@@ -87,20 +129,62 @@ static void paint_session_add_ps_to_quadrant(paint_session * session, paint_stru
     session->QuadrantFrontIndex = std::max(session->QuadrantFrontIndex, paintQuadrantIndex);
 }
 
+/**
+ * Whether an image with the given screen bounds lies outside the session's area. Nothing is culled while a tile is
+ * recorded for the paint cache, that is done when the tile is replayed.
+ */
+static bool paint_session_is_culled(const paint_session * session, sint32 left, sint32 bottom, sint32 right, sint32 top)
+{
+    if (session->PaintCacheRecording != nullptr)
+    {
+        return false;
+    }
+
+    const rct_drawpixelinfo * dpi = session->Unk140E9A8;
+    return right <= dpi->x || top <= dpi->y || left >= dpi->x + dpi->width || bottom >= dpi->y + dpi->height;
+}
+
+/**
+ * The position of a paint struct that sorts it into a quadrant, as used by sub_98197C.
+ */
+static sint32 paint_get_bound_box_position_hash(const paint_session * session, const paint_struct * ps)
+{
+    LocationXY16 attach =
+    {
+        (sint16)ps->bounds.x,
+        (sint16)ps->bounds.y
+    };
+
+    rotate_map_coordinates(&attach.x, &attach.y, session->CurrentRotation);
+    switch (session->CurrentRotation)
+    {
+    case 0:
+        break;
+    case 1:
+    case 3:
+        attach.x += 0x2000;
+        break;
+    case 2:
+        attach.x += 0x4000;
+        break;
+    }
+
+    return attach.x + attach.y;
+}
+
 /**
 * Extracted from 0x0098196c, 0x0098197c, 0x0098198c, 0x0098199c
 */
 static paint_struct * sub_9819_c(
     paint_session * session, uint32 image_id, LocationXYZ16 offset, LocationXYZ16 boundBoxSize, LocationXYZ16 boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray) return nullptr;
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
     {
         return nullptr;
     }
 
-    paint_struct * ps = &session->NextFreePaintStruct->basic;
+    paint_struct * ps = &paint_session_get_next_free_entry(session)->basic;
     ps->image_id = image_id;
 
     switch (session->CurrentRotation)
@@ -132,12 +216,7 @@ static paint_struct * sub_9819_c(
     sint32 right = left + g1->width;
     sint32 top = bottom + g1->height;
 
-    rct_drawpixelinfo * dpi = session->Unk140E9A8;
-
-    if (right <= dpi->x)return nullptr;
-    if (top <= dpi->y)return nullptr;
-    if (left >= dpi->x + dpi->width)return nullptr;
-    if (bottom >= dpi->y + dpi->height)return nullptr;
+    if (paint_session_is_culled(session, left, bottom, right, top)) return nullptr;
 
 
     // This probably rotates the variables so they're relative to rotation 0.
@@ -346,22 +425,27 @@ template<> bool check_bounding_box<3>(const paint_struct_bound_box& initialBBox,
     return false;
 }
 
-template<uint8 _TRotation>
-static paint_struct * paint_arrange_structs_helper_rotation(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+/**
+ * Walks from ps_next to the node before the first one in quadrantIndex, then flags the nodes after it up to the first
+ * one beyond the next quadrant. Returns false if the list ends first. Either way ps_cache receives the node reached.
+ */
+static bool paint_arrange_structs_mark(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, paint_struct * * ps_cache)
 {
     paint_struct * ps;
-    paint_struct * ps_temp;
     do
     {
         ps = ps_next;
         ps_next = ps_next->next_quadrant_ps;
-        if (ps_next == nullptr) return ps;
+        if (ps_next == nullptr)
+        {
+            *ps_cache = ps;
+            return false;
+        }
     } while (quadrantIndex > ps_next->quadrant_index);
 
     // Cache the last visited node so we don't have to walk the whole list again
-    paint_struct * ps_cache = ps;
+    *ps_cache = ps;
 
-    ps_temp = ps;
     do {
         ps = ps->next_quadrant_ps;
         if (ps == nullptr) break;
@@ -379,8 +463,17 @@ static paint_struct * paint_arrange_structs_helper_rotation(paint_struct * ps_ne
             ps->quadrant_flags = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
         }
     } while (ps->quadrant_index <= quadrantIndex + 1);
-    ps = ps_temp;
+    return true;
+}
 
+template<uint8 _TRotation>
+static paint_struct * paint_arrange_structs_helper_rotation(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+{
+    paint_struct * ps_cache;
+    if (!paint_arrange_structs_mark(ps_next, quadrantIndex, flag, &ps_cache)) return ps_cache;
+
+    paint_struct * ps = ps_cache;
+    paint_struct * ps_temp;
     while (true)
     {
         while (true)
@@ -440,10 +533,115 @@ paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadr
 }
 
 /**
-*
-*  rct2: 0x00688217
-*/
-paint_struct paint_session_arrange(paint_session * session)
+ * The same tests as check_bounding_box but without branches. Whether a node belongs behind the current one is close to
+ * random while walking the list, so evaluating every term is cheaper than mispredicting the early outs.
+ */
+template<uint8 _TRotation> static uint8 check_bounding_box_branchless(const paint_struct_bound_box& initialBBox,
+    const paint_struct_bound_box& currentBBox);
+
+template<> uint8 check_bounding_box_branchless<0>(const paint_struct_bound_box& initialBBox,
+    const paint_struct_bound_box& currentBBox)
+{
+    const uint8 reaches = (initialBBox.z_end >= currentBBox.z) & (initialBBox.y_end >= currentBBox.y) & (initialBBox.x_end >= currentBBox.x);
+    const uint8 intersects = (initialBBox.z < currentBBox.z_end) & (initialBBox.y < currentBBox.y_end) & (initialBBox.x < currentBBox.x_end);
+    return reaches & (intersects ^ 1);
+}
+
+template<> uint8 check_bounding_box_branchless<1>(const paint_struct_bound_box& initialBBox,
+    const paint_struct_bound_box& currentBBox)
+{
+    const uint8 reaches = (initialBBox.z_end >= currentBBox.z) & (initialBBox.y_end >= currentBBox.y) & (initialBBox.x_end < currentBBox.x);
+    const uint8 intersects = (initialBBox.z < currentBBox.z_end) & (initialBBox.y < currentBBox.y_end) & (initialBBox.x >= currentBBox.x_end);
+    return reaches & (intersects ^ 1);
+}
+
+template<> uint8 check_bounding_box_branchless<2>(const paint_struct_bound_box& initialBBox,
+    const paint_struct_bound_box& currentBBox)
+{
+    const uint8 reaches = (initialBBox.z_end >= currentBBox.z) & (initialBBox.y_end < currentBBox.y) & (initialBBox.x_end < currentBBox.x);
+    const uint8 intersects = (initialBBox.z < currentBBox.z_end) & (initialBBox.y >= currentBBox.y_end) & (initialBBox.x >= currentBBox.x_end);
+    return reaches & (intersects ^ 1);
+}
+
+template<> uint8 check_bounding_box_branchless<3>(const paint_struct_bound_box& initialBBox,
+    const paint_struct_bound_box& currentBBox)
+{
+    const uint8 reaches = (initialBBox.z_end >= currentBBox.z) & (initialBBox.y_end < currentBBox.y) & (initialBBox.x_end >= currentBBox.x);
+    const uint8 intersects = (initialBBox.z < currentBBox.z_end) & (initialBBox.y >= currentBBox.y_end) & (initialBBox.x < currentBBox.x_end);
+    return reaches & (intersects ^ 1);
+}
+
+/**
+ * Produces the same order as paint_arrange_structs_helper_rotation, which is kept as the reference. The comparison is
+ * branchless and also covers the flag of the node being compared, and the current bounding box is copied so that it
+ * does not have to be reloaded after every node that is moved.
+ */
+template<uint8 _TRotation>
+static paint_struct * paint_arrange_structs_rotation(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag)
+{
+    paint_struct * ps_cache;
+    if (!paint_arrange_structs_mark(ps_next, quadrantIndex, flag, &ps_cache)) return ps_cache;
+
+    paint_struct * ps = ps_cache;
+    paint_struct * ps_temp;
+    while (true)
+    {
+        while (true)
+        {
+            ps_next = ps->next_quadrant_ps;
+            if (ps_next == nullptr) return ps_cache;
+            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_BIGGER) return ps_cache;
+            if (ps_next->quadrant_flags & PAINT_QUADRANT_FLAG_IDENTICAL) break;
+            ps = ps_next;
+        }
+
+        ps_next->quadrant_flags &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        ps_temp = ps;
+
+        const paint_struct_bound_box initialBBox = ps_next->bounds;
+
+        while (true)
+        {
+            ps = ps_next;
+            ps_next = ps_next->next_quadrant_ps;
+            if (ps_next == nullptr) break;
+
+            const uint8 quadrantFlags = ps_next->quadrant_flags;
+            if (quadrantFlags & PAINT_QUADRANT_FLAG_BIGGER) break;
+
+            static_assert(PAINT_QUADRANT_FLAG_NEXT == (1 << 1), "Flag is shifted into the comparison result");
+            if (!((quadrantFlags >> 1) & check_bounding_box_branchless<_TRotation>(initialBBox, ps_next->bounds))) continue;
+
+            ps->next_quadrant_ps = ps_next->next_quadrant_ps;
+            paint_struct *ps_temp2 = ps_temp->next_quadrant_ps;
+            ps_temp->next_quadrant_ps = ps_next;
+            ps_next->next_quadrant_ps = ps_temp2;
+            ps_next = ps;
+        }
+
+        ps = ps_temp;
+    }
+}
+
+static paint_struct * paint_arrange_structs(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, uint8 rotation)
+{
+    switch (rotation)
+    {
+    case 0:
+        return paint_arrange_structs_rotation<0>(ps_next, quadrantIndex, flag);
+    case 1:
+        return paint_arrange_structs_rotation<1>(ps_next, quadrantIndex, flag);
+    case 2:
+        return paint_arrange_structs_rotation<2>(ps_next, quadrantIndex, flag);
+    case 3:
+        return paint_arrange_structs_rotation<3>(ps_next, quadrantIndex, flag);
+    }
+    return nullptr;
+}
+
+using paint_arrange_structs_fn = paint_struct * (*)(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, uint8 rotation);
+
+static paint_struct paint_session_arrange(paint_session * session, paint_arrange_structs_fn arrangeStructs)
 {
     paint_struct psHead = { 0 };
     paint_struct * ps = &psHead;
@@ -467,18 +665,32 @@ paint_struct paint_session_arrange(paint_session * session)
             }
         } while (++quadrantIndex <= session->QuadrantFrontIndex);
 
-        paint_struct * ps_cache = paint_arrange_structs_helper(&psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT, rotation);
+        paint_struct * ps_cache = arrangeStructs(&psHead, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT, rotation);
 
         quadrantIndex = session->QuadrantBackIndex;
         while (++quadrantIndex < session->QuadrantFrontIndex)
         {
-            ps_cache = paint_arrange_structs_helper(ps_cache, quadrantIndex & 0xFFFF, 0, rotation);
+            ps_cache = arrangeStructs(ps_cache, quadrantIndex & 0xFFFF, 0, rotation);
         }
     }
 
     return psHead;
 }
 
+/**
+*
+*  rct2: 0x00688217
+*/
+paint_struct paint_session_arrange(paint_session * session)
+{
+    return paint_session_arrange(session, paint_arrange_structs);
+}
+
+paint_struct paint_session_arrange_reference(paint_session * session)
+{
+    return paint_session_arrange(session, paint_arrange_structs_helper);
+}
+
 /**
 *
 *  rct2: 0x00688485
@@ -726,10 +938,20 @@ static void draw_pixel_info_crop_by_zoom(rct_drawpixelinfo *dpi)
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 {
-    // Currently limited to just one session at a time
-    assert(!_paintSessionInUse);
-    _paintSessionInUse = true;
-    paint_session * session = &gPaintSession;
+    paint_session * session;
+    {
+        std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+        if (_freePaintSessions.empty())
+        {
+            _extraPaintSessions.push_back(std::make_unique<paint_session>());
+            session = _extraPaintSessions.back().get();
+        }
+        else
+        {
+            session = _freePaintSessions.back();
+            _freePaintSessions.pop_back();
+        }
+    }
 
     paint_session_init(session, dpi);
     return session;
@@ -737,7 +959,15 @@ paint_session * paint_session_alloc(rct_drawpixelinfo * dpi)
 
 void paint_session_free(paint_session * session)
 {
-    _paintSessionInUse = false;
+    const paint_entry * currentChunkEntries = session->PaintEntryChunks[session->CurrentPaintEntryChunk]->Entries;
+    size_t numEntries = session->CurrentPaintEntryChunk * PAINT_ENTRY_CHUNK_SIZE +
+        (session->NextFreePaintStruct - currentChunkEntries);
+    profiler_record_high_water_mark(PROFILER_HIGH_WATER_MARK_PAINT_ENTRIES, numEntries);
+    // Recorded on every session rather than when a chunk is allocated, so that it is back after a profiler reset
+    profiler_record_high_water_mark(PROFILER_HIGH_WATER_MARK_PAINT_ENTRY_CHUNKS, _paintEntryChunkCount);
+
+    std::lock_guard<std::mutex> lock(_paintSessionPoolMutex);
+    _freePaintSessions.push_back(session);
 }
 
 /**
@@ -768,18 +998,17 @@ paint_struct * sub_98196C(
     session->UnkF1AD28 = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return nullptr;
-    }
-
     auto g1Element = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1Element == nullptr)
     {
+        if (session->PaintCacheRecording != nullptr)
+        {
+            paint_cache_record_struct(session, PAINT_CACHE_COMMAND_ROOT, nullptr, 0);
+        }
         return nullptr;
     }
 
-    paint_struct *ps = &session->NextFreePaintStruct->basic;
+    paint_struct *ps = &paint_session_get_next_free_entry(session)->basic;
     ps->image_id = image_id;
 
     LocationXYZ16 coord_3d =
@@ -847,12 +1076,7 @@ paint_struct * sub_98196C(
     sint16 right = left + g1Element->width;
     sint16 top = bottom + g1Element->height;
 
-    rct_drawpixelinfo *dpi = session->Unk140E9A8;
-
-    if (right <= dpi->x) return nullptr;
-    if (top <= dpi->y) return nullptr;
-    if (left >= (dpi->x + dpi->width)) return nullptr;
-    if (bottom >= (dpi->y + dpi->height)) return nullptr;
+    if (paint_session_is_culled(session, left, bottom, right, top)) return nullptr;
 
     ps->flags = 0;
     ps->bounds.x = coord_3d.x;
@@ -887,6 +1111,10 @@ paint_struct * sub_98196C(
 
     session->NextFreePaintStruct++;
 
+    if (session->PaintCacheRecording != nullptr)
+    {
+        paint_cache_record_struct(session, PAINT_CACHE_COMMAND_ROOT, ps, positionHash);
+    }
     return ps;
 }
 
@@ -927,35 +1155,22 @@ paint_struct * sub_98197C(
     paint_struct * ps = sub_9819_c(session, image_id, offset, boundBoxSize, boundBoxOffset);
 
     if (ps == nullptr) {
+        if (session->PaintCacheRecording != nullptr) {
+            paint_cache_record_struct(session, PAINT_CACHE_COMMAND_ROOT, nullptr, 0);
+        }
         return nullptr;
     }
 
     session->UnkF1AD28 = ps;
 
-    LocationXY16 attach =
-    {
-        (sint16)ps->bounds.x,
-        (sint16)ps->bounds.y
-    };
-
-    rotate_map_coordinates(&attach.x, &attach.y, session->CurrentRotation);
-    switch (session->CurrentRotation)
-    {
-    case 0:
-        break;
-    case 1:
-    case 3:
-        attach.x += 0x2000;
-        break;
-    case 2:
-        attach.x += 0x4000;
-        break;
-    }
-
-    sint32 positionHash = attach.x + attach.y;
+    sint32 positionHash = paint_get_bound_box_position_hash(session, ps);
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
     session->NextFreePaintStruct++;
+
+    if (session->PaintCacheRecording != nullptr) {
+        paint_cache_record_struct(session, PAINT_CACHE_COMMAND_ROOT, ps, positionHash);
+    }
     return ps;
 }
 
@@ -999,6 +1214,10 @@ paint_struct * sub_98198C(
     LocationXYZ16 boundBoxOffset = { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z };
     paint_struct * ps = sub_9819_c(session, image_id, offset, boundBoxSize, boundBoxOffset);
 
+    if (session->PaintCacheRecording != nullptr) {
+        paint_cache_record_struct(session, PAINT_CACHE_COMMAND_DETACHED, ps, 0);
+    }
+
     if (ps == nullptr) {
         return nullptr;
     }
@@ -1042,9 +1261,14 @@ paint_struct * sub_98199C(
 
     if (session->UnkF1AD28 == nullptr)
     {
-        return sub_98197C(
+        paint_struct * ps = sub_98197C(
             session, image_id, x_offset, y_offset, bound_box_length_x, bound_box_length_y, bound_box_length_z, z_offset,
             bound_box_offset_x, bound_box_offset_y, bound_box_offset_z);
+        if (session->PaintCacheRecording != nullptr)
+        {
+            paint_cache_record_set_type(session, PAINT_CACHE_COMMAND_CHAINED);
+        }
+        return ps;
     }
 
     LocationXYZ16 offset = { x_offset, y_offset, z_offset };
@@ -1052,6 +1276,13 @@ paint_struct * sub_98199C(
     LocationXYZ16 boundBoxOffset = { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z };
     paint_struct * ps = sub_9819_c(session, image_id, offset, boundBox, boundBoxOffset);
 
+    if (session->PaintCacheRecording != nullptr)
+    {
+        // Replayed without the struct before it, this is painted the way sub_98197C would
+        sint32 positionHash = ps != nullptr ? paint_get_bound_box_position_hash(session, ps) : 0;
+        paint_cache_record_struct(session, PAINT_CACHE_COMMAND_CHAINED, ps, positionHash);
+    }
+
     if (ps == nullptr)
     {
         return nullptr;
@@ -1077,14 +1308,15 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
 {
     if (session->UnkF1AD2C == nullptr)
     {
-        return paint_attach_to_previous_ps(session, image_id, x, y);
+        bool attached = paint_attach_to_previous_ps(session, image_id, x, y);
+        if (attached && session->PaintCacheRecording != nullptr)
+        {
+            paint_cache_record_set_type(session, PAINT_CACHE_COMMAND_ATTACH_ATTACH);
+        }
+        return attached;
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
-    attached_paint_struct * ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct * ps = &paint_session_get_next_free_entry(session)->attached;
     ps->image_id = image_id;
     ps->x = x;
     ps->y = y;
@@ -1099,6 +1331,10 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
 
     session->NextFreePaintStruct++;
 
+    if (session->PaintCacheRecording != nullptr)
+    {
+        paint_cache_record_attached(session, PAINT_CACHE_COMMAND_ATTACH_ATTACH, ps);
+    }
     return true;
 }
 
@@ -1112,11 +1348,7 @@ bool paint_attach_to_previous_attach(paint_session * session, uint32 image_id, u
 */
 bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint16 x, uint16 y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
-    attached_paint_struct * ps = &session->NextFreePaintStruct->attached;
+    attached_paint_struct * ps = &paint_session_get_next_free_entry(session)->attached;
 
     ps->image_id = image_id;
     ps->x = x;
@@ -1126,6 +1358,10 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
     paint_struct * masterPs = session->UnkF1AD28;
     if (masterPs == nullptr)
     {
+        if (session->PaintCacheRecording != nullptr)
+        {
+            paint_cache_record_attached(session, PAINT_CACHE_COMMAND_ATTACH_PS, nullptr);
+        }
         return false;
     }
 
@@ -1138,6 +1374,10 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
 
     session->UnkF1AD2C = ps;
 
+    if (session->PaintCacheRecording != nullptr)
+    {
+        paint_cache_record_attached(session, PAINT_CACHE_COMMAND_ATTACH_PS, ps);
+    }
     return true;
 }
 
@@ -1153,12 +1393,7 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
 */
 void paint_floating_money_effect(paint_session * session, money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return;
-    }
-
-    paint_string_struct * ps = &session->NextFreePaintStruct->string;
+    paint_string_struct * ps = &paint_session_get_next_free_entry(session)->string;
     ps->string_id = string_id;
     ps->next = nullptr;
     ps->args[0] = amount;
@@ -1200,6 +1435,8 @@ void paint_draw_money_structs(rct_drawpixelinfo * dpi, paint_string_struct * ps)
     rct_drawpixelinfo dpi2 = *dpi;
     draw_pixel_info_crop_by_zoom(&dpi2);
 
+    std::lock_guard<std::mutex> textLock(gPaintTextMutex);
+
     do
     {
         utf8 buffer[256];
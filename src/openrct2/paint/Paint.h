@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "../common.h"
 #include "../world/Map.h"
 #include "../interface/Colour.h"
@@ -127,18 +130,31 @@ struct tunnel_entry {
     uint8 type;
 };
 
-#define MAX_PAINT_QUADRANTS 512
-#define TUNNEL_MAX_COUNT    65
+#define MAX_PAINT_QUADRANTS     512
+#define TUNNEL_MAX_COUNT        65
+#define PAINT_ENTRY_CHUNK_SIZE  1024
+
+/**
+ * Paint entries are allocated from a list of chunks that grows on demand. A session keeps its chunks when it is reset,
+ * so only the first busy columns it paints allocate memory.
+ */
+struct paint_entry_chunk
+{
+    paint_entry Entries[PAINT_ENTRY_CHUNK_SIZE];
+};
+
+struct paint_cache_recording;
 
 struct paint_session
 {
     rct_drawpixelinfo *      Unk140E9A8;
-    paint_entry              PaintStructs[4000];
+    std::vector<std::unique_ptr<paint_entry_chunk>> PaintEntryChunks;
+    size_t                   CurrentPaintEntryChunk;
     paint_struct *           Quadrants[MAX_PAINT_QUADRANTS];
     uint32                   QuadrantBackIndex;
     uint32                   QuadrantFrontIndex;
     const void *             CurrentlyDrawnItem;
-    paint_entry *            EndOfPaintStructArray;
+    paint_entry *            EndOfPaintStructArray; // End of the current chunk
     paint_entry *            NextFreePaintStruct;
     LocationXY16             SpritePosition;
     paint_struct             UnkF1A4CC;
@@ -164,10 +180,18 @@ struct paint_session
     uint8                    Unk141E9DB;
     uint16                   WaterHeight;
     uint32                   TrackColours[4];
+    paint_cache_recording *  PaintCacheRecording; // Set while the paint structs of a tile are recorded, see PaintCache.h
 };
 
 extern paint_session gPaintSession;
 
+/**
+ * Text painted into the world (banners, signs, entrance names and money effects) is formatted through shared buffers,
+ * the font caches and the scrolling text cache. As viewport columns can be painted on several threads, painters hold
+ * this lock from formatting their text until it has been drawn or set up as a sprite.
+ */
+extern std::mutex gPaintTextMutex;
+
 // Global for paint clipping height.
 extern uint8 gClipHeight;
 
@@ -233,9 +257,13 @@ bool paint_attach_to_previous_ps(paint_session * session, uint32 image_id, uint1
 void paint_floating_money_effect(paint_session * session, money32 amount, rct_string_id string_id, sint16 y, sint16 z, sint8 y_offsets[], sint16 offset_x, uint32 rotation);
 
 paint_session * paint_session_alloc(rct_drawpixelinfo * dpi);
+paint_entry * paint_session_get_next_free_entry(paint_session * session);
+void paint_session_add_ps_to_quadrant(paint_session * session, paint_struct * ps, sint32 positionHash);
 void paint_session_free(paint_session *);
 void paint_session_generate(paint_session * session);
 paint_struct paint_session_arrange(paint_session * session);
+// The original arrange, slower but kept to check that paint_session_arrange draws in the same order
+paint_struct paint_session_arrange_reference(paint_session * session);
 paint_struct * paint_arrange_structs_helper(paint_struct * ps_next, uint16 quadrantIndex, uint8 flag, uint8 rotation);
 void paint_draw_structs(rct_drawpixelinfo * dpi, paint_struct * ps, uint32 viewFlags);
 void paint_draw_money_structs(rct_drawpixelinfo * dpi, paint_string_struct * ps);
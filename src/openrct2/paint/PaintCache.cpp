@@ -0,0 +1,640 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include "../config/Config.h"
+#include "../core/Util.hpp"
+#include "../drawing/Drawing.h"
+#include "../interface/Viewport.h"
+#include "../OpenRCT2.h"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Footpath.h"
+#include "../world/LargeScenery.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "../world/Sprite.h"
+#include "tile_element/TileElement.h"
+#include "Paint.h"
+#include "PaintCache.h"
+
+struct paint_cache_key
+{
+    uint32 ViewFlags;
+    uint8  Rotation;
+    uint8  ZoomLevel;
+};
+
+/**
+ * A recorded paint struct or attached paint struct as it was left by the painters. Whether it is created, culled or
+ * linked to the struct before it is decided again each time it is replayed.
+ */
+struct paint_cache_command
+{
+    uint8       Type;
+    bool        Exists; // false if the image does not exist, which makes the command only reset the struct to attach to
+    uint16      ElementIndex;
+    sint32      PositionHash;
+    sint32      Left;
+    sint32      Top;
+    sint32      Right;
+    sint32      Bottom;
+    paint_entry Entry;
+};
+
+struct paint_cache_view
+{
+    uint32                           Generation; // 0 while nothing has been recorded
+    uint32                           Modification;
+    paint_cache_key                  Key;
+    uint64                           Hash;
+    std::vector<paint_cache_command> Commands;
+};
+
+// Each viewport with its own rotation, zoom or view flags needs a recording of its own
+static constexpr const size_t PAINT_CACHE_VIEWS_PER_TILE = 4;
+
+/**
+ * The recordings of a tile for the views it has last been painted in, the most recently used first.
+ */
+struct paint_cache_tile
+{
+    std::array<paint_cache_view, PAINT_CACHE_VIEWS_PER_TILE> Views;
+};
+
+struct paint_cache_recorded_command
+{
+    uint8         Type;
+    bool          AddedToQuadrant;
+    paint_entry * Entry;
+    sint32        PositionHash;
+};
+
+/**
+ * The state painters leave behind in the session while painting a tile, restored when a recording has to be dropped
+ * and the tile painted again.
+ */
+struct paint_cache_tile_state
+{
+    support_height           SupportSegments[9];
+    support_height           Support;
+    LocationXY16             MapPosition;
+    tunnel_entry             LeftTunnels[TUNNEL_MAX_COUNT];
+    uint8                    LeftTunnelCount;
+    tunnel_entry             RightTunnels[TUNNEL_MAX_COUNT];
+    uint8                    RightTunnelCount;
+    uint8                    VerticalTunnelHeight;
+    uint8                    InteractionType;
+    const void *             CurrentlyDrawnItem;
+    const rct_tile_element * SurfaceElement;
+    rct_tile_element *       PathElementOnSameHeight;
+    rct_tile_element *       TrackElementOnSameHeight;
+    bool                     DidPassSurface;
+    uint8                    Unk141E9DB;
+    uint16                   WaterHeight;
+};
+
+struct paint_cache_recording
+{
+    uint32                                    TileIndex;
+    const rct_tile_element *                  FirstElement;
+    size_t                                    ElementCount;
+    paint_cache_key                           Key;
+    uint32                                    Generation;
+    uint32                                    Modification;
+    uint64                                    Hash;
+    bool                                      Failed;
+    std::vector<paint_cache_recorded_command> Commands;
+
+    // The session as it was before the tile was painted
+    size_t                  CurrentPaintEntryChunk;
+    paint_entry *           NextFreePaintStruct;
+    paint_entry *           EndOfPaintStructArray;
+    uint32                  QuadrantBackIndex;
+    uint32                  QuadrantFrontIndex;
+    paint_struct *          UnkF1AD28;
+    attached_paint_struct * UnkF1AD2C;
+    paint_cache_tile_state  TileState;
+};
+
+// Tiles are painted by several columns, possibly on different threads, so each tile is guarded by one of these locks
+static constexpr const size_t PAINT_CACHE_LOCK_COUNT = 64;
+
+static paint_cache_tile                                _paintCacheTiles[MAX_TILE_TILE_ELEMENT_POINTERS];
+static uint32                                          _paintCacheTileModifications[MAX_TILE_TILE_ELEMENT_POINTERS];
+static std::array<std::mutex, PAINT_CACHE_LOCK_COUNT>  _paintCacheLocks;
+static std::atomic<uint32>                             _paintCacheGeneration(1);
+
+static bool paint_cache_key_equals(const paint_cache_key &a, const paint_cache_key &b)
+{
+    return a.ViewFlags == b.ViewFlags && a.Rotation == b.Rotation && a.ZoomLevel == b.ZoomLevel;
+}
+
+/**
+ * Whether the tiles can be taken from the cache at all. Anything drawn on top of the map for tools, the editors or
+ * debugging is painted as usual, as is a tile that has to add its supports to a ride painted before it.
+ */
+static bool paint_cache_is_usable(const paint_session * session, bool partOfVirtualFloor)
+{
+    if (!gConfigGeneral.paint_cache)
+        return false;
+    if (partOfVirtualFloor || gShowSupportSegmentHeights || gTrackDesignSaveMode || map_overlay_is_active())
+        return false;
+    if (gStaffDrawPatrolAreas != SPRITE_INDEX_NULL)
+        return false;
+    if (gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
+        return false;
+    if (gCurrentViewportFlags &
+        (VIEWPORT_FLAG_PAINT_CLIP_TO_HEIGHT | VIEWPORT_FLAG_LAND_OWNERSHIP | VIEWPORT_FLAG_CONSTRUCTION_RIGHTS))
+        return false;
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+        return false;
+    if (session->WoodenSupportsPrependTo != nullptr || session->Unk141E9DB != 0)
+        return false;
+
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE)
+    {
+        const LocationXY16 &pos = session->MapPosition;
+        if (pos.x >= gMapSelectPositionA.x && pos.x <= gMapSelectPositionB.x && pos.y >= gMapSelectPositionA.y &&
+            pos.y <= gMapSelectPositionB.y)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Whether the element paints the same way every frame for as long as the element itself does not change.
+ */
+static bool paint_cache_is_element_static(const rct_tile_element * tileElement)
+{
+    switch (tile_element_get_type(tileElement))
+    {
+    case TILE_ELEMENT_TYPE_SURFACE:
+        return true;
+    case TILE_ELEMENT_TYPE_PATH:
+        // Queue banners scroll the name of the ride
+        return !footpath_element_has_queue_banner(tileElement);
+    case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+    {
+        const rct_scenery_entry * entry = get_small_scenery_entry(tileElement->properties.scenery.type);
+        return entry == nullptr || !scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED);
+    }
+    case TILE_ELEMENT_TYPE_WALL:
+    {
+        const rct_scenery_entry * entry = get_wall_entry(tileElement->properties.wall.type);
+        return entry == nullptr || (!(entry->wall.flags2 & WALL_SCENERY_2_ANIMATED) && entry->wall.scrolling_mode == 0xFF);
+    }
+    case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+    {
+        const rct_scenery_entry * entry = get_large_scenery_entry(scenery_large_get_type(tileElement));
+        return entry == nullptr ||
+            (!(entry->large_scenery.flags & LARGE_SCENERY_FLAG_3D_TEXT) && entry->large_scenery.scrolling_mode == 0xFF);
+    }
+    default:
+        return false;
+    }
+}
+
+/**
+ * Hashes the elements of the tile, which catches any change to the tile itself even when it was not invalidated.
+ * Returns false if one of the elements can not be cached.
+ */
+static bool paint_cache_hash_tile(const rct_tile_element * firstElement, size_t * elementCount, uint64 * hash)
+{
+    static_assert(sizeof(rct_tile_element) == sizeof(uint64), "Tile elements are hashed as 64-bit words");
+
+    uint64 h = 14695981039346656037ULL;
+    size_t count = 0;
+    const rct_tile_element * tileElement = firstElement;
+    do
+    {
+        if (!paint_cache_is_element_static(tileElement))
+        {
+            return false;
+        }
+
+        uint64 word;
+        std::memcpy(&word, tileElement, sizeof(word));
+        h = (h ^ word) * 1099511628211ULL;
+        h ^= h >> 29;
+        count++;
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+
+    *elementCount = count;
+    *hash = h;
+    return true;
+}
+
+static bool paint_cache_is_culled(const rct_drawpixelinfo * dpi, const paint_cache_command &command)
+{
+    return !command.Exists || command.Right <= dpi->x || command.Bottom <= dpi->y || command.Left >= dpi->x + dpi->width ||
+        command.Top >= dpi->y + dpi->height;
+}
+
+static paint_struct * paint_cache_replay_struct(
+    paint_session * session, const paint_cache_command &command, const rct_tile_element * firstElement)
+{
+    paint_struct * ps = &paint_session_get_next_free_entry(session)->basic;
+    *ps = command.Entry.basic;
+    ps->tileElement = const_cast<rct_tile_element *>(firstElement + command.ElementIndex);
+    session->NextFreePaintStruct++;
+    return ps;
+}
+
+static attached_paint_struct * paint_cache_replay_attached(paint_session * session, const paint_cache_command &command)
+{
+    attached_paint_struct * ps = &paint_session_get_next_free_entry(session)->attached;
+    *ps = command.Entry.attached;
+    session->NextFreePaintStruct++;
+    return ps;
+}
+
+/**
+ * Replays the commands the way sub_98196C and its siblings would have run them for the current column.
+ */
+static void paint_cache_replay(
+    paint_session * session, const std::vector<paint_cache_command> &commands, const rct_tile_element * firstElement)
+{
+    const rct_drawpixelinfo * dpi = session->Unk140E9A8;
+    for (const paint_cache_command &command : commands)
+    {
+        uint8 type = command.Type;
+        if (type == PAINT_CACHE_COMMAND_CHAINED && session->UnkF1AD28 == nullptr)
+        {
+            type = PAINT_CACHE_COMMAND_ROOT;
+        }
+        if (type == PAINT_CACHE_COMMAND_ATTACH_ATTACH && session->UnkF1AD2C == nullptr)
+        {
+            type = PAINT_CACHE_COMMAND_ATTACH_PS;
+        }
+
+        switch (type)
+        {
+        case PAINT_CACHE_COMMAND_ROOT:
+        case PAINT_CACHE_COMMAND_DETACHED:
+        {
+            session->UnkF1AD28 = nullptr;
+            session->UnkF1AD2C = nullptr;
+            if (paint_cache_is_culled(dpi, command))
+                break;
+
+            paint_struct * ps = paint_cache_replay_struct(session, command, firstElement);
+            if (type == PAINT_CACHE_COMMAND_ROOT)
+            {
+                paint_session_add_ps_to_quadrant(session, ps, command.PositionHash);
+            }
+            session->UnkF1AD28 = ps;
+            break;
+        }
+        case PAINT_CACHE_COMMAND_CHAINED:
+        {
+            if (paint_cache_is_culled(dpi, command))
+                break;
+
+            paint_struct * ps = paint_cache_replay_struct(session, command, firstElement);
+            session->UnkF1AD28->var_20 = ps;
+            session->UnkF1AD28 = ps;
+            break;
+        }
+        case PAINT_CACHE_COMMAND_ATTACH_PS:
+        {
+            paint_struct * masterPs = session->UnkF1AD28;
+            if (masterPs == nullptr)
+                break;
+
+            attached_paint_struct * ps = paint_cache_replay_attached(session, command);
+            ps->next = masterPs->attached_ps;
+            masterPs->attached_ps = ps;
+            session->UnkF1AD2C = ps;
+            break;
+        }
+        case PAINT_CACHE_COMMAND_ATTACH_ATTACH:
+        {
+            attached_paint_struct * ps = paint_cache_replay_attached(session, command);
+            ps->next = nullptr;
+            session->UnkF1AD2C->next = ps;
+            session->UnkF1AD2C = ps;
+            break;
+        }
+        }
+    }
+}
+
+static void paint_cache_save_tile_state(const paint_session * session, paint_cache_tile_state * state)
+{
+    std::copy_n(session->SupportSegments, Util::CountOf(state->SupportSegments), state->SupportSegments);
+    state->Support = session->Support;
+    state->MapPosition = session->MapPosition;
+    std::copy_n(session->LeftTunnels, TUNNEL_MAX_COUNT, state->LeftTunnels);
+    state->LeftTunnelCount = session->LeftTunnelCount;
+    std::copy_n(session->RightTunnels, TUNNEL_MAX_COUNT, state->RightTunnels);
+    state->RightTunnelCount = session->RightTunnelCount;
+    state->VerticalTunnelHeight = session->VerticalTunnelHeight;
+    state->InteractionType = session->InteractionType;
+    state->CurrentlyDrawnItem = session->CurrentlyDrawnItem;
+    state->SurfaceElement = session->SurfaceElement;
+    state->PathElementOnSameHeight = session->PathElementOnSameHeight;
+    state->TrackElementOnSameHeight = session->TrackElementOnSameHeight;
+    state->DidPassSurface = session->DidPassSurface;
+    state->Unk141E9DB = session->Unk141E9DB;
+    state->WaterHeight = session->WaterHeight;
+}
+
+static void paint_cache_restore_tile_state(paint_session * session, const paint_cache_tile_state * state)
+{
+    std::copy_n(state->SupportSegments, Util::CountOf(state->SupportSegments), session->SupportSegments);
+    session->Support = state->Support;
+    session->MapPosition = state->MapPosition;
+    std::copy_n(state->LeftTunnels, TUNNEL_MAX_COUNT, session->LeftTunnels);
+    session->LeftTunnelCount = state->LeftTunnelCount;
+    std::copy_n(state->RightTunnels, TUNNEL_MAX_COUNT, session->RightTunnels);
+    session->RightTunnelCount = state->RightTunnelCount;
+    session->VerticalTunnelHeight = state->VerticalTunnelHeight;
+    session->InteractionType = state->InteractionType;
+    session->CurrentlyDrawnItem = state->CurrentlyDrawnItem;
+    session->SurfaceElement = state->SurfaceElement;
+    session->PathElementOnSameHeight = state->PathElementOnSameHeight;
+    session->TrackElementOnSameHeight = state->TrackElementOnSameHeight;
+    session->DidPassSurface = state->DidPassSurface;
+    session->Unk141E9DB = state->Unk141E9DB;
+    session->WaterHeight = state->WaterHeight;
+}
+
+/**
+ * Either paints the tile from the cache or, if the tile can be cached, starts recording the paint structs of its
+ * elements. These are recorded without culling them against the column, so that they can be replayed in any column.
+ */
+sint32 paint_cache_begin_tile(paint_session * session, const rct_tile_element * firstElement, bool partOfVirtualFloor)
+{
+    if (!paint_cache_is_usable(session, partOfVirtualFloor))
+    {
+        return PAINT_CACHE_BYPASS;
+    }
+
+    size_t elementCount;
+    uint64 hash;
+    if (!paint_cache_hash_tile(firstElement, &elementCount, &hash))
+    {
+        return PAINT_CACHE_BYPASS;
+    }
+
+    const LocationXY16 &pos = session->MapPosition;
+    uint32 tileIndex = (pos.x >> 5) + (pos.y >> 5) * MAXIMUM_MAP_SIZE_TECHNICAL;
+    paint_cache_key key = { gCurrentViewportFlags, session->CurrentRotation, (uint8)session->Unk140E9A8->zoom_level };
+    uint32 generation = _paintCacheGeneration.load(std::memory_order_relaxed);
+    uint32 modification = _paintCacheTileModifications[tileIndex];
+    {
+        std::lock_guard<std::mutex> lock(_paintCacheLocks[tileIndex % PAINT_CACHE_LOCK_COUNT]);
+        auto &views = _paintCacheTiles[tileIndex].Views;
+        for (auto it = views.begin(); it != views.end(); it++)
+        {
+            if (it->Generation == generation && it->Modification == modification && it->Hash == hash &&
+                paint_cache_key_equals(it->Key, key))
+            {
+                std::rotate(views.begin(), it, it + 1);
+                paint_cache_replay(session, views[0].Commands, firstElement);
+                return PAINT_CACHE_REPLAYED;
+            }
+        }
+    }
+
+    thread_local paint_cache_recording recording;
+    recording.TileIndex = tileIndex;
+    recording.FirstElement = firstElement;
+    recording.ElementCount = elementCount;
+    recording.Key = key;
+    recording.Generation = generation;
+    recording.Modification = modification;
+    recording.Hash = hash;
+    recording.Failed = false;
+    recording.Commands.clear();
+    recording.CurrentPaintEntryChunk = session->CurrentPaintEntryChunk;
+    recording.NextFreePaintStruct = session->NextFreePaintStruct;
+    recording.EndOfPaintStructArray = session->EndOfPaintStructArray;
+    recording.QuadrantBackIndex = session->QuadrantBackIndex;
+    recording.QuadrantFrontIndex = session->QuadrantFrontIndex;
+    recording.UnkF1AD28 = session->UnkF1AD28;
+    recording.UnkF1AD2C = session->UnkF1AD2C;
+    paint_cache_save_tile_state(session, &recording.TileState);
+
+    // Nothing painted before the tile may be touched, the replay decides what the tile attaches to
+    session->UnkF1AD28 = nullptr;
+    session->UnkF1AD2C = nullptr;
+    session->PaintCacheRecording = &recording;
+    return PAINT_CACHE_RECORDING;
+}
+
+/**
+ * Stores what has been recorded for the tile, takes the recorded structs back out of the session and replays them
+ * instead. Returns false if the recording had to be dropped, in which case the tile has to be painted again as usual.
+ */
+bool paint_cache_end_tile(paint_session * session)
+{
+    paint_cache_recording * recording = session->PaintCacheRecording;
+    session->PaintCacheRecording = nullptr;
+
+    std::vector<paint_cache_command> commands;
+    commands.reserve(recording->Commands.size());
+    for (const paint_cache_recorded_command &recorded : recording->Commands)
+    {
+        if (recording->Failed)
+            break;
+
+        paint_cache_command command = {};
+        command.Type = recorded.Type;
+        command.Exists = recorded.Entry != nullptr;
+        command.PositionHash = recorded.PositionHash;
+        if (recorded.Type == PAINT_CACHE_COMMAND_ATTACH_PS || recorded.Type == PAINT_CACHE_COMMAND_ATTACH_ATTACH)
+        {
+            command.Entry.attached = recorded.Entry->attached;
+            command.Entry.attached.next = nullptr;
+        }
+        else if (command.Exists)
+        {
+            const paint_struct &ps = recorded.Entry->basic;
+            ptrdiff_t elementIndex = ps.tileElement - recording->FirstElement;
+            if (elementIndex < 0 || elementIndex >= (ptrdiff_t)recording->ElementCount)
+            {
+                recording->Failed = true;
+                break;
+            }
+
+            const rct_g1_element * g1 = gfx_get_g1_element(ps.image_id & 0x7FFFF);
+            command.Left = (sint16)ps.x + g1->x_offset;
+            command.Top = (sint16)ps.y + g1->y_offset;
+            command.Right = command.Left + g1->width;
+            command.Bottom = command.Top + g1->height;
+            command.ElementIndex = (uint16)elementIndex;
+            command.Entry.basic = ps;
+            command.Entry.basic.attached_ps = nullptr;
+            command.Entry.basic.var_20 = nullptr;
+            command.Entry.basic.next_quadrant_ps = nullptr;
+            command.Entry.basic.tileElement = nullptr;
+        }
+        commands.push_back(command);
+    }
+
+    // Take the recorded structs back out of the quadrants, newest first as each was put in front of its quadrant
+    for (auto it = recording->Commands.rbegin(); it != recording->Commands.rend(); it++)
+    {
+        if (it->AddedToQuadrant)
+        {
+            const paint_struct &ps = it->Entry->basic;
+            session->Quadrants[ps.quadrant_index] = ps.next_quadrant_ps;
+        }
+    }
+    session->CurrentPaintEntryChunk = recording->CurrentPaintEntryChunk;
+    session->NextFreePaintStruct = recording->NextFreePaintStruct;
+    session->EndOfPaintStructArray = recording->EndOfPaintStructArray;
+    session->QuadrantBackIndex = recording->QuadrantBackIndex;
+    session->QuadrantFrontIndex = recording->QuadrantFrontIndex;
+    session->UnkF1AD28 = recording->UnkF1AD28;
+    session->UnkF1AD2C = recording->UnkF1AD2C;
+
+    if (recording->Failed)
+    {
+        paint_cache_restore_tile_state(session, &recording->TileState);
+        return false;
+    }
+
+    paint_cache_replay(session, commands, recording->FirstElement);
+
+    // Replaces the outdated recording of the same view if there is one, otherwise the least recently used one
+    std::lock_guard<std::mutex> lock(_paintCacheLocks[recording->TileIndex % PAINT_CACHE_LOCK_COUNT]);
+    auto &views = _paintCacheTiles[recording->TileIndex].Views;
+    auto it = std::find_if(views.begin(), views.end(), [recording](const paint_cache_view &view) -> bool
+    {
+        return view.Generation != 0 && paint_cache_key_equals(view.Key, recording->Key);
+    });
+    if (it == views.end())
+    {
+        it = views.end() - 1;
+    }
+    std::rotate(views.begin(), it, it + 1);
+
+    paint_cache_view &view = views[0];
+    view.Generation = recording->Generation;
+    view.Modification = recording->Modification;
+    view.Key = recording->Key;
+    view.Hash = recording->Hash;
+    view.Commands = std::move(commands);
+    return true;
+}
+
+void paint_cache_record_struct(paint_session * session, uint8 type, paint_struct * ps, sint32 positionHash)
+{
+    paint_cache_recording * recording = session->PaintCacheRecording;
+    paint_cache_recorded_command recorded = {};
+    recorded.Type = type;
+    recorded.AddedToQuadrant = ps != nullptr && type == PAINT_CACHE_COMMAND_ROOT;
+    recorded.Entry = reinterpret_cast<paint_entry *>(ps);
+    recorded.PositionHash = positionHash;
+    recording->Commands.push_back(recorded);
+}
+
+/**
+ * Records an attached paint struct, ps is nullptr if there was no struct to attach it to.
+ */
+void paint_cache_record_attached(paint_session * session, uint8 type, attached_paint_struct * ps)
+{
+    paint_cache_recording * recording = session->PaintCacheRecording;
+    if (recording->Commands.empty())
+    {
+        // The tile attaches to whatever was painted before it
+        recording->Failed = true;
+        return;
+    }
+    if (ps == nullptr)
+    {
+        // Only happens after an image that does not exist, which the replay leaves nothing to attach to either
+        return;
+    }
+
+    paint_cache_recorded_command recorded = {};
+    recorded.Type = type;
+    recorded.Entry = reinterpret_cast<paint_entry *>(ps);
+    recording->Commands.push_back(recorded);
+}
+
+/**
+ * Changes the type of the last command, for the primitives that fell back on another one.
+ */
+void paint_cache_record_set_type(paint_session * session, uint8 type)
+{
+    paint_cache_recording * recording = session->PaintCacheRecording;
+    if (type == PAINT_CACHE_COMMAND_CHAINED && recording->Commands.size() == 1)
+    {
+        // The tile chains onto whatever was painted before it
+        recording->Failed = true;
+    }
+    recording->Commands.back().Type = type;
+}
+
+/**
+ * Drops the cached paint structs of the tile and its neighbours, which paint the edges between them. Takes tile
+ * coordinates.
+ */
+void paint_cache_invalidate_tile(sint32 x, sint32 y)
+{
+    for (sint32 dy = -1; dy <= 1; dy++)
+    {
+        for (sint32 dx = -1; dx <= 1; dx++)
+        {
+            sint32 tileX = x + dx;
+            sint32 tileY = y + dy;
+            if (tileX >= 0 && tileX < MAXIMUM_MAP_SIZE_TECHNICAL && tileY >= 0 && tileY < MAXIMUM_MAP_SIZE_TECHNICAL)
+            {
+                _paintCacheTileModifications[tileX + tileY * MAXIMUM_MAP_SIZE_TECHNICAL]++;
+            }
+        }
+    }
+}
+
+void paint_cache_invalidate_all()
+{
+    // Generation 0 marks views that have never been recorded
+    if (++_paintCacheGeneration == 0)
+    {
+        _paintCacheGeneration++;
+    }
+}
+
+/**
+ * Drops the cached paint structs and frees their memory, e.g. when a park is loaded.
+ */
+void paint_cache_reset()
+{
+    for (size_t i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        std::lock_guard<std::mutex> lock(_paintCacheLocks[i % PAINT_CACHE_LOCK_COUNT]);
+        for (paint_cache_view &view : _paintCacheTiles[i].Views)
+        {
+            view.Generation = 0;
+            view.Commands.clear();
+            view.Commands.shrink_to_fit();
+        }
+    }
+    paint_cache_invalidate_all();
+}
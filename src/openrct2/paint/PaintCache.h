@@ -0,0 +1,58 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include "../common.h"
+
+struct attached_paint_struct;
+struct paint_session;
+struct paint_struct;
+struct rct_tile_element;
+
+/**
+ * The paint structs of tiles that only hold static elements (land, paths, walls and scenery that is not animated and
+ * shows no text) are recorded the first time such a tile is painted and replayed afterwards, until the tile or one of
+ * its neighbours changes. Each tile keeps recordings for the last few views (rotation, zoom and view flags) it was
+ * painted in. Sprites are always painted fresh.
+ */
+enum PAINT_CACHE_RESULT
+{
+    PAINT_CACHE_BYPASS,    // Paint the tile as usual
+    PAINT_CACHE_REPLAYED,  // The tile has been painted from the cache
+    PAINT_CACHE_RECORDING, // Paint the tile as usual, then call paint_cache_end_tile
+};
+
+enum PAINT_CACHE_COMMAND
+{
+    PAINT_CACHE_COMMAND_ROOT,          // sub_98196C, sub_98197C
+    PAINT_CACHE_COMMAND_DETACHED,      // sub_98198C
+    PAINT_CACHE_COMMAND_CHAINED,       // sub_98199C
+    PAINT_CACHE_COMMAND_ATTACH_PS,     // paint_attach_to_previous_ps
+    PAINT_CACHE_COMMAND_ATTACH_ATTACH, // paint_attach_to_previous_attach
+};
+
+sint32 paint_cache_begin_tile(paint_session * session, const rct_tile_element * firstElement, bool partOfVirtualFloor);
+bool paint_cache_end_tile(paint_session * session);
+
+// Called by the paint primitives while a tile is being recorded, ps is nullptr if the image does not exist
+void paint_cache_record_struct(paint_session * session, uint8 type, paint_struct * ps, sint32 positionHash);
+void paint_cache_record_attached(paint_session * session, uint8 type, attached_paint_struct * ps);
+void paint_cache_record_set_type(paint_session * session, uint8 type);
+
+void paint_cache_invalidate_tile(sint32 x, sint32 y);
+void paint_cache_invalidate_all();
+void paint_cache_reset();
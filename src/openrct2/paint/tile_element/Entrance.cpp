@@ -26,8 +26,6 @@
 #include "TileElement.h"
 #include "../../drawing/LightFX.h"
 
-static uint32 _unk9E32BC;
-
 /**
  *
  *  rct2: 0x0066508C, 0x00665540
@@ -82,12 +80,12 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
     image_id = (colour_1 << 19) | (colour_2 << 24) | IMAGE_TYPE_REMAP | IMAGE_TYPE_REMAP_2_PLUS;
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_RIDE;
-    _unk9E32BC = 0;
+    uint32 supportsImageId = 0;
 
     if (tile_element->flags & TILE_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         image_id = CONSTRUCTION_MARKER;
-        _unk9E32BC = image_id;
+        supportsImageId = image_id;
         if (transparant_image_id)
             transparant_image_id = image_id;
     }
@@ -144,6 +142,8 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
         !(tile_element->flags & TILE_ELEMENT_FLAG_GHOST) &&
         tile_element->properties.entrance.ride_index != 0xFF){
 
+        std::lock_guard<std::mutex> textLock(gPaintTextMutex);
+
         set_format_arg(0, uint32, 0);
         set_format_arg(4, uint32, 0);
 
@@ -175,7 +175,7 @@ static void ride_entrance_exit_paint(paint_session * session, uint8 direction, s
             height + style->height, 2, 2, height + style->height);
     }
 
-    image_id = _unk9E32BC;
+    image_id = supportsImageId;
     if (image_id == 0) {
         image_id = SPRITE_ID_PALETTE_COLOUR_1(COLOUR_SATURATED_BROWN);
     }
@@ -203,12 +203,10 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
 #endif
 
     session->InteractionType = VIEWPORT_INTERACTION_ITEM_PARK;
-    _unk9E32BC = 0;
     uint32 image_id, ghost_id = 0;
     if (tile_element->flags & TILE_ELEMENT_FLAG_GHOST){
         session->InteractionType = VIEWPORT_INTERACTION_ITEM_NONE;
         ghost_id = CONSTRUCTION_MARKER;
-        _unk9E32BC = ghost_id;
     }
 
     rct_footpath_entry* path_entry = get_footpath_entry(tile_element->properties.entrance.path_type);
@@ -241,6 +239,8 @@ static void park_entrance_paint(paint_session * session, uint8 direction, sint32
 
         {
             rct_string_id park_text_id = STR_BANNER_TEXT_CLOSED;
+            std::lock_guard<std::mutex> textLock(gPaintTextMutex);
+
             set_format_arg(0, uint32, 0);
             set_format_arg(4, uint32, 0);
 
@@ -358,6 +358,8 @@ void fence_paint(paint_session * session, uint8 direction, sint32 height, const
         return;
     }
 
+    std::lock_guard<std::mutex> textLock(gPaintTextMutex);
+
     set_format_arg(0, uint32, 0);
     set_format_arg(4, uint32, 0);
 
@@ -459,6 +459,8 @@ static void sub_6A4101(
             uint16 scrollingMode = footpathEntry->scrolling_mode;
             scrollingMode += direction;
 
+            std::lock_guard<std::mutex> textLock(gPaintTextMutex);
+
             set_format_arg(0, uint32, 0);
             set_format_arg(4, uint32, 0);
 
@@ -866,11 +868,16 @@ void path_paint(paint_session * session, uint8 direction, uint16 height, const r
     rct_footpath_entry * footpathEntry = get_footpath_entry(pathType);
 
     if (footpathEntry != nullptr) {
+        // Real paths are never connected to the provisional footpath, draw them as if they were
+        rct_tile_element pathElement = *tile_element;
+        pathElement.properties.path.edges |= footpath_get_provisional_connections(
+            session->MapPosition.x, session->MapPosition.y, tile_element);
+
         if (footpathEntry->support_type == FOOTPATH_ENTRY_SUPPORT_TYPE_POLE) {
-            path_paint_pole_support(session, tile_element, height, footpathEntry, word_F3F038, imageFlags, sceneryImageFlags);
+            path_paint_pole_support(session, &pathElement, height, footpathEntry, word_F3F038, imageFlags, sceneryImageFlags);
         }
         else {
-            path_paint_box_support(session, tile_element, height, footpathEntry, word_F3F038, imageFlags, sceneryImageFlags);
+            path_paint_box_support(session, &pathElement, height, footpathEntry, word_F3F038, imageFlags, sceneryImageFlags);
         }
     }
 
@@ -998,7 +998,8 @@ void surface_paint(paint_session * session, uint8 direction, uint16 height, cons
         const sint16 x = session->MapPosition.x;
         const sint16 y = session->MapPosition.y;
 
-        sint32 dx = tile_element_height(x + 16, y + 16) & 0xFFFF;
+        // The height cache is filled in as it is read, which is not safe while columns are painted on several threads
+        sint32 dx = tile_element_height_uncached(x + 16, y + 16) & 0xFFFF;
         dx += 3;
 
         sint32 image_id = (SPR_HEIGHT_MARKER_BASE + dx / 16) | 0x20780000;
@@ -1160,7 +1161,7 @@ void surface_paint(paint_session * session, uint8 direction, uint16 height, cons
         else if (tileElement->properties.surface.ownership & OWNERSHIP_AVAILABLE)
         {
             const LocationXY16& pos = session->MapPosition;
-            const sint32 height2 = (tile_element_height(pos.x + 16, pos.y + 16) & 0xFFFF) + 3;
+            const sint32 height2 = (tile_element_height_uncached(pos.x + 16, pos.y + 16) & 0xFFFF) + 3;
             paint_struct * backup = session->UnkF1AD28;
             sub_98196C(session, SPR_LAND_OWNERSHIP_AVAILABLE, 16, 16, 1, 1, 0, height2);
             session->UnkF1AD28 = backup;
@@ -1178,7 +1179,7 @@ void surface_paint(paint_session * session, uint8 direction, uint16 height, cons
         else if (tileElement->properties.surface.ownership & OWNERSHIP_CONSTRUCTION_RIGHTS_AVAILABLE)
         {
             const LocationXY16& pos = session->MapPosition;
-            const sint32 height2 = tile_element_height(pos.x + 16, pos.y + 16) & 0xFFFF;
+            const sint32 height2 = tile_element_height_uncached(pos.x + 16, pos.y + 16) & 0xFFFF;
             paint_struct * backup = session->UnkF1AD28;
             sub_98196C(session, SPR_LAND_CONSTRUCTION_RIGHTS_AVAILABLE, 16, 16, 1, 1, 0, height2 + 3);
             session->UnkF1AD28 = backup;
@@ -31,6 +31,7 @@
 #include "../../world/Scenery.h"
 #include "../../sprites.h"
 #include "../Paint.h"
+#include "../PaintCache.h"
 #include "../Supports.h"
 #include "../VirtualFloor.h"
 #include "Surface.h"
@@ -42,6 +43,7 @@ uint16 testPaintVerticalTunnelHeight;
 
 static void blank_tiles_paint(paint_session * session, sint32 x, sint32 y);
 static void sub_68B3FB(paint_session * session, sint32 x, sint32 y);
+static rct_tile_element * tile_element_paint_elements(paint_session * session, rct_tile_element * tile_element, uint8 rotation);
 
 const sint32 SEGMENTS_ALL = SEGMENT_B4 | SEGMENT_B8 | SEGMENT_BC | SEGMENT_C0 | SEGMENT_C4 | SEGMENT_C8 | SEGMENT_CC | SEGMENT_D0 | SEGMENT_D4;
 
@@ -249,6 +251,78 @@ static void sub_68B3FB(paint_session * session, sint32 x, sint32 y)
 
     session->SpritePosition.x = x;
     session->SpritePosition.y = y;
+
+    sint32 cacheResult = PAINT_CACHE_BYPASS;
+#ifndef __TESTPAINT__
+    cacheResult = paint_cache_begin_tile(session, tile_element, partOfVirtualFloor);
+    if (cacheResult == PAINT_CACHE_REPLAYED)
+        return;
+#endif // __TESTPAINT__
+
+    rct_tile_element * lastElement = tile_element_paint_elements(session, tile_element, rotation);
+#ifndef __TESTPAINT__
+    if (cacheResult == PAINT_CACHE_RECORDING && !paint_cache_end_tile(session))
+    {
+        lastElement = tile_element_paint_elements(session, tile_element, rotation);
+    }
+#endif // __TESTPAINT__
+    if (lastElement == nullptr)
+        return;
+
+#ifndef __TESTPAINT__
+    if (gConfigGeneral.use_virtual_floor && partOfVirtualFloor)
+    {
+        virtual_floor_paint(session);
+    }
+#endif // __TESTPAINT__
+
+    if (!gShowSupportSegmentHeights) {
+        return;
+    }
+
+    if (tile_element_get_type(lastElement) == TILE_ELEMENT_TYPE_SURFACE) {
+        return;
+    }
+
+    static constexpr const sint32 segmentPositions[][3] = {
+        {0, 6, 2},
+        {5, 4, 8},
+        {1, 7, 3},
+    };
+
+    for (sint32 sy = 0; sy < 3; sy++) {
+        for (sint32 sx = 0; sx < 3; sx++) {
+            uint16 segmentHeight = session->SupportSegments[segmentPositions[sy][sx]].height;
+            sint32 imageColourFlats = 0b101111 << 19 | IMAGE_TYPE_TRANSPARENT;
+            if (segmentHeight == 0xFFFF) {
+                segmentHeight = session->Support.height;
+                // white: 0b101101
+                imageColourFlats = 0b111011 << 19 | IMAGE_TYPE_TRANSPARENT;
+            }
+
+            // Only draw supports below the clipping height.
+            if ((gCurrentViewportFlags & VIEWPORT_FLAG_PAINT_CLIP_TO_HEIGHT) && (segmentHeight > gClipHeight)) continue;
+
+            sint32 xOffset = sy * 10;
+            sint32 yOffset = -22 + sx * 10;
+            paint_struct * ps      = sub_98197C(
+                session, 5504 | imageColourFlats, xOffset, yOffset, 10, 10, 1, segmentHeight, xOffset + 1, yOffset + 16,
+                segmentHeight);
+            if (ps != nullptr) {
+                ps->flags &= PAINT_STRUCT_FLAG_IS_MASKED;
+                ps->colour_image_id = COLOUR_BORDEAUX_RED;
+            }
+
+        }
+    }
+}
+
+/**
+ * Paints the elements of the tile. Returns the last element, or nullptr if the elements after a corrupt one were
+ * skipped.
+ */
+static rct_tile_element * tile_element_paint_elements(paint_session * session, rct_tile_element * tile_element, uint8 rotation)
+{
     session->DidPassSurface = false;
     sint32 previousHeight = 0;
     do {
@@ -325,62 +399,16 @@ static void sub_68B3FB(paint_session * session, sint32 x, sint32 y)
         // A corrupt element inserted by OpenRCT2 itself, which skips the drawing of the next element only.
         case TILE_ELEMENT_TYPE_CORRUPT:
             if (tile_element_is_last_for_tile(tile_element))
-                return;
+                return nullptr;
             tile_element++;
             break;
         default:
             // An undefined map element is most likely a corrupt element inserted by 8 cars' MOM feature to skip drawing of all elements after it.
-            return;
+            return nullptr;
         }
         session->MapPosition = dword_9DE574;
     } while (!tile_element_is_last_for_tile(tile_element++));
-
-#ifndef __TESTPAINT__
-    if (gConfigGeneral.use_virtual_floor && partOfVirtualFloor)
-    {
-        virtual_floor_paint(session);
-    }
-#endif // __TESTPAINT__
-
-    if (!gShowSupportSegmentHeights) {
-        return;
-    }
-
-    if (tile_element_get_type(tile_element - 1) == TILE_ELEMENT_TYPE_SURFACE) {
-        return;
-    }
-
-    static constexpr const sint32 segmentPositions[][3] = {
-        {0, 6, 2},
-        {5, 4, 8},
-        {1, 7, 3},
-    };
-
-    for (sint32 sy = 0; sy < 3; sy++) {
-        for (sint32 sx = 0; sx < 3; sx++) {
-            uint16 segmentHeight = session->SupportSegments[segmentPositions[sy][sx]].height;
-            sint32 imageColourFlats = 0b101111 << 19 | IMAGE_TYPE_TRANSPARENT;
-            if (segmentHeight == 0xFFFF) {
-                segmentHeight = session->Support.height;
-                // white: 0b101101
-                imageColourFlats = 0b111011 << 19 | IMAGE_TYPE_TRANSPARENT;
-            }
-
-            // Only draw supports below the clipping height.
-            if ((gCurrentViewportFlags & VIEWPORT_FLAG_PAINT_CLIP_TO_HEIGHT) && (segmentHeight > gClipHeight)) continue;
-
-            sint32 xOffset = sy * 10;
-            sint32 yOffset = -22 + sx * 10;
-            paint_struct * ps      = sub_98197C(
-                session, 5504 | imageColourFlats, xOffset, yOffset, 10, 10, 1, segmentHeight, xOffset + 1, yOffset + 16,
-                segmentHeight);
-            if (ps != nullptr) {
-                ps->flags &= PAINT_STRUCT_FLAG_IS_MASKED;
-                ps->colour_image_id = COLOUR_BORDEAUX_RED;
-            }
-
-        }
-    }
+    return tile_element - 1;
 }
 
 void paint_util_push_tunnel_left(paint_session * session, uint16 height, uint8 type)
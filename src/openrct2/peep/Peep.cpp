@@ -14,7 +14,11 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "../Context.h"
 #include "../OpenRCT2.h"
@@ -22,6 +26,7 @@
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../config/Config.h"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../core/Util.hpp"
 #include "../Game.h"
@@ -42,6 +47,7 @@
 #include "../world/Climate.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Map.h"
 #include "../world/LargeScenery.h"
 #include "../world/Scenery.h"
@@ -75,20 +81,106 @@ bool          gPeepPathFindIgnoreForeignQueues;
 uint8         gPeepPathFindQueueRideIndex;
 // uint32 gPeepPathFindAltStationNum;
 static bool   _peepPathFindIsStaff;
-static sint8  _peepPathFindNumJunctions;
-static sint8  _peepPathFindMaxJunctions;
-static sint32 _peepPathFindTilesChecked;
-static uint8  _peepPathFindFewestNumSteps;
-
-/* A junction history for the peep pathfinding heuristic search
- * The magic number 16 is the largest value returned by
- * peep_pathfind_get_max_number_junctions() which should eventually
- * be declared properly. */
-static struct
+
+/* The state of a single peep pathfinding heuristic search. This is kept
+ * out of globals so that searches for different peeps can run on
+ * separate threads. */
+struct pathfind_search_context
+{
+    LocationXYZ16 goal;
+    bool          ignoreForeignQueues;
+    uint8         queueRideIndex;
+    bool          isStaff;
+    sint8         numJunctions;
+    sint8         maxJunctions;
+    sint32        tilesChecked;
+
+    /* A junction history for the peep pathfinding heuristic search
+     * The magic number 16 is the largest value returned by
+     * peep_pathfind_get_max_number_junctions() which should eventually
+     * be declared properly. */
+    struct
+    {
+        TileCoordsXYZ location;
+        uint8         direction;
+    } history[16];
+};
+
+// The max number of tiles checked by a single heuristic search
+static constexpr sint32 PEEP_PATHFIND_MAX_TILES_GUEST = 15000;
+static constexpr sint32 PEEP_PATHFIND_MAX_TILES_STAFF = 50000;
+
+/* The results of a guest's heuristic searches computed ahead of the peep
+ * update loop, along with the inputs they were computed from. peep is a
+ * copy of the guest with the pathfind history it will have when it
+ * searches. */
+struct pathfind_speculation
+{
+    rct_peep           peep;
+    rct_tile_element * firstTileElement;
+    sint16             x;
+    sint16             y;
+    uint8              z;
+    LocationXYZ16      goal;
+    uint8              queueRideIndex;
+    sint8              maxJunctions;
+    uint8              edges;
+    uint16             scores[4];
+    uint8              steps[4];
+};
+
+// The fewest guests worth handing over to the job pool
+static constexpr size_t PEEP_PATHFIND_SPECULATION_MIN_GUESTS = 32;
+
+static std::vector<pathfind_speculation>  _pathfindSpeculations;
+static std::unordered_map<uint16, size_t> _pathfindSpeculationIndex;
+
+/* The inputs of the choice of direction at a junction. All fields are
+ * bytes or aligned shorts and the padding is explicit, so keys can be
+ * hashed and compared as plain memory. */
+struct pathfind_cache_key
 {
-    TileCoordsXYZ location;
-    uint8          direction;
-} _peepPathFindHistory[16];
+    uint8       x;
+    uint8       y;
+    uint8       z;
+    uint8       edges;
+    sint16      goalX;
+    sint16      goalY;
+    sint16      goalZ;
+    uint8       queueRideIndex;
+    uint8       flags;
+    sint8       maxJunctions;
+    rct12_xyzd8 history[4];
+    uint8       pad_1D;
+
+    bool operator==(const pathfind_cache_key &other) const
+    {
+        return memcmp(this, &other, sizeof(pathfind_cache_key)) == 0;
+    }
+};
+assert_struct_size(pathfind_cache_key, 30);
+
+struct pathfind_cache_key_hash
+{
+    size_t operator()(const pathfind_cache_key &key) const
+    {
+        // FNV-1a
+        const uint8 * data = (const uint8 *)&key;
+        uint32        hash = 2166136261u;
+        for (size_t i = 0; i < sizeof(pathfind_cache_key); i++)
+        {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+};
+
+// The cache is emptied once it holds this many choices
+static constexpr size_t PEEP_PATHFIND_CACHE_MAX_ENTRIES = 16384;
+
+static std::unordered_map<pathfind_cache_key, sint8, pathfind_cache_key_hash> _pathfindCache;
+static uint32                                                                 _pathfindCacheGeneration;
+static peep_pathfind_cache_stats                                              _pathfindCacheStats;
 
 static uint8             _unk_F1AEF0;
 static uint16            _unk_F1EE18;
@@ -125,6 +217,9 @@ static void * _crowdSoundChannel = nullptr;
 
 static void   sub_68F41A(rct_peep * peep, sint32 index);
 static void   peep_update(rct_peep * peep);
+static uint32 peep_get_steps_to_take(rct_peep * peep);
+static void   peep_pathfind_speculate_all();
+static void   peep_pathfind_clear_speculation();
 static bool   peep_has_empty_container(rct_peep * peep);
 static bool   peep_has_drink(rct_peep * peep);
 static sint32 peep_has_food_standard_flag(rct_peep * peep);
@@ -560,6 +655,8 @@ void peep_update_all()
     if (gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
         return;
 
+    peep_pathfind_speculate_all();
+
     spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP];
     i           = 0;
     while (spriteIndex != SPRITE_INDEX_NULL)
@@ -582,6 +679,8 @@ void peep_update_all()
 
         i++;
     }
+
+    peep_pathfind_clear_speculation();
 }
 
 /**
@@ -617,6 +716,8 @@ static uint8 peep_assess_surroundings(sint16 centre_x, sint16 centre_y, sint16 c
                 switch (tile_element_get_type(tileElement))
                 {
                 case TILE_ELEMENT_TYPE_PATH:
+                    if (tile_element_is_ghost(tileElement))
+                        break;
                     if (!footpath_element_has_path_scenery(tileElement))
                         break;
 
@@ -1231,7 +1332,7 @@ static void sub_68F41A(rct_peep * peep, sint32 index)
                 bool               found       = false;
                 do
                 {
-                    if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
+                    if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || tile_element_is_ghost(tileElement))
                         continue;
                     if (tileElement->base_height != peep->next_z)
                         continue;
@@ -1483,7 +1584,7 @@ static bool checkForPath(rct_peep * peep)
 
     do
     {
-        if (tile_element_get_type(tile_element) == map_type)
+        if (tile_element_get_type(tile_element) == map_type && !tile_element_is_ghost(tile_element))
         {
             if (z == tile_element->base_height)
             {
@@ -1910,7 +2011,7 @@ void peep_update_sprite_type(rct_peep * peep)
             rct_tile_element * tile_element = map_get_first_element_at(x / 32, y / 32);
             while (true)
             {
-                if ((peep->z / 8) < tile_element->base_height)
+                if ((peep->z / 8) < tile_element->base_height && !tile_element_is_ghost(tile_element))
                     break;
 
                 if (tile_element_is_last_for_tile(tile_element))
@@ -2125,7 +2226,7 @@ bool peep_pickup_place(rct_peep * peep, sint32 x, sint32 y, sint32 z, bool apply
 
 bool peep_pickup_command(uint32 peepnum, sint32 x, sint32 y, sint32 z, sint32 action, bool apply)
 {
-    if (peepnum >= MAX_SPRITES)
+    if (peepnum >= sprite_get_capacity())
     {
         log_error("Failed to pick up peep for sprite %d", peepnum);
         return false;
@@ -2296,7 +2397,7 @@ static void peep_update_falling(rct_peep * peep)
         do
         {
             // If a path check if we are on it
-            if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH)
+            if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tile_element))
             {
                 sint32 height = map_height_from_slope(peep->x, peep->y, tile_element->properties.surface.slope) +
                                 tile_element->base_height * 8;
@@ -4374,7 +4475,7 @@ static void peep_update_ride_sub_state_18(rct_peep * peep)
     rct_tile_element * tileElement = map_get_first_element_at(x / 32, y / 32);
     do
     {
-        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
+        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || tile_element_is_ghost(tileElement))
             continue;
 
         sint16 z = map_height_from_slope(peep->x, peep->y, tileElement->properties.path.type);
@@ -5577,7 +5678,7 @@ static void peep_update_emptying_bin(rct_peep * peep)
 
         for (;; tile_element++)
         {
-            if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH)
+            if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tile_element))
             {
                 if (peep->next_z == tile_element->base_height)
                     break;
@@ -5884,7 +5985,7 @@ static sint32 peep_update_walking_find_bench(rct_peep * peep)
 
     for (;; tile_element++)
     {
-        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH)
+        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tile_element))
         {
             if (peep->next_z == tile_element->base_height)
                 break;
@@ -5988,7 +6089,7 @@ static sint32 peep_update_walking_find_bin(rct_peep * peep)
 
     for (;; tile_element++)
     {
-        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH)
+        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tile_element))
         {
             if (peep->next_z == tile_element->base_height)
                 break;
@@ -6093,7 +6194,7 @@ static void peep_update_walking_break_scenery(rct_peep * peep)
 
     for (;; tile_element++)
     {
-        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH)
+        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tile_element))
         {
             if (peep->next_z == tile_element->base_height)
                 break;
@@ -6370,7 +6471,7 @@ static void peep_update_using_bin(rct_peep * peep)
                 continue;
             }
 
-            if (tile_element->base_height == peep->next_z)
+            if (tile_element->base_height == peep->next_z && !tile_element_is_ghost(tile_element))
                 break;
 
             if (tile_element_is_last_for_tile(tile_element))
@@ -6837,7 +6938,8 @@ static sint32 peep_update_patrolling_find_bin(rct_peep * peep)
     for (;; tile_element++)
     {
 
-        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && (tile_element->base_height == peep->next_z))
+        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && (tile_element->base_height == peep->next_z) &&
+            !tile_element_is_ghost(tile_element))
             break;
 
         if (tile_element_is_last_for_tile(tile_element))
@@ -7229,7 +7331,7 @@ static void peep_update_walking(rct_peep * peep)
 
     for (;; tile_element++)
     {
-        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH)
+        if (tile_element_get_type(tile_element) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tile_element))
         {
             if (peep->next_z == tile_element->base_height)
                 break;
@@ -7391,18 +7493,11 @@ static void peep_update_thoughts(rct_peep * peep)
  *
  *  rct2: 0x0068FC1E
  */
-static void peep_update(rct_peep * peep)
+/**
+ * Walking speed logic
+ */
+static uint32 peep_get_steps_to_take(rct_peep * peep)
 {
-    if (peep->type == PEEP_TYPE_GUEST)
-    {
-        if (peep->previous_ride != 255)
-            if (++peep->previous_ride_time_out >= 720)
-                peep->previous_ride = 255;
-
-        peep_update_thoughts(peep);
-    }
-
-    // Walking speed logic
     uint32 stepsToTake = peep->energy;
     if (stepsToTake < 95 && peep->state == PEEP_STATE_QUEUING)
         stepsToTake = 95;
@@ -7414,9 +7509,23 @@ static void peep_update(rct_peep * peep)
         if (peep->state == PEEP_STATE_QUEUING)
             stepsToTake += stepsToTake / 2;
     }
+    return stepsToTake;
+}
 
-    uint32 carryCheck = peep->var_73 + stepsToTake;
-    peep->var_73      = carryCheck;
+static void peep_update(rct_peep * peep)
+{
+    if (peep->type == PEEP_TYPE_GUEST)
+    {
+        if (peep->previous_ride != 255)
+            if (++peep->previous_ride_time_out >= 720)
+                peep->previous_ride = 255;
+
+        peep_update_thoughts(peep);
+    }
+
+    uint32 stepsToTake = peep_get_steps_to_take(peep);
+    uint32 carryCheck  = peep->var_73 + stepsToTake;
+    peep->var_73       = carryCheck;
     if (carryCheck <= 255)
     {
         peep_easter_egg_peep_interactions(peep);
@@ -7897,7 +8006,7 @@ static constexpr const uint8 tshirt_colours[] = {
  */
 rct_peep * peep_generate(sint32 x, sint32 y, sint32 z)
 {
-    if (gSpriteListCount[SPRITE_LIST_NULL] < 400)
+    if (sprite_get_free_count() < 400)
         return nullptr;
 
     rct_peep * peep = (rct_peep *)create_sprite(1);
@@ -8940,7 +9049,7 @@ static sint32 peep_interact_with_entrance(rct_peep * peep, sint16 x, sint16 y, r
         rct_tile_element * nextTileElement = map_get_first_element_at(next_x / 32, next_y / 32);
         do
         {
-            if (tile_element_get_type(nextTileElement) != TILE_ELEMENT_TYPE_PATH)
+            if (tile_element_get_type(nextTileElement) != TILE_ELEMENT_TYPE_PATH || tile_element_is_ghost(nextTileElement))
                 continue;
 
             if (footpath_element_is_queue(nextTileElement))
@@ -9505,7 +9614,7 @@ static rct_tile_element * get_banner_on_path(rct_tile_element * path_element)
     do
     {
         // Path on top, so no banners
-        if (tile_element_get_type(bannerElement) == TILE_ELEMENT_TYPE_PATH)
+        if (tile_element_get_type(bannerElement) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(bannerElement))
             return nullptr;
         // Found a banner
         if (tile_element_get_type(bannerElement) == TILE_ELEMENT_TYPE_BANNER)
@@ -9519,9 +9628,9 @@ static rct_tile_element * get_banner_on_path(rct_tile_element * path_element)
     return nullptr;
 }
 
-static sint32 banner_clear_path_edges(rct_tile_element * tileElement, sint32 edges)
+static sint32 banner_clear_path_edges(bool ignoreBanners, rct_tile_element * tileElement, sint32 edges)
 {
-    if (_peepPathFindIsStaff)
+    if (ignoreBanners)
         return edges;
     rct_tile_element * bannerElement = get_banner_on_path(tileElement);
     if (bannerElement != nullptr)
@@ -9537,9 +9646,9 @@ static sint32 banner_clear_path_edges(rct_tile_element * tileElement, sint32 edg
 /**
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
-static sint32 path_get_permitted_edges(rct_tile_element * tileElement)
+static sint32 path_get_permitted_edges(bool ignoreBanners, rct_tile_element * tileElement)
 {
-    return banner_clear_path_edges(tileElement, tileElement->properties.path.edges) & 0x0F;
+    return banner_clear_path_edges(ignoreBanners, tileElement, tileElement->properties.path.edges) & 0x0F;
 }
 
 bool is_valid_path_z_and_direction(rct_tile_element * tileElement, sint32 currentZ, sint32 currentDirection)
@@ -9703,7 +9812,7 @@ static uint8 footpath_element_dest_in_dir(sint16 x, sint16 y, sint16 z, rct_tile
             if (footpath_element_is_wide(tileElement))
                 return PATH_SEARCH_WIDE;
 
-            uint8 edges = path_get_permitted_edges(tileElement);
+            uint8 edges = path_get_permitted_edges(_peepPathFindIsStaff, tileElement);
             edges &= ~(1 << (chosenDirection ^ 2));
             z = tileElement->base_height;
 
@@ -9913,20 +10022,20 @@ static bool path_is_thin_junction(rct_tile_element * path, sint16 x, sint16 y, u
  *
  * The parameters/variables that limit the search space are:
  *   - counter (param) - number of steps walked in the current search path;
- *   - _peepPathFindTilesChecked (variable) - cumulative number of tiles that can be
+ *   - ctx->tilesChecked - cumulative number of tiles that can be
  *     checked in the entire search;
- *   - _peepPathFindNumJunctions (variable) - number of thin junctions that can be
+ *   - ctx->numJunctions - number of thin junctions that can be
  *     checked in a single search path;
  *
- * Other global variables/state that affect the search space are:
+ * Other variables/state that affect the search space are:
  *   - Wide paths - to handle broad paths (> 1 tile wide), the search navigates
  *     along non-wide (or 'thin' paths) and stops as soon as it encounters a
  *     wide path. This means peeps heading for a destination will only leave
  *     thin paths if walking 1 tile onto a wide path is closer than following
  *     non-wide paths;
- *   - gPeepPathFindIgnoreForeignQueues
- *   - gPeepPathFindQueueRideIndex - the ride the peep is heading for
- *   - _peepPathFindHistory - the search path telemetry consisting of the
+ *   - ctx->ignoreForeignQueues
+ *   - ctx->queueRideIndex - the ride the peep is heading for
+ *   - ctx->history - the search path telemetry consisting of the
  *     starting point and all thin junctions with directions navigated
  *     in the current search path - also used to detect path loops.
  *
@@ -9943,10 +10052,11 @@ static bool path_is_thin_junction(rct_tile_element * path, sint16 x, sint16 y, u
  *
  *  rct2: 0x0069A997
  */
-static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep * peep, rct_tile_element * currentTileElement,
-                                           bool inPatrolArea, uint8 counter, uint16 * endScore, sint32 test_edge,
-                                           uint8 * endJunctions, TileCoordsXYZ junctionList[16], uint8 directionList[16],
-                                           TileCoordsXYZ * endXYZ, uint8 * endSteps)
+static void peep_pathfind_heuristic_search(pathfind_search_context * ctx, sint16 x, sint16 y, uint8 z, rct_peep * peep,
+                                           rct_tile_element * currentTileElement, bool inPatrolArea, uint8 counter,
+                                           uint16 * endScore, sint32 test_edge, uint8 * endJunctions,
+                                           TileCoordsXYZ junctionList[16], uint8 directionList[16], TileCoordsXYZ * endXYZ,
+                                           uint8 * endSteps)
 {
     uint8 searchResult = PATH_SEARCH_FAILED;
 
@@ -9957,13 +10067,13 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
     y += TileDirectionDelta[test_edge].y;
 
     ++counter;
-    _peepPathFindTilesChecked--;
+    ctx->tilesChecked--;
 
     /* If this is where the search started this is a search loop and the
      * current search path ends here.
      * Return without updating the parameters (best result so far). */
-    if ((_peepPathFindHistory[0].location.x == (uint8)(x >> 5)) && (_peepPathFindHistory[0].location.y == (uint8)(y >> 5)) &&
-        (_peepPathFindHistory[0].location.z == z))
+    if ((ctx->history[0].location.x == (uint8)(x >> 5)) && (ctx->history[0].location.y == (uint8)(y >> 5)) &&
+        (ctx->history[0].location.z == z))
     {
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
         if (gPathFindDebug)
@@ -10113,9 +10223,9 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
             else
             { // numEdges == 2
                 if (footpath_element_is_queue(tileElement) &&
-                    tileElement->properties.path.ride_index != gPeepPathFindQueueRideIndex)
+                    tileElement->properties.path.ride_index != ctx->queueRideIndex)
                 {
-                    if (gPeepPathFindIgnoreForeignQueues && (tileElement->properties.path.ride_index != 0xFF))
+                    if (ctx->ignoreForeignQueues && (tileElement->properties.path.ride_index != 0xFF))
                     {
                         // Path is a queue we aren't interested in
                         /* The rideIndex will be useful for
@@ -10149,14 +10259,14 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
          * Ignore for now. */
 
         // Calculate the heuristic score of this map element.
-        uint16 x_delta = abs(gPeepPathFindGoalPosition.x - x);
-        uint16 y_delta = abs(gPeepPathFindGoalPosition.y - y);
+        uint16 x_delta = abs(ctx->goal.x - x);
+        uint16 y_delta = abs(ctx->goal.y - y);
         if (x_delta < y_delta)
             x_delta >>= 4;
         else
             y_delta >>= 4;
         uint16 new_score = x_delta + y_delta;
-        uint16 z_delta   = abs(gPeepPathFindGoalPosition.z - z);
+        uint16 z_delta   = abs(ctx->goal.z - z);
         z_delta <<= 1;
         new_score += z_delta;
 
@@ -10175,14 +10285,14 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
                 endXYZ->y = y >> 5;
                 endXYZ->z = z;
                 // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                *endJunctions = ctx->maxJunctions - ctx->numJunctions;
                 for (uint8 junctInd = 0; junctInd < *endJunctions; junctInd++)
                 {
-                    uint8 histIdx            = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd]  = _peepPathFindHistory[histIdx].direction;
+                    uint8 histIdx            = ctx->maxJunctions - junctInd;
+                    junctionList[junctInd].x = ctx->history[histIdx].location.x;
+                    junctionList[junctInd].y = ctx->history[histIdx].location.y;
+                    junctionList[junctInd].z = ctx->history[histIdx].location.z;
+                    directionList[junctInd]  = ctx->history[histIdx].direction;
                 }
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -10235,14 +10345,14 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
                 endXYZ->y = y >> 5;
                 endXYZ->z = z;
                 // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                *endJunctions = ctx->maxJunctions - ctx->numJunctions;
                 for (uint8 junctInd = 0; junctInd < *endJunctions; junctInd++)
                 {
-                    uint8 histIdx            = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd]  = _peepPathFindHistory[histIdx].direction;
+                    uint8 histIdx            = ctx->maxJunctions - junctInd;
+                    junctionList[junctInd].x = ctx->history[histIdx].location.x;
+                    junctionList[junctInd].y = ctx->history[histIdx].location.y;
+                    junctionList[junctInd].z = ctx->history[histIdx].location.z;
+                    directionList[junctInd]  = ctx->history[histIdx].direction;
                 }
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -10257,7 +10367,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
         /* At this point the map element is a non-wide path.*/
 
         /* Get all the permitted_edges of the map element. */
-        uint8 edges = path_get_permitted_edges(tileElement);
+        uint8 edges = path_get_permitted_edges(ctx->isStaff, tileElement);
 
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
         if (gPathFindDebug)
@@ -10287,7 +10397,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 
         /* Check if either of the search limits has been reached:
          * - max number of steps or max tiles checked. */
-        if (counter >= 200 || _peepPathFindTilesChecked <= 0)
+        if (counter >= 200 || ctx->tilesChecked <= 0)
         {
             /* The current search ends here.
              * The path continues, so the goal could still be reachable from here.
@@ -10303,14 +10413,14 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
                 endXYZ->y = y >> 5;
                 endXYZ->z = z;
                 // Update the telemetry
-                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                *endJunctions = ctx->maxJunctions - ctx->numJunctions;
                 for (uint8 junctInd = 0; junctInd < *endJunctions; junctInd++)
                 {
-                    uint8 histIdx            = _peepPathFindMaxJunctions - junctInd;
-                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                    directionList[junctInd]  = _peepPathFindHistory[histIdx].direction;
+                    uint8 histIdx            = ctx->maxJunctions - junctInd;
+                    junctionList[junctInd].x = ctx->history[histIdx].location.x;
+                    junctionList[junctInd].y = ctx->history[histIdx].location.y;
+                    junctionList[junctInd].z = ctx->history[histIdx].location.z;
+                    directionList[junctInd]  = ctx->history[histIdx].direction;
                 }
             }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -10342,7 +10452,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
                  * peep->pathfind_history - loops through remembered junctions
                  *     the peep has already passed through getting to its
                  *     current position while on the way to its current goal;
-                 * _peepPathFindHistory - loops in the current search path. */
+                 * ctx->history - loops in the current search path. */
                 bool pathLoop = false;
                 /* Check the peep->pathfind_history to see if this junction has
                  * already been visited by the peep while heading for this goal. */
@@ -10370,15 +10480,15 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 
                 if (!pathLoop)
                 {
-                    /* Check the _peepPathFindHistory to see if this junction has been
+                    /* Check the ctx->history to see if this junction has been
                      * previously passed through in the current search path.
                      * i.e. this is a loop in the current search path. */
-                    for (sint32 junctionNum = _peepPathFindNumJunctions + 1; junctionNum <= _peepPathFindMaxJunctions;
+                    for (sint32 junctionNum = ctx->numJunctions + 1; junctionNum <= ctx->maxJunctions;
                          junctionNum++)
                     {
-                        if ((_peepPathFindHistory[junctionNum].location.x == (uint8)(x >> 5)) &&
-                            (_peepPathFindHistory[junctionNum].location.y == (uint8)(y >> 5)) &&
-                            (_peepPathFindHistory[junctionNum].location.z == z))
+                        if ((ctx->history[junctionNum].location.x == (uint8)(x >> 5)) &&
+                            (ctx->history[junctionNum].location.y == (uint8)(y >> 5)) &&
+                            (ctx->history[junctionNum].location.z == z))
                         {
                             pathLoop = true;
                             break;
@@ -10403,7 +10513,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
                  * be reachable from here.
                  * If the search result is better than the best so far (in the parameters),
                  * then update the parameters with this search before continuing to the next map element. */
-                if (_peepPathFindNumJunctions <= 0)
+                if (ctx->numJunctions <= 0)
                 {
                     if (new_score < *endScore || (new_score == *endScore && counter < *endSteps))
                     {
@@ -10415,14 +10525,14 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
                         endXYZ->y = y >> 5;
                         endXYZ->z = z;
                         // Update the telemetry
-                        *endJunctions = _peepPathFindMaxJunctions; // - _peepPathFindNumJunctions;
+                        *endJunctions = ctx->maxJunctions; // - ctx->numJunctions;
                         for (uint8 junctInd = 0; junctInd < *endJunctions; junctInd++)
                         {
-                            uint8 histIdx            = _peepPathFindMaxJunctions - junctInd;
-                            junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
-                            junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
-                            junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
-                            directionList[junctInd]  = _peepPathFindHistory[histIdx].direction;
+                            uint8 histIdx            = ctx->maxJunctions - junctInd;
+                            junctionList[junctInd].x = ctx->history[histIdx].location.x;
+                            junctionList[junctInd].y = ctx->history[histIdx].location.y;
+                            junctionList[junctInd].z = ctx->history[histIdx].location.z;
+                            directionList[junctInd]  = ctx->history[histIdx].direction;
                         }
                     }
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
@@ -10437,12 +10547,12 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 
                 /* This junction was NOT previously visited in the current
                  * search path, so add the junction to the history. */
-                _peepPathFindHistory[_peepPathFindNumJunctions].location.x = (uint8)(x >> 5);
-                _peepPathFindHistory[_peepPathFindNumJunctions].location.y = (uint8)(y >> 5);
-                _peepPathFindHistory[_peepPathFindNumJunctions].location.z = z;
+                ctx->history[ctx->numJunctions].location.x = (uint8)(x >> 5);
+                ctx->history[ctx->numJunctions].location.y = (uint8)(y >> 5);
+                ctx->history[ctx->numJunctions].location.z = z;
                 // .direction take is added below.
 
-                _peepPathFindNumJunctions--;
+                ctx->numJunctions--;
             }
         }
 
@@ -10451,7 +10561,7 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
         do
         {
             edges &= ~(1 << next_test_edge);
-            uint8 savedNumJunctions = _peepPathFindNumJunctions;
+            uint8 savedNumJunctions = ctx->numJunctions;
 
             uint8 height = z;
             if (footpath_element_is_sloped(tileElement) && footpath_element_get_slope_direction(tileElement) == next_test_edge)
@@ -10480,12 +10590,12 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
             if (thin_junction)
             {
                 /* Add the current test_edge to the history. */
-                _peepPathFindHistory[_peepPathFindNumJunctions + 1].direction = next_test_edge;
+                ctx->history[ctx->numJunctions + 1].direction = next_test_edge;
             }
 
-            peep_pathfind_heuristic_search(x, y, height, peep, tileElement, nextInPatrolArea, counter, endScore, next_test_edge,
-                                           endJunctions, junctionList, directionList, endXYZ, endSteps);
-            _peepPathFindNumJunctions = savedNumJunctions;
+            peep_pathfind_heuristic_search(ctx, x, y, height, peep, tileElement, nextInPatrolArea, counter, endScore,
+                                           next_test_edge, endJunctions, junctionList, directionList, endXYZ, endSteps);
+            ctx->numJunctions = savedNumJunctions;
 
 #if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
             if (gPathFindDebug)
@@ -10521,35 +10631,14 @@ static void peep_pathfind_heuristic_search(sint16 x, sint16 y, uint8 z, rct_peep
 }
 
 /**
- * Returns:
- *   -1   - no direction chosen
- *   0..3 - chosen direction
- *
- *  rct2: 0x0069A5F0
+ * Collects the edges a peep at x, y, z can still try for the given goal,
+ * updating peep->pathfind_goal and peep->pathfind_history on the way.
+ * Returns false if the peep is not on a path.
  */
-sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * peep)
+static bool peep_pathfind_get_edges(sint16 x, sint16 y, uint8 z, rct_peep * peep, TileCoordsXYZ goal, bool isStaff,
+                                    rct_tile_element ** outFirstTileElement, uint8 * outPermittedEdges, uint8 * outEdges,
+                                    bool * outIsThin)
 {
-    // The max number of thin junctions searched - a per-search-path limit.
-    _peepPathFindMaxJunctions = peep_pathfind_get_max_number_junctions(peep);
-
-    /* The max number of tiles to check - a whole-search limit.
-     * Mainly to limit the performance impact of the path finding. */
-    sint32 maxTilesChecked = (peep->type == PEEP_TYPE_STAFF) ? 50000 : 15000;
-    // Used to allow walking through no entry banners
-    _peepPathFindIsStaff = (peep->type == PEEP_TYPE_STAFF);
-
-    TileCoordsXYZ goal = { (uint8)(gPeepPathFindGoalPosition.x >> 5),
-                      (uint8)(gPeepPathFindGoalPosition.y >> 5),
-                      (uint8)(gPeepPathFindGoalPosition.z) };
-
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-    if (gPathFindDebug)
-    {
-        log_verbose("Choose direction for %s for goal %d,%d,%d from %d,%d,%d", gPathFindDebugPeepName, goal.x, goal.y, goal.z,
-                    x >> 5, y >> 5, z);
-    }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-
     // Get the path element at this location
     rct_tile_element * dest_tile_element = map_get_first_element_at(x / 32, y / 32);
     /* Where there are multiple matching map elements placed with zero
@@ -10578,6 +10667,8 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * pe
             continue;
         if (tile_element_get_type(dest_tile_element) != TILE_ELEMENT_TYPE_PATH)
             continue;
+        if (tile_element_is_ghost(dest_tile_element))
+            continue;
         found = true;
         if (first_tile_element == nullptr)
         {
@@ -10593,11 +10684,11 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * pe
         isThin = isThin || path_is_thin_junction(dest_tile_element, x, y, z);
 
         // Collect the permitted edges of ALL matching path elements at this location.
-        permitted_edges |= path_get_permitted_edges(dest_tile_element);
+        permitted_edges |= path_get_permitted_edges(isStaff, dest_tile_element);
     } while (!tile_element_is_last_for_tile(dest_tile_element++));
     // Peep is not on a path.
     if (!found)
-        return -1;
+        return false;
 
     permitted_edges &= 0xF;
     uint8 edges = permitted_edges;
@@ -10688,163 +10779,405 @@ sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * pe
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     }
 
-    // Peep has tried all edges.
-    if (edges == 0)
-        return -1;
+    *outFirstTileElement = first_tile_element;
+    *outPermittedEdges   = permitted_edges;
+    *outEdges            = edges;
+    *outIsThin           = isThin;
+    return true;
+}
 
-    sint32 chosen_edge = bitscanforward(edges);
+/**
+ * Runs the heuristic search along a single edge leaving x, y, z.
+ */
+static void peep_pathfind_search_edge(pathfind_search_context * ctx, sint16 x, sint16 y, uint8 z, rct_peep * peep,
+                                      rct_tile_element * firstTileElement, sint32 test_edge, sint32 tilesChecked,
+                                      uint16 * endScore, uint8 * endJunctions, TileCoordsXYZ junctionList[16],
+                                      uint8 directionList[16], TileCoordsXYZ * endXYZ, uint8 * endSteps)
+{
+    uint8 height = z;
 
-    // Peep has multiple edges still to try.
-    if (edges & ~(1 << chosen_edge))
+    if (footpath_element_is_sloped(firstTileElement) && footpath_element_get_slope_direction(firstTileElement) == test_edge)
     {
-        uint16 best_score = 0xFFFF;
-        uint8  best_sub   = 0xFF;
+        height += 0x2;
+    }
+
+    ctx->tilesChecked = tilesChecked;
+    ctx->numJunctions = ctx->maxJunctions;
+
+    // Initialise the search history.
+    memset(ctx->history, 0xFF, sizeof(ctx->history));
+
+    /* The pathfinding will only use elements
+     * 1..ctx->maxJunctions, so the starting point
+     * is placed in element 0 */
+    ctx->history[0].location.x = (uint8)(x >> 5);
+    ctx->history[0].location.y = (uint8)(y >> 5);
+    ctx->history[0].location.z = z;
+    ctx->history[0].direction  = 0xF;
+
+    bool inPatrolArea = false;
+    if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
+    {
+        /* Mechanics are the only staff type that
+         * pathfind to a destination. Determine if the
+         * mechanic is in their patrol area. */
+        inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
+    }
+
+#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+    if (gPathFindDebug)
+    {
+        log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
+    }
+#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+
+    peep_pathfind_heuristic_search(ctx, x, y, height, peep, firstTileElement, inPatrolArea, 0, endScore, test_edge,
+                                   endJunctions, junctionList, directionList, endXYZ, endSteps);
+}
+
+/**
+ * Returns the results of the heuristic searches computed ahead of the peep
+ * update loop by peep_pathfind_speculate_all(), if they were computed from
+ * exactly the inputs of the search about to be made.
+ */
+static const pathfind_speculation * peep_pathfind_get_speculation(const pathfind_search_context * ctx, sint16 x, sint16 y,
+                                                                  uint8 z, rct_peep * peep, uint8 edges)
+{
+    if (_pathfindSpeculationIndex.empty() || peep->type != PEEP_TYPE_GUEST)
+        return nullptr;
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-        uint8          bestJunctions         = 0;
-        TileCoordsXYZ bestJunctionList[16]  = { 0 };
-        uint8          bestDirectionList[16] = { 0 };
-        TileCoordsXYZ bestXYZ               = { 0, 0, 0 };
+    // Let the search run again so it can be logged
+    if (gPathFindDebug)
+        return nullptr;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
+    auto it = _pathfindSpeculationIndex.find(peep->sprite_index);
+    if (it == _pathfindSpeculationIndex.end())
+        return nullptr;
+
+    const pathfind_speculation * speculation = &_pathfindSpeculations[it->second];
+    if (speculation->x != x || speculation->y != y || speculation->z != z || speculation->edges != edges)
+        return nullptr;
+    if (speculation->goal.x != ctx->goal.x || speculation->goal.y != ctx->goal.y || speculation->goal.z != ctx->goal.z)
+        return nullptr;
+    if (!ctx->ignoreForeignQueues || ctx->isStaff || speculation->queueRideIndex != ctx->queueRideIndex ||
+        speculation->maxJunctions != ctx->maxJunctions)
+        return nullptr;
+    if (memcmp(speculation->peep.pathfind_history, peep->pathfind_history, sizeof(peep->pathfind_history)) != 0)
+        return nullptr;
+
+    return speculation;
+}
+
+/**
+ * Chooses the edge that starts the shortest walk to the goal through the footpath graph. Returns -1 if the goal can
+ * not be reached, leaving the choice to the heuristic search which gets the peep as close to it as it can.
+ */
+static sint32 peep_pathfind_graph_choose_edge(const pathfind_search_context * ctx, sint16 x, sint16 y, uint8 z,
+                                              rct_peep * peep, uint8 edges)
+{
+    // The graph knows nothing about patrol areas
+    if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC && (gStaffModes[peep->staff_id] & 2))
+        return -1;
+
+    footpath_graph_query query;
+    query.goal                = ctx->goal;
+    query.queueRideIndex      = ctx->queueRideIndex;
+    query.ignoreForeignQueues = ctx->ignoreForeignQueues;
+    query.ignoreBanners       = ctx->isStaff;
+    return footpath_graph_choose_direction(x, y, z, edges, &query);
+}
+
+/**
+ * Chooses which of the edges left to try at a junction leads towards the goal,
+ * through the footpath graph or otherwise the heuristic search.
+ * Returns -1 if neither finds a way.
+ */
+static sint32 peep_pathfind_choose_junction_edge(pathfind_search_context * ctx, sint16 x, sint16 y, uint8 z, rct_peep * peep,
+                                                 rct_tile_element * firstTileElement, uint8 edges, TileCoordsXYZ goal)
+{
+    sint32 chosen_edge = peep_pathfind_graph_choose_edge(ctx, x, y, z, peep, edges);
+    if (chosen_edge != -1)
+    {
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
         if (gPathFindDebug)
         {
-            log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, x >> 5, y >> 5, z);
+            log_verbose("Footpath graph chose edge %d", chosen_edge);
         }
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        return chosen_edge;
+    }
 
-        /* Call the search heuristic on each edge, keeping track of the
-         * edge that gives the best (i.e. smallest) value (best_score)
-         * or for different edges with equal value, the edge with the
-         * least steps (best_sub). */
-        sint32 numEdges = bitcount(edges);
-        for (sint32 test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
-        {
-            edges &= ~(1 << test_edge);
-            uint8 height = z;
-
-            if (footpath_element_is_sloped(first_tile_element) &&
-                footpath_element_get_slope_direction(first_tile_element) == test_edge)
-            {
-                height += 0x2;
-            }
+    chosen_edge = bitscanforward(edges);
 
-            _peepPathFindFewestNumSteps = 255;
-            /* Divide the maxTilesChecked global search limit
-             * between the remaining edges to ensure the search
-             * covers all of the remaining edges. */
-            _peepPathFindTilesChecked = maxTilesChecked / numEdges;
-            _peepPathFindNumJunctions = _peepPathFindMaxJunctions;
+    /* The max number of tiles to check - a whole-search limit.
+     * Mainly to limit the performance impact of the path finding. */
+    sint32 maxTilesChecked = ctx->isStaff ? PEEP_PATHFIND_MAX_TILES_STAFF : PEEP_PATHFIND_MAX_TILES_GUEST;
 
-            // Initialise _peepPathFindHistory.
-            memset(_peepPathFindHistory, 0xFF, sizeof(_peepPathFindHistory));
+    uint16 best_score = 0xFFFF;
+    uint8  best_sub   = 0xFF;
 
-            /* The pathfinding will only use elements
-             * 1.._peepPathFindMaxJunctions, so the starting point
-             * is placed in element 0 */
-            _peepPathFindHistory[0].location.x = (uint8)(x >> 5);
-            _peepPathFindHistory[0].location.y = (uint8)(y >> 5);
-            _peepPathFindHistory[0].location.z = z;
-            _peepPathFindHistory[0].direction  = 0xF;
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    uint8          bestJunctions         = 0;
+    TileCoordsXYZ bestJunctionList[16]  = { 0 };
+    uint8          bestDirectionList[16] = { 0 };
+    TileCoordsXYZ bestXYZ               = { 0, 0, 0 };
 
-            uint16 score = 0xFFFF;
-            /* Variable endXYZ contains the end location of the
-             * search path. */
-            TileCoordsXYZ endXYZ;
-            endXYZ.x = 0;
-            endXYZ.y = 0;
-            endXYZ.z = 0;
+    if (gPathFindDebug)
+    {
+        log_verbose("Pathfind start for goal %d,%d,%d from %d,%d,%d", goal.x, goal.y, goal.z, x >> 5, y >> 5, z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-            uint8 endSteps = 255;
+    /* Call the search heuristic on each edge, keeping track of the
+     * edge that gives the best (i.e. smallest) value (best_score)
+     * or for different edges with equal value, the edge with the
+     * least steps (best_sub). */
+    const pathfind_speculation * speculation = peep_pathfind_get_speculation(ctx, x, y, z, peep, edges);
+    /* Divide the maxTilesChecked global search limit
+     * between the remaining edges to ensure the search
+     * covers all of the remaining edges. */
+    sint32 tilesChecked = maxTilesChecked / bitcount(edges);
+    for (sint32 test_edge = chosen_edge; test_edge != -1; test_edge = bitscanforward(edges))
+    {
+        edges &= ~(1 << test_edge);
 
-            /* Variable endJunctions is the number of junctions
-             * passed through in the search path.
-             * Variables endJunctionList and endDirectionList
-             * contain the junctions and corresponding directions
-             * of the search path.
-             * In the future these could be used to visualise the
-             * pathfinding on the map. */
-            uint8          endJunctions         = 0;
-            TileCoordsXYZ endJunctionList[16]  = { 0 };
-            uint8          endDirectionList[16] = { 0 };
+        uint16 score = 0xFFFF;
+        /* Variable endXYZ contains the end location of the
+         * search path. */
+        TileCoordsXYZ endXYZ;
+        endXYZ.x = 0;
+        endXYZ.y = 0;
+        endXYZ.z = 0;
 
-            bool inPatrolArea = false;
-            if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC)
-            {
-                /* Mechanics are the only staff type that
-                 * pathfind to a destination. Determine if the
-                 * mechanic is in their patrol area. */
-                inPatrolArea = staff_is_location_in_patrol(peep, peep->next_x, peep->next_y);
-            }
+        uint8 endSteps = 255;
 
-#if defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind searching in direction: %d from %d,%d,%d", test_edge, x >> 5, y >> 5, z);
-            }
-#endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
+        /* Variable endJunctions is the number of junctions
+         * passed through in the search path.
+         * Variables endJunctionList and endDirectionList
+         * contain the junctions and corresponding directions
+         * of the search path.
+         * In the future these could be used to visualise the
+         * pathfinding on the map. */
+        uint8          endJunctions         = 0;
+        TileCoordsXYZ endJunctionList[16]  = { 0 };
+        uint8          endDirectionList[16] = { 0 };
 
-            peep_pathfind_heuristic_search(x, y, height, peep, first_tile_element, inPatrolArea, 0, &score, test_edge,
-                                           &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+        if (speculation != nullptr)
+        {
+            score    = speculation->scores[test_edge];
+            endSteps = speculation->steps[test_edge];
+        }
+        else
+        {
+            peep_pathfind_search_edge(ctx, x, y, z, peep, firstTileElement, test_edge, tilesChecked, &score,
+                                      &endJunctions, endJunctionList, endDirectionList, &endXYZ, &endSteps);
+        }
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (gPathFindDebug)
-            {
-                log_verbose("Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score,
-                            endSteps, endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
-                for (uint8 listIdx = 0; listIdx < endJunctions; listIdx++)
-                {
-                    log_info("Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
-                             endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
-                }
-            }
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-
-            if (score < best_score || (score == best_score && endSteps < best_sub))
+        if (gPathFindDebug)
+        {
+            log_verbose("Pathfind test edge: %d score: %d steps: %d end: %d,%d,%d junctions: %d", test_edge, score,
+                        endSteps, endXYZ.x, endXYZ.y, endXYZ.z, endJunctions);
+            for (uint8 listIdx = 0; listIdx < endJunctions; listIdx++)
             {
-                chosen_edge = test_edge;
-                best_score  = score;
-                best_sub    = endSteps;
-#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-                bestJunctions = endJunctions;
-                for (uint8 index = 0; index < endJunctions; index++)
-                {
-                    bestJunctionList[index].x = endJunctionList[index].x;
-                    bestJunctionList[index].y = endJunctionList[index].y;
-                    bestJunctionList[index].z = endJunctionList[index].z;
-                    bestDirectionList[index]  = endDirectionList[index];
-                }
-                bestXYZ.x = endXYZ.x;
-                bestXYZ.y = endXYZ.y;
-                bestXYZ.z = endXYZ.z;
-#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+                log_info("Junction#%d %d,%d,%d Direction %d", listIdx + 1, endJunctionList[listIdx].x,
+                         endJunctionList[listIdx].y, endJunctionList[listIdx].z, endDirectionList[listIdx]);
             }
         }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-        /* Check if the heuristic search failed. e.g. all connected
-         * paths are within the search limits and none reaches the
-         * goal. */
-        if (best_score == 0xFFFF)
+        if (score < best_score || (score == best_score && endSteps < best_sub))
         {
+            chosen_edge = test_edge;
+            best_score  = score;
+            best_sub    = endSteps;
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            if (gPathFindDebug)
+            bestJunctions = endJunctions;
+            for (uint8 index = 0; index < endJunctions; index++)
             {
-                log_verbose("Pathfind heuristic search failed.");
+                bestJunctionList[index].x = endJunctionList[index].x;
+                bestJunctionList[index].y = endJunctionList[index].y;
+                bestJunctionList[index].z = endJunctionList[index].z;
+                bestDirectionList[index]  = endDirectionList[index];
             }
+            bestXYZ.x = endXYZ.x;
+            bestXYZ.y = endXYZ.y;
+            bestXYZ.z = endXYZ.z;
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
-            return -1;
         }
+    }
+
+    /* Check if the heuristic search failed. e.g. all connected
+     * paths are within the search limits and none reaches the
+     * goal. */
+    if (best_score == 0xFFFF)
+    {
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
         if (gPathFindDebug)
         {
-            log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
-            for (uint8 listIdx = 0; listIdx < bestJunctions; listIdx++)
-            {
-                log_verbose("Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x,
-                            bestJunctionList[listIdx].y, bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
-            }
-            log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
+            log_verbose("Pathfind heuristic search failed.");
         }
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+        return -1;
+    }
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (gPathFindDebug)
+    {
+        log_verbose("Pathfind best edge %d with score %d steps %d", chosen_edge, best_score, best_sub);
+        for (uint8 listIdx = 0; listIdx < bestJunctions; listIdx++)
+        {
+            log_verbose("Junction#%d %d,%d,%d Direction %d", listIdx + 1, bestJunctionList[listIdx].x,
+                        bestJunctionList[listIdx].y, bestJunctionList[listIdx].z, bestDirectionList[listIdx]);
+        }
+        log_verbose("End at %d,%d,%d", bestXYZ.x, bestXYZ.y, bestXYZ.z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    return chosen_edge;
+}
+
+/**
+ * Builds the key of a junction choice in the pathfinding cache from every
+ * input the choice depends on besides the map. Returns false for searches
+ * that also depend on where the peep is standing.
+ */
+static bool peep_pathfind_make_cache_key(const pathfind_search_context * ctx, sint16 x, sint16 y, uint8 z,
+                                         const rct_peep * peep, uint8 edges, pathfind_cache_key * outKey)
+{
+    // Mechanics keeping to a patrol area stop searching where it ends
+    if (peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC && (gStaffModes[peep->staff_id] & 2))
+        return false;
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    // Let the search run again so it can be logged
+    if (gPathFindDebug)
+        return false;
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    memset(outKey, 0, sizeof(pathfind_cache_key));
+    outKey->x              = (uint8)(x >> 5);
+    outKey->y              = (uint8)(y >> 5);
+    outKey->z              = z;
+    outKey->edges          = edges;
+    outKey->goalX          = ctx->goal.x;
+    outKey->goalY          = ctx->goal.y;
+    outKey->goalZ          = ctx->goal.z;
+    outKey->queueRideIndex = ctx->queueRideIndex;
+    outKey->flags          = (ctx->ignoreForeignQueues ? 1 : 0) | (ctx->isStaff ? 2 : 0);
+    outKey->maxJunctions   = ctx->maxJunctions;
+
+    /* The search treats the junctions in the pathfind history the same
+     * whatever order they were remembered in. */
+    std::copy_n(peep->pathfind_history, 4, outKey->history);
+    std::sort(outKey->history, outKey->history + 4, [](const rct12_xyzd8 &a, const rct12_xyzd8 &b) -> bool {
+        return std::tie(a.x, a.y, a.z, a.direction) < std::tie(b.x, b.y, b.z, b.direction);
+    });
+    return true;
+}
+
+static void peep_pathfind_cache_validate()
+{
+    if (_pathfindCacheGeneration != gMapModificationGeneration)
+    {
+        _pathfindCache.clear();
+        _pathfindCacheGeneration = gMapModificationGeneration;
+    }
+}
+
+/**
+ * peep_pathfind_choose_junction_edge() through the pathfinding cache. A choice
+ * is a function of its key and the map alone, and the cache is emptied
+ * whenever the map changes, so using it never changes which way a peep goes.
+ */
+static sint32 peep_pathfind_choose_junction_edge_cached(pathfind_search_context * ctx, sint16 x, sint16 y, uint8 z,
+                                                        rct_peep * peep, rct_tile_element * firstTileElement, uint8 edges,
+                                                        TileCoordsXYZ goal)
+{
+    pathfind_cache_key key;
+    if (!peep_pathfind_make_cache_key(ctx, x, y, z, peep, edges, &key))
+        return peep_pathfind_choose_junction_edge(ctx, x, y, z, peep, firstTileElement, edges, goal);
+
+    peep_pathfind_cache_validate();
+    auto it = _pathfindCache.find(key);
+    if (it != _pathfindCache.end())
+    {
+        _pathfindCacheStats.hits++;
+        return it->second;
+    }
+    _pathfindCacheStats.misses++;
+
+    sint32 chosen_edge = peep_pathfind_choose_junction_edge(ctx, x, y, z, peep, firstTileElement, edges, goal);
+    if (_pathfindCache.size() >= PEEP_PATHFIND_CACHE_MAX_ENTRIES)
+        _pathfindCache.clear();
+    _pathfindCache[key] = (sint8)chosen_edge;
+    return chosen_edge;
+}
+
+peep_pathfind_cache_stats peep_pathfind_get_cache_stats()
+{
+    peep_pathfind_cache_stats stats = _pathfindCacheStats;
+    stats.entries = (uint32)_pathfindCache.size();
+    return stats;
+}
+
+void peep_pathfind_reset_cache_stats()
+{
+    _pathfindCacheStats = {};
+}
+
+/**
+ * Returns:
+ *   -1   - no direction chosen
+ *   0..3 - chosen direction
+ *
+ *  rct2: 0x0069A5F0
+ */
+sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * peep)
+{
+    pathfind_search_context ctx;
+    ctx.goal                = gPeepPathFindGoalPosition;
+    ctx.ignoreForeignQueues = gPeepPathFindIgnoreForeignQueues;
+    ctx.queueRideIndex      = gPeepPathFindQueueRideIndex;
+
+    // The max number of thin junctions searched - a per-search-path limit.
+    ctx.maxJunctions = peep_pathfind_get_max_number_junctions(peep);
+
+    // Used to allow walking through no entry banners
+    _peepPathFindIsStaff = (peep->type == PEEP_TYPE_STAFF);
+    ctx.isStaff          = _peepPathFindIsStaff;
+
+    TileCoordsXYZ goal = { (uint8)(gPeepPathFindGoalPosition.x >> 5),
+                      (uint8)(gPeepPathFindGoalPosition.y >> 5),
+                      (uint8)(gPeepPathFindGoalPosition.z) };
+
+#if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+    if (gPathFindDebug)
+    {
+        log_verbose("Choose direction for %s for goal %d,%d,%d from %d,%d,%d", gPathFindDebugPeepName, goal.x, goal.y, goal.z,
+                    x >> 5, y >> 5, z);
+    }
+#endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
+
+    rct_tile_element * first_tile_element;
+    uint8              permitted_edges;
+    uint8              edges;
+    bool               isThin;
+    if (!peep_pathfind_get_edges(x, y, z, peep, goal, ctx.isStaff, &first_tile_element, &permitted_edges, &edges, &isThin))
+        return -1;
+
+    // Peep has tried all edges.
+    if (edges == 0)
+        return -1;
+
+    sint32 chosen_edge = bitscanforward(edges);
+    // Peep has multiple edges still to try.
+    if (edges & ~(1 << chosen_edge))
+    {
+        chosen_edge = peep_pathfind_choose_junction_edge_cached(&ctx, x, y, z, peep, first_tile_element, edges, goal);
+        if (chosen_edge == -1)
+            return -1;
     }
 
     if (isThin)
@@ -11099,7 +11432,7 @@ static void get_ride_queue_end(sint16 * x, sint16 * y, sint16 * z)
     bool found = false;
     do
     {
-        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_ENTRANCE)
+        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_ENTRANCE || tile_element_is_ghost(tileElement))
             continue;
 
         if (*z != tileElement->base_height)
@@ -11145,7 +11478,7 @@ static void get_ride_queue_end(sint16 * x, sint16 * y, sint16 * z)
             if (tileElement == firstPathElement)
                 continue;
 
-            if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
+            if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || tile_element_is_ghost(tileElement))
                 continue;
 
             if (baseZ == tileElement->base_height)
@@ -11220,6 +11553,81 @@ static void get_ride_queue_end(sint16 * x, sint16 * y, sint16 * z)
     *z = tileElement->base_height;
 }
 
+/**
+ * Returns the end of the queue of the entrance station a guest heading for
+ * an open ride walks to.
+ */
+static LocationXYZ16 guest_path_find_ride_goal(rct_peep * peep, Ride * ride)
+{
+    /* Find the ride's closest entrance station to the peep.
+     * At the same time, count how many entrance stations there are and
+     * which stations are entrance stations. */
+    uint16 closestDist       = 0xFFFF;
+    uint8  closestStationNum = 0;
+
+    sint32 numEntranceStations = 0;
+    uint8  entranceStations    = 0;
+
+    for (uint8 stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
+    {
+        if (ride->entrances[stationNum].xy ==
+            RCT_XY8_UNDEFINED) // stationNum has no entrance (so presumably an exit only station).
+            continue;
+
+        numEntranceStations++;
+        entranceStations |= (1 << stationNum);
+
+        sint16 stationX = (ride->entrances[stationNum]).x * 32;
+        sint16 stationY = (ride->entrances[stationNum]).y * 32;
+        uint16 dist     = abs(stationX - peep->next_x) + abs(stationY - peep->next_y);
+
+        if (dist < closestDist)
+        {
+            closestDist       = dist;
+            closestStationNum = stationNum;
+            continue;
+        }
+    }
+
+    // Ride has no stations with an entrance, so head to station 0.
+    if (numEntranceStations == 0)
+        closestStationNum = 0;
+
+    /* If a ride has multiple entrance stations and is set to sync with
+     * adjacent stations, cycle through the entrance stations (based on
+     * number of rides the peep has been on) so the peep will try the
+     * different sections of the ride.
+     * In this case, the ride's various entrance stations will typically,
+     * though not necessarily, be adjacent to one another and consequently
+     * not too far for the peep to walk when cycling between them.
+     * Note: the same choice of station must made while the peep navigates
+     * to the station. Consequently a random station selection here is not
+     * appropriate. */
+    if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
+    {
+        sint32 select = peep->no_of_rides % numEntranceStations;
+        while (select > 0)
+        {
+            closestStationNum = bitscanforward(entranceStations);
+            entranceStations &= ~(1 << closestStationNum);
+            select--;
+        }
+        closestStationNum = bitscanforward(entranceStations);
+    }
+
+    LocationXY8 entranceXY;
+    if (numEntranceStations == 0)
+        entranceXY = ride->station_starts[closestStationNum]; // closestStationNum is always 0 here.
+    else
+        entranceXY = ride->entrances[closestStationNum];
+
+    sint16 x = entranceXY.x * 32;
+    sint16 y = entranceXY.y * 32;
+    sint16 z = ride->station_heights[closestStationNum];
+    get_ride_queue_end(&x, &y, &z);
+    return { x, y, z };
+}
+
 /**
  *
  *  rct2: 0x00694C35
@@ -11252,7 +11660,7 @@ static sint32 guest_path_finding(rct_peep * peep)
     }
 
     _peepPathFindIsStaff = false;
-    uint8 edges          = path_get_permitted_edges(tileElement);
+    uint8 edges          = path_get_permitted_edges(_peepPathFindIsStaff, tileElement);
 
     if (edges == 0)
     {
@@ -11432,75 +11840,7 @@ static sint32 guest_path_finding(rct_peep * peep)
     // The ride is open.
     gPeepPathFindQueueRideIndex = rideIndex;
 
-    /* Find the ride's closest entrance station to the peep.
-     * At the same time, count how many entrance stations there are and
-     * which stations are entrance stations. */
-    uint16 closestDist       = 0xFFFF;
-    uint8  closestStationNum = 0;
-
-    sint32 numEntranceStations = 0;
-    uint8  entranceStations    = 0;
-
-    for (uint8 stationNum = 0; stationNum < MAX_STATIONS; ++stationNum)
-    {
-        if (ride->entrances[stationNum].xy ==
-            RCT_XY8_UNDEFINED) // stationNum has no entrance (so presumably an exit only station).
-            continue;
-
-        numEntranceStations++;
-        entranceStations |= (1 << stationNum);
-
-        sint16 stationX = (ride->entrances[stationNum]).x * 32;
-        sint16 stationY = (ride->entrances[stationNum]).y * 32;
-        uint16 dist     = abs(stationX - peep->next_x) + abs(stationY - peep->next_y);
-
-        if (dist < closestDist)
-        {
-            closestDist       = dist;
-            closestStationNum = stationNum;
-            continue;
-        }
-    }
-
-    // Ride has no stations with an entrance, so head to station 0.
-    if (numEntranceStations == 0)
-        closestStationNum = 0;
-
-    /* If a ride has multiple entrance stations and is set to sync with
-     * adjacent stations, cycle through the entrance stations (based on
-     * number of rides the peep has been on) so the peep will try the
-     * different sections of the ride.
-     * In this case, the ride's various entrance stations will typically,
-     * though not necessarily, be adjacent to one another and consequently
-     * not too far for the peep to walk when cycling between them.
-     * Note: the same choice of station must made while the peep navigates
-     * to the station. Consequently a random station selection here is not
-     * appropriate. */
-    if (numEntranceStations > 1 && (ride->depart_flags & RIDE_DEPART_SYNCHRONISE_WITH_ADJACENT_STATIONS))
-    {
-        sint32 select = peep->no_of_rides % numEntranceStations;
-        while (select > 0)
-        {
-            closestStationNum = bitscanforward(entranceStations);
-            entranceStations &= ~(1 << closestStationNum);
-            select--;
-        }
-        closestStationNum = bitscanforward(entranceStations);
-    }
-
-    LocationXY8 entranceXY;
-    if (numEntranceStations == 0)
-        entranceXY = ride->station_starts[closestStationNum]; // closestStationNum is always 0 here.
-    else
-        entranceXY = ride->entrances[closestStationNum];
-
-    x = entranceXY.x * 32;
-    y = entranceXY.y * 32;
-    z = ride->station_heights[closestStationNum];
-
-    get_ride_queue_end(&x, &y, &z);
-
-    gPeepPathFindGoalPosition        = { x, y, z };
+    gPeepPathFindGoalPosition        = guest_path_find_ride_goal(peep, ride);
     gPeepPathFindIgnoreForeignQueues = true;
 
     direction = peep_pathfind_choose_direction(peep->next_x, peep->next_y, peep->next_z, peep);
@@ -11535,6 +11875,160 @@ static sint32 guest_path_finding(rct_peep * peep)
     return peep_move_one_tile(direction, peep);
 }
 
+/**
+ * Fills in the inputs of the heuristic searches a guest is expected to make
+ * while heading for a ride this tick. Returns false if the guest is not
+ * expected to search or its search depends on anything but the map and its
+ * own pathfind history.
+ */
+static bool guest_pathfind_prepare_speculation(rct_peep * peep, pathfind_speculation * speculation)
+{
+    if (peep->state != PEEP_STATE_WALKING || peep->outside_of_park != 0 || (peep->next_var_29 & 0x18))
+        return false;
+    if ((peep->peep_flags & (PEEP_FLAGS_LEAVING_PARK | PEEP_FLAGS_2)) || peep->guest_heading_to_ride_id == 0xFF)
+        return false;
+
+    // Guests only choose a new direction once they reach the destination on their current tile.
+    if (peep->var_73 + peep_get_steps_to_take(peep) <= 255 || peep->action < PEEP_ACTION_NONE_1)
+        return false;
+    sint32 xyDistance = abs(peep->x - peep->destination_x) + abs(peep->y - peep->destination_y);
+    if (xyDistance > peep->destination_tolerance)
+        return false;
+
+    Ride * ride = get_ride(peep->guest_heading_to_ride_id);
+    if (ride->status != RIDE_STATUS_OPEN)
+        return false;
+
+    speculation->peep           = *peep;
+    speculation->x              = peep->next_x;
+    speculation->y              = peep->next_y;
+    speculation->z              = peep->next_z;
+    speculation->goal           = guest_path_find_ride_goal(peep, ride);
+    speculation->queueRideIndex = peep->guest_heading_to_ride_id;
+    speculation->maxJunctions   = peep_pathfind_get_max_number_junctions(&speculation->peep);
+
+    TileCoordsXYZ goal = { (uint8)(speculation->goal.x >> 5), (uint8)(speculation->goal.y >> 5),
+                           (uint8)(speculation->goal.z) };
+    uint8 permittedEdges;
+    bool  isThin;
+    if (!peep_pathfind_get_edges(speculation->x, speculation->y, speculation->z, &speculation->peep, goal, false,
+                                 &speculation->firstTileElement, &permittedEdges, &speculation->edges, &isThin))
+    {
+        return false;
+    }
+
+    // Only junctions need a search
+    if ((speculation->edges & (speculation->edges - 1)) == 0)
+        return false;
+
+    pathfind_search_context ctx;
+    ctx.goal                = speculation->goal;
+    ctx.ignoreForeignQueues = true;
+    ctx.queueRideIndex      = speculation->queueRideIndex;
+    ctx.isStaff             = false;
+    ctx.maxJunctions        = speculation->maxJunctions;
+
+    // Nothing needs to be searched if the choice is already in the pathfinding cache
+    pathfind_cache_key key;
+    if (peep_pathfind_make_cache_key(&ctx, speculation->x, speculation->y, speculation->z, &speculation->peep,
+                                     speculation->edges, &key))
+    {
+        peep_pathfind_cache_validate();
+        if (_pathfindCache.find(key) != _pathfindCache.end())
+            return false;
+    }
+
+    // The heuristic search is only needed if the goal can not be reached through the footpath graph
+    return peep_pathfind_graph_choose_edge(&ctx, speculation->x, speculation->y, speculation->z, &speculation->peep,
+                                           speculation->edges) == -1;
+}
+
+static void guest_pathfind_run_speculation(pathfind_speculation * speculation)
+{
+    pathfind_search_context ctx;
+    ctx.goal                = speculation->goal;
+    ctx.ignoreForeignQueues = true;
+    ctx.queueRideIndex      = speculation->queueRideIndex;
+    ctx.isStaff             = false;
+    ctx.maxJunctions        = speculation->maxJunctions;
+
+    sint32 tilesChecked = PEEP_PATHFIND_MAX_TILES_GUEST / bitcount(speculation->edges);
+    for (sint32 test_edge = 0; test_edge < 4; test_edge++)
+    {
+        if (!(speculation->edges & (1 << test_edge)))
+            continue;
+
+        uint16        score                = 0xFFFF;
+        TileCoordsXYZ endXYZ               = { 0, 0, 0 };
+        uint8         endSteps             = 255;
+        uint8         endJunctions         = 0;
+        TileCoordsXYZ endJunctionList[16]  = { 0 };
+        uint8         endDirectionList[16] = { 0 };
+        peep_pathfind_search_edge(&ctx, speculation->x, speculation->y, speculation->z, &speculation->peep,
+                                  speculation->firstTileElement, test_edge, tilesChecked, &score, &endJunctions,
+                                  endJunctionList, endDirectionList, &endXYZ, &endSteps);
+        speculation->scores[test_edge] = score;
+        speculation->steps[test_edge]  = endSteps;
+    }
+}
+
+/**
+ * The decision phase of the peep update: runs the heuristic searches of the
+ * guests that are expected to arrive at a junction this tick on the job
+ * pool before any peep is updated.
+ * The searches only read the map, the rides and a copy of each guest, none
+ * of which peep updates change in a way the search depends on, and no
+ * random numbers are drawn. peep_pathfind_choose_direction() then uses a
+ * result only when the guest searches with exactly the same inputs and
+ * otherwise searches itself, so the outcome is identical to updating every
+ * peep in turn.
+ */
+static void peep_pathfind_speculate_all()
+{
+    JobPool * jobPool = JobPool::GetShared();
+    if (jobPool->GetThreadCount() <= 1)
+        return;
+
+    uint16     spriteIndex;
+    rct_peep * peep;
+    FOR_ALL_GUESTS(spriteIndex, peep)
+    {
+        pathfind_speculation speculation;
+        if (guest_pathfind_prepare_speculation(peep, &speculation))
+        {
+            _pathfindSpeculationIndex[peep->sprite_index] = _pathfindSpeculations.size();
+            _pathfindSpeculations.push_back(speculation);
+        }
+    }
+
+    if (_pathfindSpeculations.size() < PEEP_PATHFIND_SPECULATION_MIN_GUESTS)
+    {
+        peep_pathfind_clear_speculation();
+        return;
+    }
+
+    size_t numSpeculations = _pathfindSpeculations.size();
+    size_t numTasks        = jobPool->GetThreadCount() * 4;
+    size_t chunkSize       = (numSpeculations + numTasks - 1) / numTasks;
+    for (size_t begin = 0; begin < numSpeculations; begin += chunkSize)
+    {
+        size_t end = std::min(begin + chunkSize, numSpeculations);
+        jobPool->AddTask([begin, end]() -> void {
+            for (size_t i = begin; i < end; i++)
+            {
+                guest_pathfind_run_speculation(&_pathfindSpeculations[i]);
+            }
+        });
+    }
+    jobPool->Join();
+}
+
+static void peep_pathfind_clear_speculation()
+{
+    _pathfindSpeculations.clear();
+    _pathfindSpeculationIndex.clear();
+}
+
 /**
  *
  *  rct2: 0x00693C9E
@@ -13505,7 +13999,8 @@ static void peep_pick_ride_to_go_on(rct_peep * peep)
         {
             for (sint32 y = cy - 320; y <= cy + 320; y += 32)
             {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
+                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32) &&
+                    map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
                 {
                     rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
                     do
@@ -13644,7 +14139,8 @@ static void peep_head_for_nearest_ride_type(rct_peep * peep, sint32 rideType)
         {
             for (sint32 y = cy - 320; y <= cy + 320; y += 32)
             {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
+                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32) &&
+                    map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
                 {
                     rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
                     do
@@ -13776,7 +14272,8 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep * peep, sint32 rideTy
         {
             for (sint32 y = cy - 320; y <= cy + 320; y += 32)
             {
-                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32))
+                if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32) &&
+                    map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
                 {
                     rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
                     do
@@ -14008,6 +14505,7 @@ void peep_update_name_sort(rct_peep * peep)
 finish_peep_sort:
     // This is required at the moment because this function reorders peeps in the sprite list
     sprite_position_tween_reset();
+    sprite_list_order_invalidate();
 }
 
 void peep_sort()
@@ -14042,6 +14540,7 @@ void peep_sort()
     }
     // Make sure the first peep is set
     gSpriteListHead[SPRITE_LIST_PEEP] = peep_list[0];
+    sprite_list_order_invalidate();
 
     free(peep_list);
 
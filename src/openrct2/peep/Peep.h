@@ -799,6 +799,16 @@ void game_command_set_guest_name(sint32 * eax, sint32 * ebx, sint32 * ecx, sint3
 sint32 peep_pathfind_choose_direction(sint16 x, sint16 y, uint8 z, rct_peep * peep);
 void   peep_reset_pathfind_goal(rct_peep * peep);
 
+struct peep_pathfind_cache_stats
+{
+    uint64 hits;
+    uint64 misses;
+    uint32 entries;
+};
+
+peep_pathfind_cache_stats peep_pathfind_get_cache_stats();
+void                      peep_pathfind_reset_cache_stats();
+
 bool is_valid_path_z_and_direction(rct_tile_element * tileElement, sint32 currentZ, sint32 currentDirection);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
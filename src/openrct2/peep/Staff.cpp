@@ -203,7 +203,7 @@ static money32 staff_hire_new_staff_member(uint8 staff_type, uint8 flags, sint16
     gCommandPosition.y      = command_y;
     gCommandPosition.z      = command_z;
 
-    if (gSpriteListCount[SPRITE_LIST_NULL] < 400)
+    if (sprite_get_free_count() < 400)
     {
         gGameCommandErrorText = STR_TOO_MANY_PEOPLE_IN_GAME;
         return MONEY32_UNDEFINED;
@@ -429,7 +429,7 @@ void game_command_set_staff_order(sint32 * eax, sint32 * ebx, sint32 * ecx, sint
     gCommandExpenditureType = RCT_EXPENDITURE_TYPE_WAGES;
     uint8  order_id         = *ebx >> 8;
     uint16 sprite_id        = *edx;
-    if (sprite_id >= MAX_SPRITES)
+    if (sprite_id >= sprite_get_capacity())
     {
         log_warning("Invalid game command, sprite_id = %u", sprite_id);
         *ebx = MONEY32_UNDEFINED;
@@ -482,7 +482,7 @@ void game_command_set_staff_patrol(sint32 * eax, sint32 * ebx, sint32 * ecx, sin
         sint32 x         = *eax;
         sint32 y         = *ecx;
         uint16 sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             *ebx = MONEY32_UNDEFINED;
             log_warning("Invalid sprite id %u", sprite_id);
@@ -536,7 +536,7 @@ void game_command_fire_staff_member(sint32 * eax, sint32 * ebx, sint32 * ecx, si
     {
         window_close_by_class(WC_FIRE_PROMPT);
         uint16 sprite_id = *edx;
-        if (sprite_id >= MAX_SPRITES)
+        if (sprite_id >= sprite_get_capacity())
         {
             log_warning("Invalid game command, sprite_id = %u", sprite_id);
             *ebx = MONEY32_UNDEFINED;
@@ -749,7 +749,7 @@ bool staff_can_ignore_wide_flag(rct_peep * staff, sint32 x, sint32 y, uint8 z, r
         bool              widefound    = false;
         do
         {
-            if (tile_element_get_type(test_element) != TILE_ELEMENT_TYPE_PATH)
+            if (tile_element_get_type(test_element) != TILE_ELEMENT_TYPE_PATH || tile_element_is_ghost(test_element))
             {
                 continue;
             }
@@ -900,11 +900,11 @@ static uint8 staff_handyman_direction_to_nearest_litter(rct_peep * peep)
 {
     uint16       nearestLitterDist = (uint16)-1;
     rct_litter * nearestLitter     = nullptr;
-    rct_litter * litter            = nullptr;
 
-    for (uint16 litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
+    // Only litter within 0x60 can be chosen, which is at most that far away along each axis
+    for (uint16 litterIndex : litter_get_nearby(peep->x, peep->y, 0x60))
     {
-        litter = &get_sprite(litterIndex)->litter;
+        rct_litter * litter = &get_sprite(litterIndex)->litter;
 
         uint16 distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
 
@@ -1485,27 +1485,14 @@ static bool staff_path_finding_misc(rct_peep * peep)
  */
 static void staff_entertainer_update_nearby_peeps(rct_peep * peep)
 {
-    uint16     spriteIndex;
-    rct_peep * guest;
-
-    FOR_ALL_GUESTS(spriteIndex, guest)
+    for (uint16 spriteIndex : sprite_query_in_range(peep->x, peep->y, 96, SPRITE_QUERY_TYPE_GUEST))
     {
-        if (guest->x == LOCATION_NULL)
-            continue;
+        rct_peep * guest = GET_PEEP(spriteIndex);
 
         sint16 z_dist = abs(peep->z - guest->z);
         if (z_dist > 48)
             continue;
 
-        sint16 x_dist = abs(peep->x - guest->x);
-        sint16 y_dist = abs(peep->y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
-
         if (peep->state == PEEP_STATE_WALKING)
         {
             peep->happiness_target = Math::Min(peep->happiness_target + 4, PEEP_MAX_HAPPINESS);
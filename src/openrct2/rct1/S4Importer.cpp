@@ -1315,7 +1315,7 @@ private:
                 ImportPeep(peep, srcPeep);
             }
         }
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < sprite_get_capacity(); i++)
         {
             rct_sprite * sprite = get_sprite(i);
             if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
@@ -1767,13 +1767,18 @@ private:
     void ImportMapAnimations()
     {
         // This is sketchy, ideally we should try to re-create them
-        rct_map_animation * s4Animations = _s4.map_animations;
-        for (size_t i = 0; i < RCT1_MAX_ANIMATED_OBJECTS; i++)
+        map_animation_reset();
+        size_t numAnimations = std::min<size_t>(_s4.num_map_animations, RCT1_MAX_ANIMATED_OBJECTS);
+        for (size_t i = 0; i < numAnimations; i++)
         {
-            gAnimatedObjects[i] = s4Animations[i];
-            gAnimatedObjects[i].baseZ /= 2;
+            const rct_map_animation * s4Animation = &_s4.map_animations[i];
+            map_animation_create(s4Animation->type, s4Animation->x, s4Animation->y, s4Animation->baseZ / 2);
+        }
+        if (numAnimations == RCT1_MAX_ANIMATED_OBJECTS)
+        {
+            // The list was full, so some animations were never recorded
+            map_animation_auto_create();
         }
-        gNumMapAnimations = _s4.num_map_animations;
     }
 
     void ImportFinance()
@@ -1930,10 +1935,6 @@ private:
 
     void ImportTileElements()
     {
-        std::copy(
-            std::begin(_s4.tile_elements),
-            std::end(_s4.tile_elements),
-            gTileElements);
         ClearExtraTileEntries();
         FixSceneryColours();
         FixTileElementZ();
@@ -1943,6 +1944,9 @@ private:
         FixTerrain();
         FixEntrancePositions();
         FixTileElementEntryTypes();
+
+        // Heights were halved and terrain rewritten after the tile pointers were set
+        map_invalidate_surface_heights();
     }
 
     void ImportResearch()
@@ -2355,67 +2359,56 @@ private:
 
     void ClearExtraTileEntries()
     {
-        // Reset the map tile pointers
-        std::fill(std::begin(gTileElementTilePointers), std::end(gTileElementTilePointers), nullptr);
-
-        // Get the first free map element
-        rct_tile_element * nextFreeTileElement = gTileElements;
-        for (size_t i = 0; i < RCT1_MAX_MAP_SIZE * RCT1_MAX_MAP_SIZE; i++)
-        {
-            while (!tile_element_is_last_for_tile(nextFreeTileElement++));
-        }
+        rct_tile_element blankTileElement = {};
+        blankTileElement.type = TILE_ELEMENT_TYPE_SURFACE;
+        blankTileElement.flags = TILE_ELEMENT_FLAG_LAST_TILE;
+        blankTileElement.base_height = 2;
+        blankTileElement.clearance_height = 0;
+        blankTileElement.properties.surface.slope = TILE_ELEMENT_SLOPE_FLAT;
+        blankTileElement.properties.surface.terrain = 0;
+        blankTileElement.properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
+        blankTileElement.properties.surface.ownership = 0;
 
-        rct_tile_element * tileElement = gTileElements;
-        rct_tile_element * * tilePointer = gTileElementTilePointers;
+        std::vector<rct_tile_element> tileElements;
+        tileElements.reserve(RCT1_MAX_TILE_ELEMENTS + (MAX_TILE_TILE_ELEMENT_POINTERS - RCT1_MAX_MAP_SIZE * RCT1_MAX_MAP_SIZE));
 
         // 128 rows of map data from RCT1 map
+        size_t index = 0;
         for (sint32 x = 0; x < RCT1_MAX_MAP_SIZE; x++)
         {
-            // Assign the first half of this row
+            // Copy the first half of this row
             for (sint32 y = 0; y < RCT1_MAX_MAP_SIZE; y++)
             {
-                *tilePointer++ = tileElement;
-                while (!tile_element_is_last_for_tile(tileElement++));
+                do
+                {
+                    if (index >= RCT1_MAX_TILE_ELEMENTS)
+                    {
+                        throw std::runtime_error("Invalid tile elements.");
+                    }
+                    tileElements.push_back(_s4.tile_elements[index]);
+                }
+                while (!tile_element_is_last_for_tile(&_s4.tile_elements[index++]));
             }
 
             // Fill the rest of the row with blank tiles
-            for (sint32 y = 0; y < RCT1_MAX_MAP_SIZE; y++)
-            {
-                nextFreeTileElement->type = TILE_ELEMENT_TYPE_SURFACE;
-                nextFreeTileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
-                nextFreeTileElement->base_height = 2;
-                nextFreeTileElement->clearance_height = 0;
-                nextFreeTileElement->properties.surface.slope = TILE_ELEMENT_SLOPE_FLAT;
-                nextFreeTileElement->properties.surface.terrain = 0;
-                nextFreeTileElement->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
-                nextFreeTileElement->properties.surface.ownership = 0;
-                *tilePointer++ = nextFreeTileElement++;
-            }
+            tileElements.insert(tileElements.end(), RCT1_MAX_MAP_SIZE, blankTileElement);
         }
 
         // 128 extra rows left to fill with blank tiles
-        for (sint32 y = 0; y < 128 * 256; y++)
-        {
-            nextFreeTileElement->type = TILE_ELEMENT_TYPE_SURFACE;
-            nextFreeTileElement->flags = TILE_ELEMENT_FLAG_LAST_TILE;
-            nextFreeTileElement->base_height = 2;
-            nextFreeTileElement->clearance_height = 0;
-            nextFreeTileElement->properties.surface.slope =TILE_ELEMENT_SLOPE_FLAT;
-            nextFreeTileElement->properties.surface.terrain = 0;
-            nextFreeTileElement->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
-            nextFreeTileElement->properties.surface.ownership = 0;
-            *tilePointer++ = nextFreeTileElement++;
-        }
+        tileElements.insert(tileElements.end(), 128 * 256, blankTileElement);
 
-        gNextFreeTileElement = nextFreeTileElement;
+        map_load_tile_elements(tileElements.data(), tileElements.size());
+        map_update_tile_pointers();
     }
 
     void FixSceneryColours()
     {
         colour_t colour;
-        rct_tile_element * tileElement = gTileElements;
-        while (tileElement < gNextFreeTileElement)
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        while (tile_element_iterator_next(&it))
         {
+            rct_tile_element * tileElement = it.element;
             if (tileElement->base_height != 255)
             {
                 switch (tile_element_get_type(tileElement)) {
@@ -2458,30 +2451,32 @@ private:
                     break;
                 }
             }
-            tileElement++;
         }
     }
 
     void FixTileElementZ()
     {
-        rct_tile_element * tileElement = gTileElements;
-        while (tileElement < gNextFreeTileElement)
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        while (tile_element_iterator_next(&it))
         {
+            rct_tile_element * tileElement = it.element;
             if (tileElement->base_height != 255)
             {
                 tileElement->base_height /= 2;
                 tileElement->clearance_height /= 2;
             }
-            tileElement++;
         }
         gMapBaseZ = 7;
     }
 
     void FixPaths()
     {
-        rct_tile_element * tileElement = gTileElements;
-        while (tileElement < gNextFreeTileElement)
+        tile_element_iterator it;
+        tile_element_iterator_begin(&it);
+        while (tile_element_iterator_next(&it))
         {
+            rct_tile_element * tileElement = it.element;
             switch (tile_element_get_type(tileElement)) {
             case TILE_ELEMENT_TYPE_PATH:
             {
@@ -2530,7 +2525,6 @@ private:
                 }
                 break;
             }
-            tileElement++;
         }
     }
 
@@ -88,6 +88,8 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     _s6.header.num_packed_objects = uint16(ExportObjectsList.size());
     _s6.header.version            = S6_RCT2_VERSION;
     _s6.header.magic_number       = S6_MAGIC_NUMBER;
+    _s6.header.num_extra_sprites  = (uint16)_extraSprites.size();
+    _s6.header.num_extra_tile_elements = (uint32)_extraTileElements.size();
     _s6.game_version_number       = 201028;
 
     auto chunkWriter = SawyerChunkWriter(stream);
@@ -135,6 +137,18 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
+    // Sprites that do not fit in the RCT2 sprite array
+    if (!_extraSprites.empty())
+    {
+        chunkWriter.WriteChunk(_extraSprites.data(), _extraSprites.size() * sizeof(rct_sprite), SAWYER_ENCODING::RLECOMPRESSED);
+    }
+
+    // Tile elements that do not fit in the RCT2 tile element array
+    if (!_extraTileElements.empty())
+    {
+        chunkWriter.WriteChunk(_extraTileElements.data(), _extraTileElements.size() * sizeof(rct_tile_element), SAWYER_ENCODING::RLECOMPRESSED);
+    }
+
     // Determine number of bytes written
     size_t fileSize = stream->GetLength();
 
@@ -185,7 +199,12 @@ void S6Exporter::Export()
     _s6.scenario_srand_0 = gScenarioSrand0;
     _s6.scenario_srand_1 = gScenarioSrand1;
 
-    memcpy(_s6.tile_elements, gTileElements, sizeof(_s6.tile_elements));
+    // Tile elements are saved in tile order, anything past the RCT2 limit continues in an extra chunk
+    std::vector<rct_tile_element> tileElements = map_get_tile_elements();
+    size_t numTileElements = std::min<size_t>(tileElements.size(), RCT2_MAX_TILE_ELEMENTS);
+    memcpy(_s6.tile_elements, tileElements.data(), numTileElements * sizeof(rct_tile_element));
+    memset(&_s6.tile_elements[numTileElements], 0, (RCT2_MAX_TILE_ELEMENTS - numTileElements) * sizeof(rct_tile_element));
+    _extraTileElements.assign(tileElements.begin() + numTileElements, tileElements.end());
 
     _s6.next_free_tile_element_pointer_index = gNextFreeTileElementPointerIndex;
     // Sprites needs to be reset before they get used.
@@ -197,6 +216,11 @@ void S6Exporter::Export()
     {
         memcpy(&_s6.sprites[i], get_sprite(i), sizeof(rct_sprite));
     }
+    _extraSprites.clear();
+    for (size_t i = RCT2_MAX_SPRITES; i < sprite_get_capacity(); i++)
+    {
+        _extraSprites.push_back(*get_sprite(i));
+    }
 
     for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
     {
@@ -355,8 +379,7 @@ void S6Exporter::Export()
     _s6.saved_view_y        = gSavedViewY;
     _s6.saved_view_zoom     = gSavedViewZoom;
     _s6.saved_view_rotation = gSavedViewRotation;
-    memcpy(_s6.map_animations, gAnimatedObjects, sizeof(_s6.map_animations));
-    _s6.num_map_animations = gNumMapAnimations;
+    this->ExportMapAnimations();
     // pad_0138B582
 
     _s6.ride_ratings_calc_data = gRideRatingsCalcData;
@@ -426,6 +449,20 @@ void S6Exporter::ExportPeepSpawns()
     }
 }
 
+void S6Exporter::ExportMapAnimations()
+{
+    // The save format only has room for a fixed number of animations, any others are recreated when the park is loaded
+    const auto &animations = map_animation_get_all();
+    size_t numAnimations = std::min<size_t>(animations.size(), RCT2_MAX_ANIMATED_OBJECTS);
+    if (numAnimations < animations.size())
+    {
+        log_warning("Only saving %u of %u map animations", (uint32)numAnimations, (uint32)animations.size());
+    }
+    std::fill(std::begin(_s6.map_animations), std::end(_s6.map_animations), rct_map_animation());
+    std::copy_n(animations.begin(), numAnimations, _s6.map_animations);
+    _s6.num_map_animations = (uint16)numAnimations;
+}
+
 uint32 S6Exporter::GetLoanHash(money32 initialCash, money32 bankLoan, uint32 maxBankLoan)
 {
     sint32 value = 0x70093A;
@@ -46,6 +46,8 @@ public:
 
 private:
     rct_s6_data _s6;
+    std::vector<rct_sprite> _extraSprites;
+    std::vector<rct_tile_element> _extraTileElements;
 
     void Save(IStream * stream, bool isScenario);
     static uint32 GetLoanHash(money32 initialCash, money32 bankLoan, uint32 maxBankLoan);
@@ -54,4 +56,5 @@ private:
     void ExportResearchedSceneryItems();
     void ExportResearchList();
     void ExportPeepSpawns();
+    void ExportMapAnimations();
 };
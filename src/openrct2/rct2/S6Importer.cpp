@@ -69,6 +69,8 @@ private:
 
     const utf8 *    _s6Path = nullptr;
     rct_s6_data     _s6 { };
+    std::vector<rct_sprite> _extraSprites;
+    std::vector<rct_tile_element> _extraTileElements;
     uint8           _gameVersion = 0;
 
 public:
@@ -175,6 +177,28 @@ public:
             chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
         }
 
+        _extraSprites.clear();
+        if (_s6.header.num_extra_sprites > 0)
+        {
+            if (_s6.header.num_extra_sprites > MAX_SPRITES_LIMIT - RCT2_MAX_SPRITES)
+            {
+                throw IOException("Invalid number of sprites.");
+            }
+            _extraSprites.resize(_s6.header.num_extra_sprites);
+            chunkReader.ReadChunk(_extraSprites.data(), _extraSprites.size() * sizeof(rct_sprite));
+        }
+
+        _extraTileElements.clear();
+        if (_s6.header.num_extra_tile_elements > 0)
+        {
+            if (_s6.header.num_extra_tile_elements > RCT2_MAX_TILE_ELEMENTS * 16)
+            {
+                throw IOException("Invalid number of tile elements.");
+            }
+            _extraTileElements.resize(_s6.header.num_extra_tile_elements);
+            chunkReader.ReadChunk(_extraTileElements.data(), _extraTileElements.size() * sizeof(rct_tile_element));
+        }
+
         auto missingObjects = _objectManager->GetInvalidObjects(_s6.objects);
 
         if (!missingObjects.empty())
@@ -205,13 +229,18 @@ public:
         gScenarioSrand0    = _s6.scenario_srand_0;
         gScenarioSrand1    = _s6.scenario_srand_1;
 
-        memcpy(gTileElements, _s6.tile_elements, sizeof(_s6.tile_elements));
+        ImportTileElements();
 
         gNextFreeTileElementPointerIndex = _s6.next_free_tile_element_pointer_index;
+        sprite_set_capacity(RCT2_MAX_SPRITES + _extraSprites.size());
         for (sint32 i = 0; i < RCT2_MAX_SPRITES; i++)
         {
             memcpy(get_sprite(i), &_s6.sprites[i], sizeof(rct_sprite));
         }
+        for (size_t i = 0; i < _extraSprites.size(); i++)
+        {
+            memcpy(get_sprite(RCT2_MAX_SPRITES + i), &_extraSprites[i], sizeof(rct_sprite));
+        }
 
         for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++)
         {
@@ -385,11 +414,13 @@ public:
         gSavedViewZoom     = _s6.saved_view_zoom;
         gSavedViewRotation = _s6.saved_view_rotation;
 
-        for (size_t i = 0; i < RCT2_MAX_ANIMATED_OBJECTS; i++)
+        map_animation_reset();
+        size_t numAnimations = std::min<size_t>(_s6.num_map_animations, RCT2_MAX_ANIMATED_OBJECTS);
+        for (size_t i = 0; i < numAnimations; i++)
         {
-            gAnimatedObjects[i] = _s6.map_animations[i];
+            const rct_map_animation * animation = &_s6.map_animations[i];
+            map_animation_create(animation->type, animation->x, animation->y, animation->baseZ);
         }
-        gNumMapAnimations = _s6.num_map_animations;
         // pad_0138B582
 
         gRideRatingsCalcData = _s6.ride_ratings_calc_data;
@@ -445,6 +476,11 @@ public:
         }
         map_strip_ghost_flag_from_elements();
         map_update_tile_pointers();
+        if (numAnimations == RCT2_MAX_ANIMATED_OBJECTS)
+        {
+            // The list was full when saved, so animations beyond the legacy limit have to be found again
+            map_animation_auto_create();
+        }
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
 
@@ -767,6 +803,25 @@ public:
         game_init_all(_s6.map_size);
     }
 
+    void ImportTileElements()
+    {
+        bool success;
+        if (_extraTileElements.empty())
+        {
+            success = map_load_tile_elements(_s6.tile_elements, RCT2_MAX_TILE_ELEMENTS);
+        }
+        else
+        {
+            std::vector<rct_tile_element> tileElements(std::begin(_s6.tile_elements), std::end(_s6.tile_elements));
+            tileElements.insert(tileElements.end(), _extraTileElements.begin(), _extraTileElements.end());
+            success = map_load_tile_elements(tileElements.data(), tileElements.size());
+        }
+        if (!success)
+        {
+            throw IOException("Invalid tile elements.");
+        }
+    }
+
     /**
      * Imports guest entry points.
      * Includes fixes for incorrectly set guest entry points in some scenarios.
@@ -813,7 +868,7 @@ public:
     {
         // The number of riders might have overflown or underflown. Re-calculate the value.
         uint16 numRiders = 0;
-        for (const rct_sprite sprite : _s6.sprites)
+        auto countRider = [&numRiders, rideIndex](const rct_sprite &sprite) -> void
         {
             if (sprite.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
             {
@@ -822,7 +877,9 @@ public:
                     numRiders++;
                 }
             }
-        }
+        };
+        std::for_each(std::begin(_s6.sprites), std::end(_s6.sprites), countRider);
+        std::for_each(_extraSprites.begin(), _extraSprites.end(), countRider);
         dst->num_riders = numRiders;
     }
 };
@@ -2693,46 +2693,39 @@ rct_peep *ride_find_closest_mechanic(Ride *ride, sint32 forInspection)
  */
 rct_peep *find_closest_mechanic(sint32 x, sint32 y, sint32 forInspection)
 {
-    uint32 closestDistance, distance;
-    uint16 spriteIndex;
-    rct_peep *peep, *closestMechanic = nullptr;
-
-    closestDistance = UINT_MAX;
-    FOR_ALL_STAFF(spriteIndex, peep) {
+    bool inPark = map_is_location_in_park(x, y);
+    auto mechanics = sprite_query_nearest(x, y, SPRITE_QUERY_TYPE_STAFF, 1, [x, y, forInspection, inPark](rct_sprite *sprite) -> bool
+    {
+        rct_peep *peep = &sprite->peep;
         if (peep->staff_type != STAFF_TYPE_MECHANIC)
-            continue;
+            return false;
 
         if (!forInspection) {
             if (peep->state == PEEP_STATE_HEADING_TO_INSPECTION){
                 if (peep->sub_state >= 4)
-                    continue;
+                    return false;
             }
             else if (peep->state != PEEP_STATE_PATROLLING)
-                continue;
+                return false;
 
             if (!(peep->staff_orders & STAFF_ORDERS_FIX_RIDES))
-                continue;
+                return false;
         } else {
             if (peep->state != PEEP_STATE_PATROLLING || !(peep->staff_orders & STAFF_ORDERS_INSPECT_RIDES))
-                continue;
+                return false;
         }
 
-        if (map_is_location_in_park(x, y))
+        if (inPark)
             if (!staff_is_location_in_patrol(peep, x & 0xFFE0, y & 0xFFE0))
-                continue;
-
-        if (peep->x == LOCATION_NULL)
-            continue;
+                return false;
 
-        // Manhattan distance
-        distance = std::abs(peep->x - x) + std::abs(peep->y - y);
-        if (distance < closestDistance) {
-            closestDistance = distance;
-            closestMechanic = peep;
-        }
-    }
+        return true;
+    });
 
-    return closestMechanic;
+    // Nearest by Manhattan distance
+    if (mechanics.empty())
+        return nullptr;
+    return &get_sprite(mechanics[0])->peep;
 }
 
 rct_peep *ride_get_assigned_mechanic(Ride *ride)
@@ -4467,7 +4460,7 @@ static void ride_set_start_finish_points(sint32 rideIndex, CoordsXYE *startEleme
 static sint32 count_free_misc_sprite_slots()
 {
     sint32 miscSpriteCount = gSpriteListCount[SPRITE_LIST_MISC];
-    sint32 remainingSpriteCount = gSpriteListCount[SPRITE_LIST_NULL];
+    sint32 remainingSpriteCount = sprite_get_free_count();
     return Math::Max(0, miscSpriteCount + remainingSpriteCount - 300);
 }
 
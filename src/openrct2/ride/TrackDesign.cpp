@@ -44,9 +44,6 @@
 
 struct map_backup
 {
-    rct_tile_element tile_elements[MAX_TILE_ELEMENTS];
-    rct_tile_element * tile_pointers[MAX_TILE_TILE_ELEMENT_POINTERS];
-    rct_tile_element * next_free_tile_element;
     uint16          map_size_units;
     uint16          map_size_units_minus_2;
     uint16          map_size;
@@ -2299,8 +2296,8 @@ void track_design_draw_preview(rct_track_td6 * td6, uint8 * pixels)
 }
 
 /**
- * Create a backup of the map as it will be cleared for drawing the track
- * design preview.
+ * Saves the map size and rotation, the park's tile elements are left in place
+ * as the preview is drawn on a map overlay.
  *  rct2: 0x006D1C68
  */
 static map_backup * track_design_preview_backup_map()
@@ -2308,17 +2305,6 @@ static map_backup * track_design_preview_backup_map()
     map_backup * backup = (map_backup *) malloc(sizeof(map_backup));
     if (backup != nullptr)
     {
-        memcpy(
-            backup->tile_elements,
-            gTileElements,
-            sizeof(backup->tile_elements)
-        );
-        memcpy(
-            backup->tile_pointers,
-            gTileElementTilePointers,
-            sizeof(backup->tile_pointers)
-        );
-        backup->next_free_tile_element  = gNextFreeTileElement;
         backup->map_size_units         = gMapSizeUnits;
         backup->map_size_units_minus_2 = gMapSizeMinus2;
         backup->map_size               = gMapSize;
@@ -2333,17 +2319,7 @@ static map_backup * track_design_preview_backup_map()
  */
 static void track_design_preview_restore_map(map_backup * backup)
 {
-    memcpy(
-        gTileElements,
-        backup->tile_elements,
-        sizeof(backup->tile_elements)
-    );
-    memcpy(
-        gTileElementTilePointers,
-        backup->tile_pointers,
-        sizeof(backup->tile_pointers)
-    );
-    gNextFreeTileElement = backup->next_free_tile_element;
+    map_overlay_end();
     gMapSizeUnits       = backup->map_size_units;
     gMapSizeMinus2      = backup->map_size_units_minus_2;
     gMapSize            = backup->map_size;
@@ -2353,7 +2329,9 @@ static void track_design_preview_restore_map(map_backup * backup)
 }
 
 /**
- * Resets all the map elements to surface tiles for track preview.
+ * Makes every tile read as a flat surface for the track preview. The park is
+ * not touched, the preview is placed on an overlay that only holds the tiles
+ * it uses.
  *  rct2: 0x006D1D9A
  */
 static void track_design_preview_clear_map()
@@ -2364,19 +2342,17 @@ static void track_design_preview_clear_map()
     gMapSizeMinus2 = (264 * 32) - 2;
     gMapSize       = 256;
 
-    for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
-    {
-        rct_tile_element * tile_element = &gTileElements[i];
-        tile_element->type                            = TILE_ELEMENT_TYPE_SURFACE;
-        tile_element->flags                           = TILE_ELEMENT_FLAG_LAST_TILE;
-        tile_element->base_height                     = 2;
-        tile_element->clearance_height                = 0;
-        tile_element->properties.surface.slope        = 0;
-        tile_element->properties.surface.terrain      = 0;
-        tile_element->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
-        tile_element->properties.surface.ownership    = OWNERSHIP_OWNED;
-    }
-    map_update_tile_pointers();
+    rct_tile_element tile_element = {};
+    tile_element.type                            = TILE_ELEMENT_TYPE_SURFACE;
+    tile_element.flags                           = TILE_ELEMENT_FLAG_LAST_TILE;
+    tile_element.base_height                     = 2;
+    tile_element.clearance_height                = 0;
+    tile_element.properties.surface.slope        = 0;
+    tile_element.properties.surface.terrain      = 0;
+    tile_element.properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
+    tile_element.properties.surface.ownership    = OWNERSHIP_OWNED;
+
+    map_overlay_begin(&tile_element);
 }
 
 bool track_design_are_entrance_and_exit_placed()
@@ -43,7 +43,9 @@ struct rct_s6_header {
     uint16 num_packed_objects;  // 0x02
     uint32 version;             // 0x04
     uint32 magic_number;        // 0x08
-    uint8 pad_0C[0x14];
+    uint16 num_extra_sprites;   // 0x0C OpenRCT2: sprites beyond RCT2_MAX_SPRITES, stored in a chunk after the RCT2 data
+    uint32 num_extra_tile_elements; // 0x0E OpenRCT2: tile elements beyond RCT2_MAX_TILE_ELEMENTS, stored likewise
+    uint8 pad_12[0x0E];
 };
 assert_struct_size(rct_s6_header, 0x20);
 
@@ -25,6 +25,7 @@
 #include "../network/network.h"
 
 #include "Banner.h"
+#include "FootpathGraph.h"
 #include "Map.h"
 #include "Park.h"
 #include "Scenery.h"
@@ -118,6 +119,7 @@ static money32 BannerRemove(sint16 x, sint16 y, uint8 baseHeight, uint8 directio
         tile_element_remove_banner_entry(tileElement);
         map_invalidate_tile_zoom1(x, y, z, z + 32);
         tile_element_remove(tileElement);
+        footpath_graph_invalidate_tile(x, y);
     }
 
     if (gParkFlags & PARK_FLAGS_NO_MONEY)
@@ -268,6 +270,7 @@ static money32 BannerPlace(sint16 x, sint16 y, uint8 pathBaseHeight, uint8 direc
         }
         map_invalidate_tile_full(x, y);
         map_animation_create(MAP_ANIMATION_TYPE_BANNER, x, y, newTileElement->base_height);
+        footpath_graph_invalidate_tile(x, y);
     }
 
     rct_scenery_entry *bannerEntry = get_banner_entry(type);
@@ -379,6 +382,7 @@ static money32 BannerSetStyle(uint8 bannerIndex, uint8 colour, uint8 textColour,
     {
         tileElement->properties.banner.flags &= ~(1 << tileElement->properties.banner.position);
     }
+    footpath_graph_invalidate_tile(banner->x * 32, banner->y * 32);
 
     sint32 colourCodepoint = FORMAT_COLOUR_CODE_START + banner->text_colour;
 
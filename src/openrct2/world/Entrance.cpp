@@ -47,6 +47,7 @@ static void ParkEntranceRemoveSegment(sint32 x, sint32 y, sint32 z)
 
     map_invalidate_tile(x, y, tileElement->base_height * 8, tileElement->clearance_height * 8);
     tile_element_remove(tileElement);
+    footpath_invalidate_tile(x, y);
     update_park_fences(x, y);
 }
 
@@ -27,6 +27,7 @@
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../util/Util.h"
+#include "FootpathGraph.h"
 #include "Map.h"
 
 void footpath_interrupt_peeps(sint32 x, sint32 y, sint32 z);
@@ -126,6 +127,9 @@ static rct_tile_element *map_get_footpath_element(sint32 x, sint32 y, sint32 z)
 {
     rct_tile_element *tileElement;
 
+    if (!map_tile_may_contain(x, y, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_PATH)))
+        return nullptr;
+
     tileElement = map_get_first_element_at(x, y);
     do {
         if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH && tileElement->base_height == z)
@@ -139,6 +143,9 @@ static rct_tile_element *map_get_footpath_element_slope(sint32 x, sint32 y, sint
 {
     rct_tile_element *tileElement;
 
+    if (!map_tile_may_contain(x, y, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_PATH)))
+        return nullptr;
+
     tileElement = map_get_first_element_at(x, y);
     do {
         if (
@@ -445,12 +452,17 @@ static money32 footpath_place_real(sint32 type, sint32 x, sint32 y, sint32 z, si
     }
 
     footpath_provisional_remove();
+    money32 cost;
     tileElement = map_get_footpath_element_slope((x / 32), (y / 32), z, slope);
     if (tileElement == nullptr) {
-        return footpath_element_insert(type, x, y, z, slope, flags, pathItemType);
+        cost = footpath_element_insert(type, x, y, z, slope, flags, pathItemType);
     } else {
-        return footpath_element_update(x, y, tileElement, type, flags, pathItemType);
+        cost = footpath_element_update(x, y, tileElement, type, flags, pathItemType);
     }
+
+    if ((flags & GAME_COMMAND_FLAG_APPLY) && cost != MONEY32_UNDEFINED)
+        footpath_invalidate_tile(x, y);
+    return cost;
 }
 
 /**
@@ -521,6 +533,7 @@ money32 footpath_remove_real(sint32 x, sint32 y, sint32 z, sint32 flags)
             map_invalidate_tile_full(x, y);
             tile_element_remove(footpathElement);
             footpath_update_queue_chains();
+            footpath_invalidate_tile(x, y);
         }
     }
 
@@ -670,6 +683,7 @@ static money32 footpath_place_from_track(sint32 type, sint32 x, sint32 y, sint32
                 tileElement->flags |= TILE_ELEMENT_FLAG_GHOST;
 
             map_invalidate_tile_full(x, y);
+            footpath_invalidate_tile(x, y);
         }
     }
 
@@ -823,6 +837,38 @@ void footpath_provisional_update()
  *      direction: ecx
  *      tileElement: edx
  */
+/**
+ * Returns the edges of a real path element that lead to the provisional footpath. The provisional footpath connects
+ * itself to the paths around it but leaves them unchanged, so these edges are only used for drawing.
+ */
+uint8 footpath_get_provisional_connections(sint32 x, sint32 y, const rct_tile_element * pathElement)
+{
+    if (!(gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_1) || tile_element_is_ghost(pathElement))
+        return 0;
+
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        if (x + TileDirectionDelta[direction].x != gFootpathProvisionalPosition.x ||
+            y + TileDirectionDelta[direction].y != gFootpathProvisionalPosition.y)
+            continue;
+
+        rct_tile_element * tileElement = map_get_first_element_at(gFootpathProvisionalPosition.x >> 5, gFootpathProvisionalPosition.y >> 5);
+        do
+        {
+            if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || !tile_element_is_ghost(tileElement))
+                continue;
+            if (!(tileElement->properties.path.edges & (1 << (direction ^ 2))))
+                continue;
+            if (abs(tileElement->base_height - pathElement->base_height) > 2)
+                continue;
+            return 1 << direction;
+        }
+        while (!tile_element_is_last_for_tile(tileElement++));
+        break;
+    }
+    return 0;
+}
+
 void footpath_get_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 *x, sint32 *y, sint32 *direction, rct_tile_element **tileElement)
 {
     sint32 z = 0, interactionType;
@@ -943,6 +989,10 @@ void footpath_bridge_get_info_from_pos(sint32 screenX, sint32 screenY, sint32 *x
  */
 void footpath_remove_litter(sint32 x, sint32 y, sint32 z)
 {
+    // Most tiles have no litter, which saves walking the sprites on them
+    if (litter_get_nearby((x & 0xFFE0) + 16, (y & 0xFFE0) + 16, 16).empty())
+        return;
+
     uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
     while (spriteIndex != SPRITE_INDEX_NULL) {
         rct_litter *sprite = &get_sprite(spriteIndex)->litter;
@@ -1023,12 +1073,29 @@ static bool map_is_edge(sint32 x, sint32 y)
     );
 }
 
-static rct_tile_element *footpath_connect_corners_get_neighbour(sint32 x, sint32 y, sint32 z, sint32 requireEdges)
+/**
+ * Ghost elements only exist on the client that placed them and stay on the map while the game runs, so real elements
+ * must never connect to them. Connecting a ghost looks at the real elements around it, but only ever changes ghosts.
+ */
+static bool footpath_ignores_element(const rct_tile_element * source, const rct_tile_element * tileElement)
+{
+    return tile_element_is_ghost(tileElement) && !tile_element_is_ghost(source);
+}
+
+static bool footpath_can_modify_element(const rct_tile_element * source, const rct_tile_element * tileElement)
+{
+    return tile_element_is_ghost(tileElement) || !tile_element_is_ghost(source);
+}
+
+static rct_tile_element *footpath_connect_corners_get_neighbour(
+    sint32 x, sint32 y, sint32 z, sint32 requireEdges, const rct_tile_element * source)
 {
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
             continue;
+        if (footpath_ignores_element(source, tileElement))
+            continue;
         if (footpath_element_is_queue(tileElement))
             continue;
         if (tileElement->base_height != z)
@@ -1067,14 +1134,14 @@ static void footpath_connect_corners(sint32 initialX, sint32 initialY, rct_tile_
 
         x += TileDirectionDelta[direction].x;
         y += TileDirectionDelta[direction].y;
-        tileElement[1] = footpath_connect_corners_get_neighbour(x, y, z, (1 << (direction ^ 2)));
+        tileElement[1] = footpath_connect_corners_get_neighbour(x, y, z, (1 << (direction ^ 2)), initialTileElement);
         if (tileElement[1] == nullptr)
             continue;
 
         direction = (direction + 1) & 3;
         x += TileDirectionDelta[direction].x;
         y += TileDirectionDelta[direction].y;
-        tileElement[2] = footpath_connect_corners_get_neighbour(x, y, z, (1 << (direction ^ 2)));
+        tileElement[2] = footpath_connect_corners_get_neighbour(x, y, z, (1 << (direction ^ 2)), initialTileElement);
         if (tileElement[2] == nullptr)
             continue;
 
@@ -1082,25 +1149,31 @@ static void footpath_connect_corners(sint32 initialX, sint32 initialY, rct_tile_
         x += TileDirectionDelta[direction].x;
         y += TileDirectionDelta[direction].y;
         // First check link to previous tile
-        tileElement[3] = footpath_connect_corners_get_neighbour(x, y, z, (1 << (direction ^ 2)));
+        tileElement[3] = footpath_connect_corners_get_neighbour(x, y, z, (1 << (direction ^ 2)), initialTileElement);
         if (tileElement[3] == nullptr)
             continue;
         // Second check link to initial tile
-        tileElement[3] = footpath_connect_corners_get_neighbour(x, y, z, (1 << ((direction + 1) & 3)));
+        tileElement[3] = footpath_connect_corners_get_neighbour(x, y, z, (1 << ((direction + 1) & 3)), initialTileElement);
         if (tileElement[3] == nullptr)
             continue;
 
         direction = (direction + 1) & 3;
-        tileElement[3]->properties.path.edges |= (1 << (direction + 4));
-        map_invalidate_element(x, y, tileElement[3]);
+        if (footpath_can_modify_element(initialTileElement, tileElement[3])) {
+            tileElement[3]->properties.path.edges |= (1 << (direction + 4));
+            map_invalidate_element(x, y, tileElement[3]);
+        }
 
         direction = (direction - 1) & 3;
-        tileElement[2]->properties.path.edges |= (1 << (direction + 4));
-        map_invalidate_element(x, y, tileElement[2]);
+        if (footpath_can_modify_element(initialTileElement, tileElement[2])) {
+            tileElement[2]->properties.path.edges |= (1 << (direction + 4));
+            map_invalidate_element(x, y, tileElement[2]);
+        }
 
         direction = (direction - 1) & 3;
-        tileElement[1]->properties.path.edges |= (1 << (direction + 4));
-        map_invalidate_element(x, y, tileElement[1]);
+        if (footpath_can_modify_element(initialTileElement, tileElement[1])) {
+            tileElement[1]->properties.path.edges |= (1 << (direction + 4));
+            map_invalidate_element(x, y, tileElement[1]);
+        }
 
         direction = initialDirection;
         tileElement[0]->properties.path.edges |= (1 << (direction + 4));
@@ -1217,7 +1290,8 @@ static bool sub_footpath_disconnect_queue_from_path(sint32 x, sint32 y, rct_tile
     sint32 y1 = y + TileDirectionDelta[direction].y;
     sint32 z = tileElement->base_height;
     rct_tile_element *otherTileElement = footpath_get_element(x1, y1, z - 2, z, direction);
-    if (otherTileElement != nullptr && !footpath_element_is_queue(otherTileElement)) {
+    if (otherTileElement != nullptr && !footpath_element_is_queue(otherTileElement) &&
+        tile_element_is_ghost(otherTileElement) == tile_element_is_ghost(tileElement)) {
         tileElement->properties.path.type &= ~FOOTPATH_PROPERTIES_SLOPE_DIRECTION_MASK;
         if (action > 0) {
             tileElement->properties.path.edges &= ~(1 << direction);
@@ -1275,6 +1349,9 @@ static void loc_6A6D7E(
     } else {
         rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
         do {
+            if (footpath_ignores_element(initialTileElement, tileElement))
+                continue;
+
             switch (tile_element_get_type(tileElement)) {
             case TILE_ELEMENT_TYPE_PATH:
                 if (z == tileElement->base_height) {
@@ -1319,7 +1396,8 @@ static void loc_6A6D7E(
                         if (query) {
                             neighbour_list_push(neighbourList, 8, direction, tileElement->properties.entrance.ride_index,  tileElement->properties.entrance.index);
                         } else {
-                            if (tileElement->properties.entrance.type != ENTRANCE_TYPE_PARK_ENTRANCE) {
+                            if (tileElement->properties.entrance.type != ENTRANCE_TYPE_PARK_ENTRANCE &&
+                                footpath_can_modify_element(initialTileElement, tileElement)) {
                                 footpath_queue_chain_push(tileElement->properties.entrance.ride_index);
                             }
                         }
@@ -1341,7 +1419,8 @@ static void loc_6A6D7E(
                     neighbour_list_push(neighbourList, 4, direction, tileElement->properties.path.ride_index, tileElement->properties.entrance.index);
                 } else {
                     if (tile_element_get_type(initialTileElement) == TILE_ELEMENT_TYPE_PATH &&
-                        footpath_element_is_queue(initialTileElement)) {
+                        footpath_element_is_queue(initialTileElement) &&
+                        footpath_can_modify_element(initialTileElement, tileElement)) {
                         if (footpath_disconnect_queue_from_path(x, y, tileElement, 0)) {
                             neighbour_list_push(neighbourList, 3, direction, tileElement->properties.path.ride_index, tileElement->properties.entrance.index);
                         }
@@ -1350,7 +1429,7 @@ static void loc_6A6D7E(
             } else {
                 neighbour_list_push(neighbourList, 2, direction, 255, 255);
             }
-        } else {
+        } else if (footpath_can_modify_element(initialTileElement, tileElement)) {
             footpath_disconnect_queue_from_path(x, y, tileElement, 1 + ((flags >> 6) & 1));
             tileElement->properties.path.edges |= (1 << (direction ^ 2));
             if (footpath_element_is_queue(tileElement)) {
@@ -1464,6 +1543,8 @@ void footpath_connect_edges(sint32 x, sint32 y, rct_tile_element *tileElement, s
     if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH) {
         footpath_connect_corners(x, y, tileElement);
     }
+
+    footpath_invalidate_tile(x, y);
 }
 
 /**
@@ -1478,6 +1559,8 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
     lastPathElement = nullptr;
     lastQueuePathElement = nullptr;
     sint32 z = tileElement->base_height;
+    // A queue only ever continues into elements of its own kind, see footpath_ignores_element
+    bool isGhost = tile_element_is_ghost(tileElement);
     for (;;) {
         if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH) {
             lastPathElement = tileElement;
@@ -1499,6 +1582,8 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
                 continue;
             if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
                 continue;
+            if (tile_element_is_ghost(tileElement) != isGhost)
+                continue;
             if (tileElement->base_height == z) {
                 if (footpath_element_is_sloped(tileElement)) {
                     if (footpath_element_get_slope_direction(tileElement) != direction)
@@ -1539,6 +1624,7 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
             tileElement->properties.path.additions |= (entranceIndex << 4) & FOOTPATH_PROPERTIES_ADDITIONS_STATION_INDEX_MASK;
 
             map_invalidate_element(x, y, tileElement);
+            footpath_invalidate_tile(x, y);
 
             if (lastQueuePathElement == nullptr) {
                 lastQueuePathElement = tileElement;
@@ -1574,6 +1660,15 @@ void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x,
     }
 }
 
+/**
+ * Must be called whenever a path on the tile or the edges leading to it change, x and y are in units.
+ */
+void footpath_invalidate_tile(sint32 x, sint32 y)
+{
+    footpath_graph_invalidate_tile(x, y);
+    map_invalidate_path_wide_flags(x / 32, y / 32);
+}
+
 void footpath_queue_chain_reset()
 {
     _footpathQueueChainNext = _footpathQueueChain;
@@ -1912,6 +2007,27 @@ static void footpath_clear_wide(sint32 x, sint32 y)
     while (!tile_element_is_last_for_tile(tileElement++));
 }
 
+/**
+ * Returns which of the elements on the tile are wide paths as a bit mask, or UINT64_MAX if the tile has too many
+ * elements to tell.
+ */
+static uint64 footpath_get_wide_flags(sint32 x, sint32 y)
+{
+    uint64 wideFlags = 0;
+    sint32 index = 0;
+    rct_tile_element *tileElement = map_get_first_element_at(x / 32, y / 32);
+    do
+    {
+        if (index == 64)
+            return UINT64_MAX;
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH && footpath_element_is_wide(tileElement))
+            wideFlags |= 1ULL << index;
+        index++;
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+    return wideFlags;
+}
+
 /**
 *
 *  rct2: 0x006A8ACF
@@ -1924,6 +2040,8 @@ static rct_tile_element* footpath_can_be_wide(sint32 x, sint32 y, uint8 height)
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
             continue;
+        if (tile_element_is_ghost(tileElement))
+            continue;
         if (height != tileElement->base_height)
             continue;
         if (footpath_element_is_queue(tileElement))
@@ -1940,18 +2058,20 @@ static rct_tile_element* footpath_can_be_wide(sint32 x, sint32 y, uint8 height)
 /**
 *
 *  rct2: 0x006A87BB
+*  returns whether any wide flag on the tile changed
 */
-void footpath_update_path_wide_flags(sint32 x, sint32 y)
+bool footpath_update_path_wide_flags(sint32 x, sint32 y)
 {
     if (x < 0x20)
-        return;
+        return false;
     if (y < 0x20)
-        return;
+        return false;
     if (x > 0x1FDF)
-        return;
+        return false;
     if (y > 0x1FDF)
-        return;
+        return false;
 
+    uint64 wideFlags = footpath_get_wide_flags(x, y);
     footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -1976,6 +2096,9 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
             continue;
 
+        if (tile_element_is_ghost(tileElement))
+            continue;
+
         if (footpath_element_is_queue(tileElement))
             continue;
 
@@ -2125,6 +2248,13 @@ void footpath_update_path_wide_flags(sint32 x, sint32 y)
                 footpath_element_set_wide(tileElement, true);
         }
     } while (!tile_element_is_last_for_tile(tileElement++));
+
+    // Peeps search wide paths differently
+    if (wideFlags == UINT64_MAX || footpath_get_wide_flags(x, y) != wideFlags) {
+        gMapModificationGeneration++;
+        return true;
+    }
+    return false;
 }
 
 /**
@@ -2137,7 +2267,8 @@ void footpath_update_queue_entrance_banner(sint32 x, sint32 y, rct_tile_element
     switch (elementType) {
     case TILE_ELEMENT_TYPE_PATH:
         if (footpath_element_is_queue(tileElement)) {
-            footpath_queue_chain_push(tileElement->properties.path.ride_index);
+            if (!tile_element_is_ghost(tileElement))
+                footpath_queue_chain_push(tileElement->properties.path.ride_index);
             for (sint32 direction = 0; direction < 4; direction++) {
                 if (tileElement->properties.path.edges & (1 << direction)) {
                     footpath_chain_ride_queue(255, 0, x, y, tileElement, direction);
@@ -2148,7 +2279,8 @@ void footpath_update_queue_entrance_banner(sint32 x, sint32 y, rct_tile_element
         break;
     case TILE_ELEMENT_TYPE_ENTRANCE:
         if (tileElement->properties.entrance.type == ENTRANCE_TYPE_RIDE_ENTRANCE) {
-            footpath_queue_chain_push(tileElement->properties.entrance.ride_index);
+            if (!tile_element_is_ghost(tileElement))
+                footpath_queue_chain_push(tileElement->properties.entrance.ride_index);
             footpath_chain_ride_queue(255, 0, x, y, tileElement, tile_element_get_direction_with_offset(tileElement, 2));
         }
         break;
@@ -2159,7 +2291,9 @@ void footpath_update_queue_entrance_banner(sint32 x, sint32 y, rct_tile_element
  *
  *  rct2: 0x006A6B7F
  */
-static void footpath_remove_edges_towards_here(sint32 x, sint32 y, sint32 z, sint32 direction, rct_tile_element *tileElement, bool isQueue)
+static void footpath_remove_edges_towards_here(
+    sint32 x, sint32 y, sint32 z, sint32 direction, rct_tile_element *tileElement, const rct_tile_element * source,
+    bool isQueue)
 {
     sint32 d;
 
@@ -2187,6 +2321,8 @@ static void footpath_remove_edges_towards_here(sint32 x, sint32 y, sint32 z, sin
             continue;
         if (tileElement->base_height != z)
             continue;
+        if (!footpath_can_modify_element(source, tileElement))
+            continue;
 
         if (footpath_element_is_sloped(tileElement))
             break;
@@ -2202,7 +2338,8 @@ static void footpath_remove_edges_towards_here(sint32 x, sint32 y, sint32 z, sin
  *
  *  rct2: 0x006A6B14
  */
-static void footpath_remove_edges_towards(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 direction, bool isQueue)
+static void footpath_remove_edges_towards(
+    sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 direction, const rct_tile_element * source, bool isQueue)
 {
     rct_tile_element *tileElement;
     sint32 slope;
@@ -2211,6 +2348,11 @@ static void footpath_remove_edges_towards(sint32 x, sint32 y, sint32 z0, sint32
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
             continue;
+        if (!footpath_can_modify_element(source, tileElement)) {
+            // Still redraw it as it may have been drawn connected to the ghost
+            map_invalidate_element(x, y, tileElement);
+            continue;
+        }
 
         if (z1 == tileElement->base_height) {
             if (footpath_element_is_sloped(tileElement)) {
@@ -2218,7 +2360,7 @@ static void footpath_remove_edges_towards(sint32 x, sint32 y, sint32 z0, sint32
                 if (slope != direction)
                     break;
             }
-            footpath_remove_edges_towards_here(x, y, z1, direction, tileElement, isQueue);
+            footpath_remove_edges_towards_here(x, y, z1, direction, tileElement, source, isQueue);
             break;
         }
         if (z0 == tileElement->base_height) {
@@ -2229,7 +2371,7 @@ static void footpath_remove_edges_towards(sint32 x, sint32 y, sint32 z0, sint32
             if (slope != direction)
                 break;
 
-            footpath_remove_edges_towards_here(x, y, z1, direction, tileElement, isQueue);
+            footpath_remove_edges_towards_here(x, y, z1, direction, tileElement, source, isQueue);
             break;
         }
     } while (!tile_element_is_last_for_tile(tileElement++));
@@ -2265,11 +2407,13 @@ void footpath_remove_edges_at(sint32 x, sint32 y, rct_tile_element *tileElement)
         }
         sint32 z0 = z1 - 2;
         footpath_remove_edges_towards(x + TileDirectionDelta[direction].x, y + TileDirectionDelta[direction].y,
-            z0, z1, direction, footpath_element_is_queue(tileElement));
+            z0, z1, direction, tileElement, footpath_element_is_queue(tileElement));
     }
 
     if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH)
         tileElement->properties.path.edges = 0;
+
+    footpath_invalidate_tile(x, y);
 }
 
 rct_footpath_entry *get_footpath_entry(sint32 entryIndex)
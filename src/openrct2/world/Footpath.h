@@ -136,6 +136,7 @@ void footpath_remove(sint32 x, sint32 y, sint32 z, sint32 flags);
 money32 footpath_provisional_set(sint32 type, sint32 x, sint32 y, sint32 z, sint32 slope);
 void footpath_provisional_remove();
 void footpath_provisional_update();
+uint8 footpath_get_provisional_connections(sint32 x, sint32 y, const rct_tile_element * pathElement);
 void footpath_get_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 * x, sint32 * y, sint32 * direction, rct_tile_element ** tileElement);
 void footpath_bridge_get_info_from_pos(sint32 screenX, sint32 screenY, sint32 * x, sint32 * y, sint32 * direction, rct_tile_element ** tileElement);
 void footpath_remove_litter(sint32 x, sint32 y, sint32 z);
@@ -143,7 +144,8 @@ void footpath_connect_edges(sint32 x, sint32 y, rct_tile_element * tileElement,
 void footpath_update_queue_chains();
 bool fence_in_the_way(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 direction);
 void footpath_chain_ride_queue(sint32 rideIndex, sint32 entranceIndex, sint32 x, sint32 y, rct_tile_element * tileElement, sint32 direction);
-void footpath_update_path_wide_flags(sint32 x, sint32 y);
+bool footpath_update_path_wide_flags(sint32 x, sint32 y);
+void footpath_invalidate_tile(sint32 x, sint32 y);
 
 sint32 footpath_is_connected_to_map_edge(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 flags);
 bool footpath_element_is_sloped(const rct_tile_element * tileElement);
@@ -0,0 +1,724 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "../peep/Peep.h"
+#include "../util/Util.h"
+#include "Footpath.h"
+#include "FootpathGraph.h"
+#include "Map.h"
+
+// Tiles are identified by their tile coordinates and the base height of the path or entrance
+using path_graph_key = uint64;
+
+static constexpr path_graph_key FOOTPATH_GRAPH_ENTRANCE_KEY = 1ULL << 40;
+static constexpr uint32 FOOTPATH_GRAPH_UNREACHABLE = 0xFFFFFFFF;
+static constexpr size_t FOOTPATH_GRAPH_MAX_DISTANCE_FIELDS = 64;
+
+/**
+ * The path elements at one height of a tile, merged the same way as peep_pathfind_choose_direction() does.
+ */
+struct path_graph_tile
+{
+    path_graph_key key;
+    uint8          connected;      // Edges that lead onto another path tile
+    uint8          guestEdges;     // Edges not blocked by a no entry banner
+    uint8          entrances;      // Edges that lead onto a ride entrance, ride exit or park entrance
+    uint8          queueRideIndex; // The ride of a queue, 255 for any other path
+    path_graph_key neighbours[4];
+};
+
+struct path_graph_run
+{
+    path_graph_key target;
+    uint32         length;
+    uint8          targetQueueRideIndex;
+    bool           valid;
+    bool           guestBlocked;        // A no entry banner stops guests walking to the target
+    bool           reverseValid;        // The run can also be walked from the target back to the start
+    bool           reverseGuestBlocked; // A no entry banner stops guests walking back from the target
+};
+
+/**
+ * A path node has a run along each edge that leads onto another path or onto an entrance. An entrance node has a run
+ * of length 1 to each path that leads onto it, which guests can only walk in reverse.
+ */
+struct path_graph_node
+{
+    uint8          connected;      // Edges with a run
+    uint8          queueRideIndex;
+    uint8          entranceType;   // The type of an entrance node, 255 for a path node
+    path_graph_run runs[4];
+};
+
+/**
+ * Shortest distances in steps from the nodes of the graph to a goal, for one set of query parameters.
+ */
+struct path_graph_distance_field
+{
+    footpath_graph_query                       query;
+    std::unordered_map<path_graph_key, uint32> seeds;
+    std::unordered_map<path_graph_key, uint32> distances;
+};
+
+static std::unordered_map<path_graph_key, path_graph_node>     _nodes;
+static std::unordered_map<uint32, std::vector<path_graph_key>> _tileNodes;
+static std::vector<std::unique_ptr<path_graph_distance_field>> _distanceFields;
+
+static path_graph_key footpath_graph_make_key(sint32 tileX, sint32 tileY, uint8 z)
+{
+    return ((uint64)(uint16)tileX << 24) | ((uint64)(uint16)tileY << 8) | z;
+}
+
+static path_graph_key footpath_graph_make_entrance_key(sint32 tileX, sint32 tileY, uint8 z)
+{
+    return footpath_graph_make_key(tileX, tileY, z) | FOOTPATH_GRAPH_ENTRANCE_KEY;
+}
+
+static bool footpath_graph_is_entrance_key(path_graph_key key)
+{
+    return (key & FOOTPATH_GRAPH_ENTRANCE_KEY) != 0;
+}
+
+static sint32 footpath_graph_key_get_x(path_graph_key key)
+{
+    return (sint32)((key >> 24) & 0xFFFF);
+}
+
+static sint32 footpath_graph_key_get_y(path_graph_key key)
+{
+    return (sint32)((key >> 8) & 0xFFFF);
+}
+
+static uint8 footpath_graph_key_get_z(path_graph_key key)
+{
+    return (uint8)(key & 0xFF);
+}
+
+static uint32 footpath_graph_tile_index(sint32 tileX, sint32 tileY)
+{
+    return ((uint32)(uint16)tileX << 16) | (uint16)tileY;
+}
+
+static bool footpath_graph_is_foreign_queue(const footpath_graph_query * query, uint8 queueRideIndex)
+{
+    return query->ignoreForeignQueues && queueRideIndex != 255 && queueRideIndex != query->queueRideIndex;
+}
+
+static rct_tile_element * footpath_graph_get_first_element(sint32 tileX, sint32 tileY)
+{
+    if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return nullptr;
+    return map_get_first_element_at(tileX, tileY);
+}
+
+static rct_tile_element * footpath_graph_get_entrance_element(sint32 tileX, sint32 tileY, uint8 z)
+{
+    rct_tile_element * tileElement = footpath_graph_get_first_element(tileX, tileY);
+    if (tileElement == nullptr)
+        return nullptr;
+
+    do
+    {
+        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_ENTRANCE || (tileElement->flags & TILE_ELEMENT_FLAG_GHOST))
+            continue;
+        if (tileElement->base_height == z)
+            return tileElement;
+    } while (!tile_element_is_last_for_tile(tileElement++));
+    return nullptr;
+}
+
+/**
+ * Removes the edges blocked by no entry banners, the same way the peep pathfinding does.
+ */
+static uint8 footpath_graph_clear_banner_edges(rct_tile_element * pathElement, uint8 edges)
+{
+    rct_tile_element * tileElement = pathElement;
+    while (!tile_element_is_last_for_tile(tileElement++))
+    {
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tileElement))
+            break;
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_BANNER)
+            edges &= tileElement->properties.banner.flags;
+    }
+    return edges;
+}
+
+static bool footpath_graph_get_tile(path_graph_key key, path_graph_tile * outTile)
+{
+    sint32 tileX = footpath_graph_key_get_x(key);
+    sint32 tileY = footpath_graph_key_get_y(key);
+    uint8  z     = footpath_graph_key_get_z(key);
+
+    rct_tile_element * tileElement = footpath_graph_get_first_element(tileX, tileY);
+    if (tileElement == nullptr)
+        return false;
+
+    *outTile                = {};
+    outTile->key            = key;
+    outTile->queueRideIndex = 255;
+
+    rct_tile_element * firstElement = nullptr;
+    uint8              edges        = 0;
+    do
+    {
+        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+            continue;
+        if (tileElement->base_height != z)
+            continue;
+
+        if (firstElement == nullptr)
+        {
+            firstElement = tileElement;
+            if (footpath_element_is_queue(tileElement))
+                outTile->queueRideIndex = tileElement->properties.path.ride_index;
+        }
+
+        uint8 pathEdges = tileElement->properties.path.edges & 0x0F;
+        edges |= pathEdges;
+        outTile->guestEdges |= footpath_graph_clear_banner_edges(tileElement, pathEdges);
+    } while (!tile_element_is_last_for_tile(tileElement++));
+
+    if (firstElement == nullptr)
+        return false;
+
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        if (!(edges & (1 << direction)))
+            continue;
+
+        sint32 nextZ = z;
+        if (footpath_element_is_sloped(firstElement) && footpath_element_get_slope_direction(firstElement) == direction)
+            nextZ += 2;
+
+        sint32 nextX = tileX + TileDirectionDelta[direction].x / 32;
+        sint32 nextY = tileY + TileDirectionDelta[direction].y / 32;
+        rct_tile_element * nextElement = footpath_graph_get_first_element(nextX, nextY);
+        if (nextElement == nullptr)
+            continue;
+
+        do
+        {
+            if (tile_element_get_type(nextElement) != TILE_ELEMENT_TYPE_PATH)
+                continue;
+            if (nextElement->flags & TILE_ELEMENT_FLAG_GHOST)
+                continue;
+            if (!is_valid_path_z_and_direction(nextElement, nextZ, direction))
+                continue;
+
+            outTile->connected |= 1 << direction;
+            outTile->neighbours[direction] = footpath_graph_make_key(nextX, nextY, nextElement->base_height);
+            break;
+        } while (!tile_element_is_last_for_tile(nextElement++));
+
+        if (!(outTile->connected & (1 << direction)) && footpath_graph_get_entrance_element(nextX, nextY, nextZ) != nullptr)
+        {
+            outTile->entrances |= 1 << direction;
+            outTile->neighbours[direction] = footpath_graph_make_entrance_key(nextX, nextY, nextZ);
+        }
+    }
+    return true;
+}
+
+/**
+ * A tile is a node unless it is a piece of path with exactly two connections, both of which lead to tiles that
+ * connect back to it and have the same queue, and no edge that leads onto an entrance.
+ */
+static bool footpath_graph_is_node(const path_graph_tile * tile)
+{
+    if (bitcount(tile->connected) != 2 || tile->entrances != 0)
+        return true;
+
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        if (!(tile->connected & (1 << direction)))
+            continue;
+
+        path_graph_tile neighbour;
+        if (!footpath_graph_get_tile(tile->neighbours[direction], &neighbour))
+            return true;
+        if (!(neighbour.connected & (1 << (direction ^ 2))) || neighbour.neighbours[direction ^ 2] != tile->key)
+            return true;
+        if (neighbour.queueRideIndex != tile->queueRideIndex)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Follows the path from start in the given direction until the next node.
+ * When a distance field is given, outSeedLength receives the shortest distance to its goal through a seed passed on
+ * the way.
+ */
+static path_graph_run footpath_graph_walk(const path_graph_tile * start, sint32 direction,
+                                          const path_graph_distance_field * field, uint32 * outSeedLength,
+                                          std::vector<path_graph_key> * visitedTiles)
+{
+    path_graph_run run = {};
+    run.reverseValid   = true;
+
+    path_graph_tile current = *start;
+    for (uint32 length = 1;; length++)
+    {
+        if (!(current.guestEdges & (1 << direction)))
+            run.guestBlocked = true;
+
+        path_graph_tile next;
+        if (!footpath_graph_get_tile(current.neighbours[direction], &next))
+            return run;
+
+        if (!(next.connected & (1 << (direction ^ 2))) || next.neighbours[direction ^ 2] != current.key)
+            run.reverseValid = false;
+        if (!(next.guestEdges & (1 << (direction ^ 2))))
+            run.reverseGuestBlocked = true;
+        if (visitedTiles != nullptr)
+            visitedTiles->push_back(next.key);
+
+        if (field != nullptr)
+        {
+            if ((run.guestBlocked && !field->query.ignoreBanners) ||
+                footpath_graph_is_foreign_queue(&field->query, next.queueRideIndex))
+            {
+                // Seeds further along can not be reached
+                field = nullptr;
+            }
+            else
+            {
+                auto seed = field->seeds.find(next.key);
+                if (seed != field->seeds.end())
+                    *outSeedLength = std::min(*outSeedLength, length + seed->second);
+            }
+        }
+
+        // A loop without any junctions
+        if (next.key == start->key)
+            return run;
+
+        if (!run.reverseValid || footpath_graph_is_node(&next))
+        {
+            run.target               = next.key;
+            run.length               = length;
+            run.targetQueueRideIndex = next.queueRideIndex;
+            run.valid                = true;
+            return run;
+        }
+
+        direction = bitscanforward(next.connected & ~(1 << (direction ^ 2)));
+        current   = next;
+    }
+}
+
+static void footpath_graph_register_tile(path_graph_key tileKey, path_graph_key nodeKey)
+{
+    auto &nodes = _tileNodes[footpath_graph_tile_index(footpath_graph_key_get_x(tileKey), footpath_graph_key_get_y(tileKey))];
+    if (std::find(nodes.begin(), nodes.end(), nodeKey) == nodes.end())
+        nodes.push_back(nodeKey);
+}
+
+/**
+ * Finds the paths that lead onto the entrance, the same way a guest heading for it would look for them.
+ */
+static bool footpath_graph_build_entrance_node(path_graph_key key, path_graph_node * outNode,
+                                               std::vector<path_graph_key> * visitedTiles)
+{
+    sint32 entranceX = footpath_graph_key_get_x(key);
+    sint32 entranceY = footpath_graph_key_get_y(key);
+    uint8  entranceZ = footpath_graph_key_get_z(key);
+
+    rct_tile_element * entranceElement = footpath_graph_get_entrance_element(entranceX, entranceY, entranceZ);
+    if (entranceElement == nullptr)
+        return false;
+
+    *outNode                = {};
+    outNode->queueRideIndex = 255;
+    outNode->entranceType   = entranceElement->properties.entrance.type;
+
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        sint32 tileX = entranceX - TileDirectionDelta[direction].x / 32;
+        sint32 tileY = entranceY - TileDirectionDelta[direction].y / 32;
+        rct_tile_element * tileElement = footpath_graph_get_first_element(tileX, tileY);
+        if (tileElement == nullptr)
+            continue;
+
+        do
+        {
+            if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || (tileElement->flags & TILE_ELEMENT_FLAG_GHOST))
+                continue;
+
+            uint8 edges = tileElement->properties.path.edges & 0x0F;
+            if (!(edges & (1 << direction)))
+                continue;
+
+            sint32 z = tileElement->base_height;
+            if (footpath_element_is_sloped(tileElement) && footpath_element_get_slope_direction(tileElement) == direction)
+                z += 2;
+            if (z != entranceZ)
+                continue;
+
+            path_graph_run * run      = &outNode->runs[direction ^ 2];
+            run->target               = footpath_graph_make_key(tileX, tileY, tileElement->base_height);
+            run->length               = 1;
+            run->targetQueueRideIndex = footpath_element_is_queue(tileElement) ? tileElement->properties.path.ride_index : 255;
+            run->valid                = true;
+            run->reverseValid         = true;
+            run->reverseGuestBlocked  = !(footpath_graph_clear_banner_edges(tileElement, edges) & (1 << direction));
+            outNode->connected |= 1 << (direction ^ 2);
+            visitedTiles->push_back(run->target);
+            break;
+        } while (!tile_element_is_last_for_tile(tileElement++));
+    }
+    return true;
+}
+
+static const path_graph_node * footpath_graph_get_node(path_graph_key key)
+{
+    auto it = _nodes.find(key);
+    if (it != _nodes.end())
+        return &it->second;
+
+    path_graph_node node = {};
+    std::vector<path_graph_key> visitedTiles = { key };
+    if (footpath_graph_is_entrance_key(key))
+    {
+        if (!footpath_graph_build_entrance_node(key, &node, &visitedTiles))
+            return nullptr;
+    }
+    else
+    {
+        path_graph_tile tile;
+        if (!footpath_graph_get_tile(key, &tile))
+            return nullptr;
+
+        node.connected      = tile.connected | tile.entrances;
+        node.queueRideIndex = tile.queueRideIndex;
+        node.entranceType   = 255;
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            if (tile.connected & (1 << direction))
+            {
+                node.runs[direction] = footpath_graph_walk(&tile, direction, nullptr, nullptr, &visitedTiles);
+            }
+            else if (tile.entrances & (1 << direction))
+            {
+                path_graph_run * run       = &node.runs[direction];
+                run->target                = tile.neighbours[direction];
+                run->length                = 1;
+                run->targetQueueRideIndex  = 255;
+                run->valid                 = true;
+                run->guestBlocked          = !(tile.guestEdges & (1 << direction));
+                visitedTiles.push_back(run->target);
+            }
+        }
+    }
+
+    for (path_graph_key visitedTile : visitedTiles)
+    {
+        footpath_graph_register_tile(visitedTile, key);
+    }
+    return &(_nodes[key] = node);
+}
+
+/**
+ * Finds the path tiles a guest heading for the goal aims for: the path on the goal tile itself, or the paths leading
+ * onto a goal that is not a path (e.g. a park entrance).
+ */
+static void footpath_graph_find_seeds(path_graph_distance_field * field)
+{
+    const footpath_graph_query * query = &field->query;
+    sint32 goalX = query->goal.x / 32;
+    sint32 goalY = query->goal.y / 32;
+    sint32 goalZ = query->goal.z;
+
+    rct_tile_element * tileElement = footpath_graph_get_first_element(goalX, goalY);
+    if (tileElement == nullptr)
+        return;
+
+    do
+    {
+        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || (tileElement->flags & TILE_ELEMENT_FLAG_GHOST))
+            continue;
+        if (tileElement->base_height == goalZ || (footpath_element_is_sloped(tileElement) && tileElement->base_height + 2 == goalZ))
+            field->seeds[footpath_graph_make_key(goalX, goalY, tileElement->base_height)] = 0;
+    } while (!tile_element_is_last_for_tile(tileElement++));
+
+    if (!field->seeds.empty())
+        return;
+
+    // The paths leading onto an entrance are known to its node
+    const path_graph_node * entranceNode = footpath_graph_get_node(footpath_graph_make_entrance_key(goalX, goalY, goalZ));
+    if (entranceNode != nullptr)
+    {
+        for (const path_graph_run &run : entranceNode->runs)
+        {
+            if (run.valid && (query->ignoreBanners || !run.reverseGuestBlocked))
+                field->seeds[run.target] = run.length;
+        }
+        return;
+    }
+
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        sint32 tileX = goalX - TileDirectionDelta[direction].x / 32;
+        sint32 tileY = goalY - TileDirectionDelta[direction].y / 32;
+        tileElement  = footpath_graph_get_first_element(tileX, tileY);
+        if (tileElement == nullptr)
+            continue;
+
+        do
+        {
+            if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || (tileElement->flags & TILE_ELEMENT_FLAG_GHOST))
+                continue;
+
+            uint8 edges = tileElement->properties.path.edges & 0x0F;
+            if (!query->ignoreBanners)
+                edges = footpath_graph_clear_banner_edges(tileElement, edges);
+            if (!(edges & (1 << direction)))
+                continue;
+
+            sint32 z = tileElement->base_height;
+            if (footpath_element_is_sloped(tileElement) && footpath_element_get_slope_direction(tileElement) == direction)
+                z += 2;
+            if (z == goalZ)
+                field->seeds[footpath_graph_make_key(tileX, tileY, tileElement->base_height)] = 1;
+        } while (!tile_element_is_last_for_tile(tileElement++));
+    }
+}
+
+/**
+ * Computes the distance of every node that can reach the goal by searching backwards from the goal.
+ */
+static void footpath_graph_compute_distances(path_graph_distance_field * field)
+{
+    using queue_entry = std::pair<uint32, path_graph_key>;
+    std::priority_queue<queue_entry, std::vector<queue_entry>, std::greater<queue_entry>> queue;
+    const footpath_graph_query * query = &field->query;
+
+    auto relax = [field, &queue](path_graph_key key, uint32 distance) -> void {
+        auto it = field->distances.find(key);
+        if (it == field->distances.end() || distance < it->second)
+        {
+            field->distances[key] = distance;
+            queue.emplace(distance, key);
+        }
+    };
+
+    for (const auto &seed : field->seeds)
+    {
+        path_graph_tile tile;
+        if (!footpath_graph_get_tile(seed.first, &tile))
+            continue;
+
+        if (footpath_graph_is_node(&tile))
+        {
+            relax(seed.first, seed.second);
+            continue;
+        }
+
+        // The seed lies within a run, so the nodes at both of its ends lead to it
+        if (footpath_graph_is_foreign_queue(query, tile.queueRideIndex))
+            continue;
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            if (!(tile.connected & (1 << direction)))
+                continue;
+
+            path_graph_run run = footpath_graph_walk(&tile, direction, nullptr, nullptr, nullptr);
+            if (run.valid && run.reverseValid && (query->ignoreBanners || !run.reverseGuestBlocked))
+                relax(run.target, seed.second + run.length);
+        }
+    }
+
+    while (!queue.empty())
+    {
+        queue_entry entry = queue.top();
+        queue.pop();
+        if (entry.first != field->distances[entry.second])
+            continue;
+
+        const path_graph_node * node = footpath_graph_get_node(entry.second);
+        if (node == nullptr || footpath_graph_is_foreign_queue(query, node->queueRideIndex))
+            continue;
+
+        for (const path_graph_run &run : node->runs)
+        {
+            // Guests do not walk through an entrance to get to the paths on its other side
+            if (footpath_graph_is_entrance_key(run.target))
+                continue;
+            if (run.valid && run.reverseValid && (query->ignoreBanners || !run.reverseGuestBlocked))
+                relax(run.target, entry.first + run.length);
+        }
+    }
+}
+
+static const path_graph_distance_field * footpath_graph_get_distance_field(const footpath_graph_query * query)
+{
+    for (const auto &field : _distanceFields)
+    {
+        const footpath_graph_query * fieldQuery = &field->query;
+        if (fieldQuery->goal.x == query->goal.x && fieldQuery->goal.y == query->goal.y &&
+            fieldQuery->goal.z == query->goal.z && fieldQuery->queueRideIndex == query->queueRideIndex &&
+            fieldQuery->ignoreForeignQueues == query->ignoreForeignQueues &&
+            fieldQuery->ignoreBanners == query->ignoreBanners)
+        {
+            return field.get();
+        }
+    }
+
+    if (_distanceFields.size() >= FOOTPATH_GRAPH_MAX_DISTANCE_FIELDS)
+        _distanceFields.clear();
+
+    auto field   = std::make_unique<path_graph_distance_field>();
+    field->query = *query;
+    footpath_graph_find_seeds(field.get());
+    footpath_graph_compute_distances(field.get());
+    _distanceFields.push_back(std::move(field));
+    return _distanceFields.back().get();
+}
+
+void footpath_graph_reset()
+{
+    gMapModificationGeneration++;
+    _nodes.clear();
+    _tileNodes.clear();
+    _distanceFields.clear();
+}
+
+/**
+ * Drops every node whose runs pass within two tiles of x, y. Called whenever the paths, queues or banners on the tile
+ * change, which may also have changed the edges of the paths next to it.
+ */
+void footpath_graph_invalidate_tile(sint32 x, sint32 y)
+{
+    // The same changes matter to the cached results of the heuristic search
+    gMapModificationGeneration++;
+
+    sint32 tileX = x / 32;
+    sint32 tileY = y / 32;
+    for (sint32 offsetY = -2; offsetY <= 2; offsetY++)
+    {
+        for (sint32 offsetX = -2; offsetX <= 2; offsetX++)
+        {
+            auto it = _tileNodes.find(footpath_graph_tile_index(tileX + offsetX, tileY + offsetY));
+            if (it == _tileNodes.end())
+                continue;
+
+            for (path_graph_key nodeKey : it->second)
+            {
+                _nodes.erase(nodeKey);
+            }
+            _tileNodes.erase(it);
+        }
+    }
+    _distanceFields.clear();
+}
+
+/**
+ * Describes the node of the path at the given tile and height or, if entrance is set, that of the ride entrance, ride
+ * exit or park entrance there. Returns false if there is no such node.
+ */
+bool footpath_graph_get_node_info(sint32 tileX, sint32 tileY, sint32 z, bool entrance, footpath_graph_node_info * outInfo)
+{
+    path_graph_key key = footpath_graph_make_key(tileX, tileY, z);
+    if (entrance)
+    {
+        key |= FOOTPATH_GRAPH_ENTRANCE_KEY;
+    }
+    else
+    {
+        path_graph_tile tile;
+        if (!footpath_graph_get_tile(key, &tile) || !footpath_graph_is_node(&tile))
+            return false;
+    }
+
+    const path_graph_node * node = footpath_graph_get_node(key);
+    if (node == nullptr)
+        return false;
+
+    *outInfo = {};
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        const path_graph_run &run = node->runs[direction];
+        if (!run.valid)
+            continue;
+
+        footpath_graph_edge * edge = &outInfo->edgesTo[direction];
+        edge->target               = { footpath_graph_key_get_x(run.target), footpath_graph_key_get_y(run.target),
+                                       footpath_graph_key_get_z(run.target) };
+        edge->length               = run.length;
+        edge->targetIsEntrance     = footpath_graph_is_entrance_key(run.target);
+        outInfo->edges |= 1 << direction;
+    }
+    return true;
+}
+
+/**
+ * Returns the edge out of the path at x, y, z that starts the shortest walk to the goal, choosing the lowest
+ * direction when several are equally short, or -1 if the goal can not be reached along any of the given edges.
+ */
+sint32 footpath_graph_choose_direction(sint32 x, sint32 y, sint32 z, uint8 edges, const footpath_graph_query * query)
+{
+    path_graph_tile tile;
+    if (!footpath_graph_get_tile(footpath_graph_make_key(x / 32, y / 32, z), &tile))
+        return -1;
+
+    // An edge that leads straight onto the goal entrance is always the shortest
+    path_graph_key goalEntranceKey = footpath_graph_make_entrance_key(query->goal.x / 32, query->goal.y / 32, query->goal.z);
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        if ((edges & tile.entrances & (1 << direction)) && tile.neighbours[direction] == goalEntranceKey &&
+            (query->ignoreBanners || (tile.guestEdges & (1 << direction))))
+        {
+            return direction;
+        }
+    }
+
+    const path_graph_distance_field * field = footpath_graph_get_distance_field(query);
+    if (field->seeds.empty())
+        return -1;
+
+    sint32 bestDirection = -1;
+    uint32 bestDistance  = FOOTPATH_GRAPH_UNREACHABLE;
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        if (!(edges & tile.connected & (1 << direction)))
+            continue;
+
+        uint32         distance = FOOTPATH_GRAPH_UNREACHABLE;
+        path_graph_run run      = footpath_graph_walk(&tile, direction, field, &distance, nullptr);
+        if (run.valid && (query->ignoreBanners || !run.guestBlocked) &&
+            !footpath_graph_is_foreign_queue(query, run.targetQueueRideIndex))
+        {
+            auto it = field->distances.find(run.target);
+            if (it != field->distances.end())
+                distance = std::min(distance, run.length + it->second);
+        }
+
+        if (distance < bestDistance)
+        {
+            bestDirection = direction;
+            bestDistance  = distance;
+        }
+    }
+    return bestDirection;
+}
@@ -0,0 +1,52 @@
+#pragma region Copyright (c) 2014-2018 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include "../common.h"
+#include "Location.h"
+
+/**
+ * The footpath network as a graph of junctions. Nodes are path tiles that are not simply part of a line of path
+ * (junctions, dead ends, the ends of queues and paths leading onto an entrance) and the ride entrances, ride exits and
+ * park entrances that paths lead onto. Edges are the runs of path between them.
+ * Nodes are built on demand and dropped again when a footpath or entrance on or next to one of their tiles changes.
+ */
+struct footpath_graph_query
+{
+    LocationXYZ16 goal;
+    uint8         queueRideIndex;
+    bool          ignoreForeignQueues;
+    bool          ignoreBanners;
+};
+
+struct footpath_graph_edge
+{
+    TileCoordsXYZ target;
+    uint32        length;
+    bool          targetIsEntrance;
+};
+
+struct footpath_graph_node_info
+{
+    uint8               edges; // Directions with an edge
+    footpath_graph_edge edgesTo[4];
+};
+
+void footpath_graph_reset();
+void footpath_graph_invalidate_tile(sint32 x, sint32 y);
+bool footpath_graph_get_node_info(sint32 tileX, sint32 tileY, sint32 z, bool entrance, footpath_graph_node_info * outInfo);
+sint32 footpath_graph_choose_direction(sint32 x, sint32 y, sint32 z, uint8 edges, const footpath_graph_query * query);
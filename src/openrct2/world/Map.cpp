@@ -18,6 +18,7 @@
 #include "../Cheats.h"
 #include "../config/Config.h"
 #include "../Context.h"
+#include "../core/Guard.hpp"
 #include "../core/Math.hpp"
 #include "../core/Util.hpp"
 #include "../Game.h"
@@ -29,6 +30,7 @@
 #include "../management/Finance.h"
 #include "../network/network.h"
 #include "../OpenRCT2.h"
+#include "../paint/PaintCache.h"
 #include "../ride/RideData.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
@@ -38,6 +40,7 @@
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "Map.h"
 #include "MapAnimation.h"
@@ -47,7 +50,11 @@
 #include "TileInspector.h"
 #include "Wall.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <memory>
+#include <vector>
 
 /**
  * Replaces 0x00993CCC, 0x00993CCE
@@ -94,9 +101,16 @@ bool            gMapVirtualFloorVisible = false;
 
 uint8 gMapGroundFlags;
 
+// Only kept for the save format, map_update_path_wide_flags works through the changed tiles instead
 uint16 gWidePathTileLoopX;
 uint16 gWidePathTileLoopY;
 uint16 gGrassSceneryTileLoopPosition;
+// Whether the current cycle of the grass and scenery tile loop is updated in blocks, and the steps owed to it
+static bool _grassSceneryBlockCycle;
+static sint32 _grassSceneryBatchBacklog;
+static constexpr const sint32 GRASS_SCENERY_BLOCK_WIDTH = 32;
+static constexpr const sint32 GRASS_SCENERY_BLOCKS_PER_ROW = MAXIMUM_MAP_SIZE_TECHNICAL / GRASS_SCENERY_BLOCK_WIDTH;
+static constexpr const sint32 GRASS_SCENERY_BLOCK_SIZE = GRASS_SCENERY_BLOCK_WIDTH * GRASS_SCENERY_BLOCK_WIDTH;
 
 sint16 gMapSizeUnits;
 sint16 gMapSizeMinus2;
@@ -104,15 +118,14 @@ sint16 gMapSize;
 sint16 gMapSizeMaxXY;
 sint16 gMapBaseZ;
 
-rct_tile_element gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
 rct_tile_element *gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 LocationXY16 gMapSelectionTiles[300];
 static LocationXYZ16 gVirtualFloorLastMinLocation;
 static LocationXYZ16 gVirtualFloorLastMaxLocation;
 PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
 
-rct_tile_element *gNextFreeTileElement;
 uint32 gNextFreeTileElementPointerIndex;
+uint32 gMapModificationGeneration;
 
 bool gLandMountainMode;
 bool gLandPaintMode;
@@ -127,6 +140,319 @@ LocationXYZ16 gCommandPosition;
 
 bool gMapLandRightsUpdateSuccess;
 
+/**
+ * Tile elements live in blocks that are allocated as the map needs them. Blocks are never moved or resized, so the
+ * elements of a tile always form one run inside a single block. Slots that are given up are marked with a base
+ * height of 255. Runs given up by tile_element_insert are remembered and handed out again, other new runs are taken
+ * from the end of the last block. The remaining holes are closed by map_compact_tile_elements, a few tiles per tick,
+ * and only if that falls far behind by map_reorganise_elements.
+ */
+struct tile_element_block
+{
+    std::unique_ptr<rct_tile_element[]> elements;
+    size_t                              capacity = 0;
+    size_t                              used = 0;
+};
+
+static std::vector<tile_element_block> _tileElementBlocks;
+// Elements that belong to a tile, i.e. not counting freed slots
+static size_t _tileElementCount;
+
+/**
+ * While the overlay is active the live tiles are never written to. A tile is copied to the end of the storage the
+ * first time it is accessed, or replaced by the blank tile if one was given, and from then on the copy is used. Ending
+ * the overlay points the tiles back at their live elements and drops the copies, so the cost depends on the number of
+ * tiles touched rather than the size of the map.
+ */
+struct tile_element_overlay
+{
+    bool                                               active = false;
+    bool                                               has_blank_tile = false;
+    rct_tile_element                                   blank_tile;
+    std::vector<bool>                                  copied;
+    std::vector<std::pair<uint32, rct_tile_element *>> live_tiles;
+    size_t                                             block_count = 0;
+    size_t                                             block_used = 0;
+    size_t                                             element_count = 0;
+};
+
+static tile_element_overlay _tileElementOverlay;
+
+/**
+ * The height, slope and water level of each tile's surface, copied from the surface element when first needed so
+ * tile_element_height does not have to find it.
+ */
+struct surface_height_entry
+{
+    uint8 base_height;
+    uint8 slope;
+    uint8 water_height;
+    uint8 flags;
+};
+
+enum
+{
+    SURFACE_HEIGHT_FLAG_VALID = (1 << 0),
+    SURFACE_HEIGHT_FLAG_NO_SURFACE = (1 << 1),
+};
+
+static surface_height_entry _surfaceHeights[MAX_TILE_TILE_ELEMENT_POINTERS];
+
+// Tiles whose path wide flags have to be recalculated, one bit per tile in the order of the tile pointers
+static uint32 _pathWideFlagsDirtyTiles[MAX_TILE_TILE_ELEMENT_POINTERS / 32];
+static bool _pathWideFlagsDirty;
+
+// Free runs by length. Entries are checked before use, as compaction may have filled them since.
+static std::vector<rct_tile_element *> _freeTileElementRuns[TILE_ELEMENT_FREE_RUN_MAX_LENGTH + 1];
+static uint32 _tileElementRunsReused;
+static uint32 _tileElementTilesCompacted;
+static uint32 _tileElementReorganisations;
+static uint64 _tileElementLastReorganiseTime;
+
+static void tile_element_free_runs_clear()
+{
+    for (auto &runs : _freeTileElementRuns)
+    {
+        runs.clear();
+        runs.shrink_to_fit();
+    }
+}
+
+/**
+ * Replaces all blocks with a single one holding count elements plus room to grow.
+ */
+static rct_tile_element *tile_element_reset_storage(size_t count)
+{
+    tile_element_block block;
+    block.capacity = count + TILE_ELEMENT_BLOCK_SIZE;
+    block.elements = std::make_unique<rct_tile_element[]>(block.capacity);
+    block.used = count;
+
+    _tileElementBlocks.clear();
+    _tileElementBlocks.push_back(std::move(block));
+    _tileElementCount = count;
+    tile_element_free_runs_clear();
+    return _tileElementBlocks.front().elements.get();
+}
+
+/**
+ * Takes a run of count slots from the end of the last block, starting a new block if it does not have enough room.
+ */
+static rct_tile_element *tile_element_allocate(size_t count)
+{
+    if (_tileElementBlocks.empty() || _tileElementBlocks.back().used + count > _tileElementBlocks.back().capacity)
+    {
+        tile_element_block block;
+        block.capacity = std::max<size_t>(count, TILE_ELEMENT_BLOCK_SIZE);
+        block.elements = std::make_unique<rct_tile_element[]>(block.capacity);
+        _tileElementBlocks.push_back(std::move(block));
+    }
+
+    tile_element_block &block = _tileElementBlocks.back();
+    rct_tile_element *result = &block.elements[block.used];
+    block.used += count;
+    return result;
+}
+
+static tile_element_block *tile_element_get_block(const rct_tile_element *element)
+{
+    uintptr_t address = (uintptr_t)element;
+    for (auto &block : _tileElementBlocks)
+    {
+        uintptr_t start = (uintptr_t)block.elements.get();
+        if (address >= start && address < start + block.used * sizeof(rct_tile_element))
+        {
+            return &block;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Whether all slots of the run are given up and lie within the used part of a block.
+ */
+static bool tile_element_run_is_free(const rct_tile_element *start, size_t length)
+{
+    const tile_element_block *block = tile_element_get_block(start);
+    if (block == nullptr || (size_t)(start - block->elements.get()) + length > block->used)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        if (start[i].base_height != 255)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void tile_element_free_run_add(rct_tile_element *start, size_t length)
+{
+    // Overlay copies are dropped as a whole when it ends
+    if (_tileElementOverlay.active)
+    {
+        return;
+    }
+
+    // Single slots are left for compaction, no tile run is that short by the time it is moved
+    if (length < 2 || length > TILE_ELEMENT_FREE_RUN_MAX_LENGTH)
+    {
+        return;
+    }
+    auto &runs = _freeTileElementRuns[length];
+    if (runs.size() < TILE_ELEMENT_FREE_RUN_MAX_COUNT)
+    {
+        runs.push_back(start);
+    }
+}
+
+/**
+ * Takes a remembered free run of at least count slots, splitting off what is not needed.
+ */
+static rct_tile_element *tile_element_free_run_take(size_t count)
+{
+    // Free runs belong to the live map
+    if (_tileElementOverlay.active)
+    {
+        return nullptr;
+    }
+
+    for (size_t length = count; length <= TILE_ELEMENT_FREE_RUN_MAX_LENGTH; length++)
+    {
+        auto &runs = _freeTileElementRuns[length];
+        while (!runs.empty())
+        {
+            rct_tile_element *start = runs.back();
+            runs.pop_back();
+            if (tile_element_run_is_free(start, length))
+            {
+                tile_element_free_run_add(start + count, length - count);
+                _tileElementRunsReused++;
+                return start;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Returns the free slots at the end of a block to it. Blocks other than the last one are released once empty.
+ */
+static void tile_element_trim_block(tile_element_block *block)
+{
+    while (block->used > 0 && block->elements[block->used - 1].base_height == 255)
+    {
+        block->used--;
+    }
+
+    if (block->used == 0 && block != &_tileElementBlocks.back())
+    {
+        _tileElementBlocks.erase(_tileElementBlocks.begin() + (block - _tileElementBlocks.data()));
+    }
+}
+
+static size_t tile_element_get_free_slot_count()
+{
+    size_t slots = 0;
+    for (const auto &block : _tileElementBlocks)
+    {
+        slots += block.used;
+    }
+    return slots - _tileElementCount;
+}
+
+/**
+ * Whether so many slots have been given up that the tile elements should be reorganised at once.
+ */
+static bool tile_element_has_excess_free_slots()
+{
+    return tile_element_get_free_slot_count() > std::max<size_t>(_tileElementCount, TILE_ELEMENT_BLOCK_SIZE);
+}
+
+/**
+ * A summary of each tile's elements, so lookups can skip tiles that cannot hold what they are looking for.
+ * Element types are normally set right after tile_element_insert returns, so a tile that gains an element claims to
+ * hold every type until map_update_tile_summaries runs at the start of the next tick. Removing an element leaves the
+ * summary as it is, which can only make it claim too much, until sub_68B089 next visits the tile. Heights are not
+ * summarised as many places change them directly.
+ */
+struct tile_element_summary
+{
+    uint16 type_flags;
+    bool   dirty;
+};
+
+static tile_element_summary _tileSummaries[MAX_TILE_TILE_ELEMENT_POINTERS];
+static std::vector<uint32> _dirtyTileSummaries;
+
+static void tile_element_summary_rebuild(uint32 index)
+{
+    tile_element_summary &summary = _tileSummaries[index];
+    summary.type_flags = 0;
+
+    const rct_tile_element *tileElement = gTileElementTilePointers[index];
+    if (tileElement == TILE_UNDEFINED_TILE_ELEMENT)
+    {
+        summary.type_flags = 0xFFFF;
+        return;
+    }
+
+    do
+    {
+        summary.type_flags |= TILE_ELEMENT_TYPE_FLAG(tile_element_get_type(tileElement));
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+}
+
+static void tile_element_summary_invalidate(sint32 x, sint32 y)
+{
+    uint32 index = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    tile_element_summary &summary = _tileSummaries[index];
+    summary.type_flags = 0xFFFF;
+    if (!summary.dirty)
+    {
+        summary.dirty = true;
+        _dirtyTileSummaries.push_back(index);
+    }
+}
+
+static void tile_element_summary_rebuild_all()
+{
+    for (uint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
+    {
+        _tileSummaries[i].dirty = false;
+        tile_element_summary_rebuild(i);
+    }
+    _dirtyTileSummaries.clear();
+}
+
+/**
+ * Updates the summaries of tiles that gained elements since the last call.
+ */
+void map_update_tile_summaries()
+{
+    for (uint32 index : _dirtyTileSummaries)
+    {
+        _tileSummaries[index].dirty = false;
+        tile_element_summary_rebuild(index);
+    }
+    _dirtyTileSummaries.clear();
+}
+
+/**
+ * Whether the tile may hold an element of any of the given types (see TILE_ELEMENT_TYPE_FLAG). A false result is
+ * exact, a true result means the tile has to be searched.
+ */
+bool map_tile_may_contain(sint32 x, sint32 y, uint16 typeFlags)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return true;
+    return (_tileSummaries[x + y * MAXIMUM_MAP_SIZE_TECHNICAL].type_flags & typeFlags) != 0;
+}
+
+static rct_tile_element *tile_element_overlay_copy_tile(uint32 index);
 static void map_update_grass_length(sint32 x, sint32 y, rct_tile_element *tileElement);
 static void map_set_grass_length(sint32 x, sint32 y, rct_tile_element *tileElement, sint32 length);
 static void clear_elements_at(sint32 x, sint32 y);
@@ -227,7 +553,11 @@ rct_tile_element *map_get_first_element_at(sint32 x, sint32 y)
         log_error("Trying to access element outside of range");
         return nullptr;
     }
-    return gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL];
+    uint32 index = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    if (_tileElementOverlay.active && !_tileElementOverlay.copied[index]) {
+        return tile_element_overlay_copy_tile(index);
+    }
+    return gTileElementTilePointers[index];
 }
 
 rct_tile_element *map_get_nth_element_at(sint32 x, sint32 y, sint32 n)
@@ -259,7 +589,12 @@ void map_set_tile_elements(sint32 x, sint32 y, rct_tile_element *elements)
         log_error("Trying to access element outside of range");
         return;
     }
-    gTileElementTilePointers[x + y * MAXIMUM_MAP_SIZE_TECHNICAL] = elements;
+    uint32 index = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+    if (_tileElementOverlay.active && !_tileElementOverlay.copied[index]) {
+        _tileElementOverlay.copied[index] = true;
+        _tileElementOverlay.live_tiles.emplace_back(index, gTileElementTilePointers[index]);
+    }
+    gTileElementTilePointers[index] = elements;
 }
 
 bool tile_element_is_last_for_tile(const rct_tile_element *element)
@@ -358,6 +693,9 @@ rct_tile_element * map_get_surface_element_at(CoordsXY coords)
 }
 
 rct_tile_element* map_get_path_element_at(sint32 x, sint32 y, sint32 z){
+    if (!map_tile_may_contain(x, y, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_PATH)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x, y);
 
     if (tileElement == nullptr)
@@ -379,6 +717,9 @@ rct_tile_element* map_get_path_element_at(sint32 x, sint32 y, sint32 z){
 }
 
 rct_tile_element* map_get_banner_element_at(sint32 x, sint32 y, sint32 z, uint8 position) {
+    if (!map_tile_may_contain(x, y, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_BANNER)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x, y);
 
     if (tileElement == nullptr)
@@ -405,11 +746,12 @@ rct_tile_element* map_get_banner_element_at(sint32 x, sint32 y, sint32 z, uint8
  */
 void map_init(sint32 size)
 {
-    gNumMapAnimations = 0;
+    map_animation_reset();
     gNextFreeTileElementPointerIndex = 0;
 
+    rct_tile_element *tileElements = tile_element_reset_storage(MAX_TILE_TILE_ELEMENT_POINTERS);
     for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++) {
-        rct_tile_element *tile_element = &gTileElements[i];
+        rct_tile_element *tile_element = &tileElements[i];
         tile_element->type = (TILE_ELEMENT_TYPE_SURFACE << 2);
         tile_element->flags = TILE_ELEMENT_FLAG_LAST_TILE;
         tile_element->base_height = 14;
@@ -424,6 +766,7 @@ void map_init(sint32 size)
     }
 
     gGrassSceneryTileLoopPosition = 0;
+    map_update_tiles_reset();
     gWidePathTileLoopX = 0;
     gWidePathTileLoopY = 0;
     gMapSizeUnits = size * 32 - 32;
@@ -490,14 +833,18 @@ void map_count_remaining_land_rights()
  */
 void map_strip_ghost_flag_from_elements()
 {
-    rct_tile_element *tileElement = gTileElements;
-    do {
-        tileElement->flags &= ~TILE_ELEMENT_FLAG_GHOST;
-    } while (++tileElement < gTileElements + MAX_TILE_ELEMENTS);
+    for (auto &block : _tileElementBlocks)
+    {
+        for (size_t i = 0; i < block.used; i++)
+        {
+            block.elements[i].flags &= ~TILE_ELEMENT_FLAG_GHOST;
+        }
+    }
 }
 
 /**
- *
+ * Points each tile at its elements. The elements must be stored in tile order in the first block, as left by
+ * map_init, map_load_tile_elements and map_reorganise_elements.
  *  rct2: 0x0068AFFD
  */
 void map_update_tile_pointers()
@@ -508,18 +855,189 @@ void map_update_tile_pointers()
         gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
     }
 
-    rct_tile_element *tileElement = gTileElements;
-    rct_tile_element **tile = gTileElementTilePointers;
-    for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
-        for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
-            *tile++ = tileElement;
-            while (!tile_element_is_last_for_tile(tileElement++));
+    if (!_tileElementBlocks.empty()) {
+        tile_element_block &block = _tileElementBlocks.front();
+        rct_tile_element *tileElement = block.elements.get();
+        rct_tile_element **tile = gTileElementTilePointers;
+        for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+            for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+                *tile++ = tileElement;
+                while (!tile_element_is_last_for_tile(tileElement++));
+            }
         }
+
+        block.used = (size_t)(tileElement - block.elements.get());
+        _tileElementCount = block.used;
+        _tileElementBlocks.erase(_tileElementBlocks.begin() + 1, _tileElementBlocks.end());
+    }
+    tile_element_summary_rebuild_all();
+    map_invalidate_surface_heights();
+    map_invalidate_all_path_wide_flags();
+    footpath_graph_reset();
+    paint_cache_reset();
+}
+
+/**
+ * Replaces the tile elements with a copy of the given tile ordered elements, e.g. from a saved park. The tile
+ * pointers have to be updated with map_update_tile_pointers afterwards.
+ * Returns false if the elements of every tile do not fit within count.
+ */
+bool map_load_tile_elements(const rct_tile_element *elements, size_t count)
+{
+    size_t length = 0;
+    for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++) {
+        do {
+            if (length >= count) {
+                return false;
+            }
+        } while (!tile_element_is_last_for_tile(&elements[length++]));
+    }
+
+    rct_tile_element *tileElements = tile_element_reset_storage(length);
+    std::copy_n(elements, length, tileElements);
+    return true;
+}
+
+/**
+ * Returns a copy of all tile elements in tile order without any free slots, which is the layout used by saved
+ * parks.
+ */
+std::vector<rct_tile_element> map_get_tile_elements()
+{
+    std::vector<rct_tile_element> elements;
+    elements.reserve(_tileElementCount);
+    for (sint32 i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++) {
+        const rct_tile_element *tileElement = gTileElementTilePointers[i];
+        if (tileElement == TILE_UNDEFINED_TILE_ELEMENT)
+            continue;
+        do {
+            elements.push_back(*tileElement);
+        } while (!tile_element_is_last_for_tile(tileElement++));
+    }
+    return elements;
+}
+
+size_t map_get_tile_element_count()
+{
+    return _tileElementCount;
+}
+
+/**
+ * Starts a copy-on-write overlay over the map, see tile_element_overlay. If blankTile is given every tile reads as
+ * that single element instead of a copy of the live tile, which gives an empty map without having to build one.
+ */
+void map_overlay_begin(const rct_tile_element *blankTile)
+{
+    tile_element_overlay &overlay = _tileElementOverlay;
+    Guard::Assert(!overlay.active, "Map overlay is already active");
+
+    overlay.active = true;
+    overlay.has_blank_tile = blankTile != nullptr;
+    if (blankTile != nullptr) {
+        overlay.blank_tile = *blankTile;
+        overlay.blank_tile.flags |= TILE_ELEMENT_FLAG_LAST_TILE;
+    }
+    overlay.copied.assign(MAX_TILE_TILE_ELEMENT_POINTERS, false);
+    overlay.live_tiles.clear();
+    overlay.block_count = _tileElementBlocks.size();
+    overlay.block_used = _tileElementBlocks.empty() ? 0 : _tileElementBlocks.back().used;
+    overlay.element_count = _tileElementCount;
+
+    // Cached heights of tiles that have not been copied yet would describe the live map
+    if (overlay.has_blank_tile) {
+        map_invalidate_surface_heights();
+    }
+}
+
+/**
+ * Ends the overlay, discarding everything written to the map since map_overlay_begin.
+ */
+void map_overlay_end()
+{
+    tile_element_overlay &overlay = _tileElementOverlay;
+    if (!overlay.active)
+        return;
+
+    for (const auto &liveTile : overlay.live_tiles) {
+        uint32 index = liveTile.first;
+        sint32 x = index % MAXIMUM_MAP_SIZE_TECHNICAL;
+        sint32 y = index / MAXIMUM_MAP_SIZE_TECHNICAL;
+        gTileElementTilePointers[index] = liveTile.second;
+        tile_element_summary_invalidate(x, y);
+        map_invalidate_surface_height(x, y);
+        footpath_invalidate_tile(x << 5, y << 5);
+    }
+    overlay.live_tiles.clear();
+    overlay.live_tiles.shrink_to_fit();
+    overlay.copied.clear();
+    overlay.copied.shrink_to_fit();
+
+    // Copies were only ever taken from the end of the storage
+    _tileElementBlocks.erase(_tileElementBlocks.begin() + overlay.block_count, _tileElementBlocks.end());
+    if (!_tileElementBlocks.empty()) {
+        _tileElementBlocks.back().used = overlay.block_used;
+    }
+    _tileElementCount = overlay.element_count;
+
+    overlay.active = false;
+    gMapModificationGeneration++;
+}
+
+bool map_overlay_is_active()
+{
+    return _tileElementOverlay.active;
+}
+
+static rct_tile_element *tile_element_overlay_copy_tile(uint32 index)
+{
+    tile_element_overlay &overlay = _tileElementOverlay;
+    sint32 x = index % MAXIMUM_MAP_SIZE_TECHNICAL;
+    sint32 y = index / MAXIMUM_MAP_SIZE_TECHNICAL;
+    rct_tile_element *liveElements = gTileElementTilePointers[index];
+    rct_tile_element *copy = TILE_UNDEFINED_TILE_ELEMENT;
+
+    if (overlay.has_blank_tile) {
+        copy = tile_element_allocate(1);
+        *copy = overlay.blank_tile;
+        _tileElementCount++;
+        tile_element_summary_invalidate(x, y);
+    } else if (liveElements != TILE_UNDEFINED_TILE_ELEMENT) {
+        size_t numElements = 1;
+        for (const rct_tile_element *tileElement = liveElements; !tile_element_is_last_for_tile(tileElement); tileElement++)
+            numElements++;
+        copy = tile_element_allocate(numElements);
+        std::copy_n(liveElements, numElements, copy);
+        _tileElementCount += numElements;
+    }
+
+    overlay.copied[index] = true;
+    overlay.live_tiles.emplace_back(index, liveElements);
+    gTileElementTilePointers[index] = copy;
+    return copy;
+}
+
+/**
+ * Invalidates the cached surface height of a tile, must be called whenever the height, slope or water level of its
+ * surface changes.
+ */
+void map_invalidate_surface_height(sint32 x, sint32 y)
+{
+    if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        _surfaceHeights[x + y * MAXIMUM_MAP_SIZE_TECHNICAL].flags = 0;
     }
+}
 
-    gNextFreeTileElement = tileElement;
+void map_invalidate_surface_heights()
+{
+    for (auto &entry : _surfaceHeights)
+    {
+        entry.flags = 0;
+    }
 }
 
+static sint32 surface_get_height_at(sint32 x, sint32 y, uint8 baseHeight, uint8 surfaceSlope, uint8 waterHeight);
+
 /**
  * Return the absolute height of an element, given its (x,y) coordinates
  *
@@ -530,28 +1048,56 @@ void map_update_tile_pointers()
  */
 sint32 tile_element_height(sint32 x, sint32 y)
 {
-    rct_tile_element *tileElement;
-
     // Off the map
     if ((unsigned)x >= 8192 || (unsigned)y >= 8192)
         return 16;
 
-    // Truncate subtile coordinates
-    sint32 x_tile = x & 0xFFFFFFE0;
-    sint32 y_tile = y & 0xFFFFFFE0;
+    surface_height_entry &entry = _surfaceHeights[(x >> 5) + (y >> 5) * MAXIMUM_MAP_SIZE_TECHNICAL];
+    if (!(entry.flags & SURFACE_HEIGHT_FLAG_VALID)) {
+        const rct_tile_element *tileElement = map_get_surface_element_at(x >> 5, y >> 5);
+        if (tileElement == nullptr) {
+            entry.flags = SURFACE_HEIGHT_FLAG_VALID | SURFACE_HEIGHT_FLAG_NO_SURFACE;
+        } else {
+            entry.base_height = tileElement->base_height;
+            entry.slope = tileElement->properties.surface.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK;
+            entry.water_height = map_get_water_height(tileElement);
+            entry.flags = SURFACE_HEIGHT_FLAG_VALID;
+        }
+    }
 
-    // Get the surface element for the tile
-    tileElement = map_get_surface_element_at({x_tile, y_tile});
+    if (entry.flags & SURFACE_HEIGHT_FLAG_NO_SURFACE)
+        return 16;
+    return surface_get_height_at(x, y, entry.base_height, entry.slope, entry.water_height);
+}
 
-    if (tileElement == nullptr) {
+/**
+ * The same as tile_element_height, but always reads the surface element rather than the cache.
+ */
+sint32 tile_element_height_uncached(sint32 x, sint32 y)
+{
+    // Off the map
+    if ((unsigned)x >= 8192 || (unsigned)y >= 8192)
         return 16;
-    }
 
+    const rct_tile_element *tileElement = map_get_surface_element_at(x >> 5, y >> 5);
+    if (tileElement == nullptr)
+        return 16;
+
+    return surface_get_height_at(
+        x,
+        y,
+        tileElement->base_height,
+        tileElement->properties.surface.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK,
+        map_get_water_height(tileElement));
+}
+
+static sint32 surface_get_height_at(sint32 x, sint32 y, uint8 baseHeight, uint8 surfaceSlope, uint8 waterHeight)
+{
     uint32 height =
-        (map_get_water_height(tileElement) << 20) |
-        (tileElement->base_height << 3);
+        (waterHeight << 20) |
+        (baseHeight << 3);
 
-    uint32 slope = (tileElement->properties.surface.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK);
+    uint32 slope = surfaceSlope;
     uint8 extra_height = (slope & TILE_ELEMENT_SLOPE_DOUBLE_HEIGHT) >> 4; // 0x10 is the 5th bit - sets slope to double height
     // Remove the extra height bit
     slope &= TILE_ELEMENT_SLOPE_ALL_CORNERS_UP;
@@ -684,7 +1230,7 @@ void sub_68B089()
     sint32 i;
     rct_tile_element *tileElementFirst, *tileElement;
 
-    if (gTrackDesignSaveMode)
+    if (gTrackDesignSaveMode || _tileElementOverlay.active)
         return;
 
     i = gNextFreeTileElementPointerIndex;
@@ -695,13 +1241,18 @@ void sub_68B089()
     } while (gTileElementTilePointers[i] == TILE_UNDEFINED_TILE_ELEMENT);
     gNextFreeTileElementPointerIndex = i;
 
+    // Drop anything the summary still claims from elements removed since it was built
+    if (!_tileSummaries[i].dirty)
+        tile_element_summary_rebuild(i);
+
+    // Move the tile's elements back over any free slots before them, but never out of their block
     tileElementFirst = tileElement = gTileElementTilePointers[i];
-    do {
+    tile_element_block *block = tile_element_get_block(tileElementFirst);
+    if (block == nullptr)
+        return;
+
+    while (tileElement > block->elements.get() && (tileElement - 1)->base_height == 255)
         tileElement--;
-        if (tileElement < gTileElements)
-            break;
-    } while (tileElement->base_height == 255);
-    tileElement++;
 
     if (tileElement == tileElementFirst)
         return;
@@ -715,12 +1266,43 @@ void sub_68B089()
         tileElementFirst++;
     } while (!tile_element_is_last_for_tile(tileElement++));
 
-    tileElement = gNextFreeTileElement;
-    do {
-        tileElement--;
-    } while (tileElement->base_height == 255);
-    tileElement++;
-    gNextFreeTileElement = tileElement;
+    tile_element_trim_block(block);
+    _tileElementTilesCompacted++;
+}
+
+/**
+ * Closes holes between the tile elements, one tile per tick as RCT2 did or, while more than an eighth of the slots
+ * have been given up, TILE_ELEMENT_COMPACT_TILES_PER_TICK tiles.
+ */
+void map_compact_tile_elements()
+{
+    size_t slots = _tileElementCount + tile_element_get_free_slot_count();
+    sint32 numTiles = tile_element_get_free_slot_count() * 8 > slots ? TILE_ELEMENT_COMPACT_TILES_PER_TICK : 1;
+    for (sint32 i = 0; i < numTiles; i++)
+    {
+        sub_68B089();
+    }
+}
+
+tile_element_stats map_get_tile_element_stats()
+{
+    tile_element_stats stats = {};
+    stats.elements = _tileElementCount;
+    stats.free_slots = tile_element_get_free_slot_count();
+    stats.blocks = _tileElementBlocks.size();
+    for (const auto &block : _tileElementBlocks)
+    {
+        stats.capacity += block.capacity;
+    }
+    for (const auto &runs : _freeTileElementRuns)
+    {
+        stats.free_runs += runs.size();
+    }
+    stats.runs_reused = _tileElementRunsReused;
+    stats.tiles_compacted = _tileElementTilesCompacted;
+    stats.reorganisations = _tileElementReorganisations;
+    stats.last_reorganise_time = _tileElementLastReorganiseTime;
+    return stats;
 }
 
 
@@ -760,32 +1342,70 @@ bool map_coord_is_connected(sint32 x, sint32 y, sint32 z, uint8 faceDirection)
  *
  *  rct2: 0x006A876D
  */
+static void map_mark_path_wide_flags_dirty(sint32 x, sint32 y)
+{
+    if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        sint32 index = x + y * MAXIMUM_MAP_SIZE_TECHNICAL;
+        _pathWideFlagsDirtyTiles[index / 32] |= 1u << (index % 32);
+        _pathWideFlagsDirty = true;
+    }
+}
+
+/**
+ * Schedules the wide flags of the paths around a tile to be recalculated, must be called whenever a path on the tile
+ * is placed, removed or changed. Changing a path changes the edges of paths up to two tiles away, and the wide flags of
+ * a tile depend on the paths on the eight tiles around it.
+ */
+void map_invalidate_path_wide_flags(sint32 x, sint32 y)
+{
+    for (sint32 offsetY = -3; offsetY <= 3; offsetY++)
+    {
+        for (sint32 offsetX = -3; offsetX <= 3; offsetX++)
+        {
+            map_mark_path_wide_flags_dirty(x + offsetX, y + offsetY);
+        }
+    }
+}
+
+void map_invalidate_all_path_wide_flags()
+{
+    std::fill_n(_pathWideFlagsDirtyTiles, Util::CountOf(_pathWideFlagsDirtyTiles), UINT32_MAX);
+    _pathWideFlagsDirty = true;
+}
+
+/**
+ * Recalculates the wide flags of the tiles that have changed since the last update. The flags of a tile only depend on
+ * the wide flags of the tiles before it in the order of the tile pointers, so walking the dirty tiles in that order and
+ * marking the tiles after a changed one settles every change in a single pass. This gives the same flags on every
+ * client no matter which tiles were marked, as long as every changed path was.
+ */
 void map_update_path_wide_flags()
 {
     if (gScreenFlags & (SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER)) {
         return;
     }
+    if (!_pathWideFlagsDirty) {
+        return;
+    }
+
+    for (size_t i = 0; i < Util::CountOf(_pathWideFlagsDirtyTiles); i++) {
+        while (_pathWideFlagsDirtyTiles[i] != 0) {
+            sint32 bit = bitscanforward((sint32)_pathWideFlagsDirtyTiles[i]);
+            _pathWideFlagsDirtyTiles[i] &= ~(1u << bit);
 
-    // Presumably update_path_wide_flags is too computationally expensive to call for every
-    // tile every update, so gWidePathTileLoopX and gWidePathTileLoopY store the x and y
-    // progress. A maximum of 128 calls is done per update.
-    uint16 x = gWidePathTileLoopX;
-    uint16 y = gWidePathTileLoopY;
-    for (sint32 i = 0; i < 128; i++) {
-        footpath_update_path_wide_flags(x, y);
-
-        // Next x, y tile
-        x += 32;
-        if (x >= 8192) {
-            x = 0;
-            y += 32;
-            if (y >= 8192) {
-                y = 0;
+            sint32 index = (sint32)i * 32 + bit;
+            sint32 x = index % MAXIMUM_MAP_SIZE_TECHNICAL;
+            sint32 y = index / MAXIMUM_MAP_SIZE_TECHNICAL;
+            if (footpath_update_path_wide_flags(x * 32, y * 32)) {
+                map_mark_path_wide_flags_dirty(x + 1, y);
+                map_mark_path_wide_flags_dirty(x - 1, y + 1);
+                map_mark_path_wide_flags_dirty(x, y + 1);
+                map_mark_path_wide_flags_dirty(x + 1, y + 1);
             }
         }
     }
-    gWidePathTileLoopX = x;
-    gWidePathTileLoopY = y;
+    _pathWideFlagsDirty = false;
 }
 
 /**
@@ -1727,6 +2347,7 @@ static money32 map_set_land_height(sint32 flags, sint32 x, sint32 y, sint32 heig
         sint32 slope = surfaceElement->properties.surface.terrain & TILE_ELEMENT_SURFACE_SLOPE_MASK;
         if(slope != TILE_ELEMENT_SLOPE_FLAT && slope <= height / 2)
             surfaceElement->properties.surface.terrain &= TILE_ELEMENT_SURFACE_TERRAIN_MASK;
+        map_invalidate_surface_height(x >> 5, y >> 5);
         map_invalidate_tile_full(x, y);
     }
     if(gParkFlags & PARK_FLAGS_NO_MONEY)
@@ -2665,6 +3286,7 @@ void game_command_set_water_height(sint32* eax, sint32* ebx, sint32* ecx, sint32
                 new_terrain |= (base_height / 2);
             }
             tile_element->properties.surface.terrain = new_terrain;
+            map_invalidate_surface_height(x >> 5, y >> 5);
             map_invalidate_tile_full(x, y);
         }
         *ebx = 250;
@@ -2935,9 +3557,12 @@ void tile_element_remove(rct_tile_element *tileElement)
     (tileElement - 1)->flags |= TILE_ELEMENT_FLAG_LAST_TILE;
     tileElement->base_height = 0xFF;
 
-    if ((tileElement + 1) == gNextFreeTileElement){
-        gNextFreeTileElement--;
+    tile_element_block &lastBlock = _tileElementBlocks.back();
+    if ((tileElement + 1) == &lastBlock.elements[lastBlock.used]){
+        lastBlock.used--;
     }
+    _tileElementCount--;
+    gMapModificationGeneration++;
 }
 
 /**
@@ -2971,6 +3596,9 @@ void map_remove_all_rides()
             break;
         }
     } while (tile_element_iterator_next(&it));
+
+    map_invalidate_all_path_wide_flags();
+    footpath_graph_reset();
 }
 
 /**
@@ -3059,62 +3687,36 @@ void map_reorganise_elements()
 {
     context_setcurrentcursor(CURSOR_ZZZ);
 
-    rct_tile_element* new_tile_elements = (rct_tile_element *)malloc(3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) * sizeof(rct_tile_element));
-    rct_tile_element* new_elements_pointer = new_tile_elements;
-
-    if (new_tile_elements == nullptr) {
-        log_fatal("Unable to allocate memory for map elements.");
-        return;
-    }
-
-    uint32 num_elements;
-
-    for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
-        for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
-            rct_tile_element *startElement = map_get_first_element_at(x, y);
-            rct_tile_element *endElement = startElement;
-            while (!tile_element_is_last_for_tile(endElement++));
-
-            num_elements = (uint32)(endElement - startElement);
-            memcpy(new_elements_pointer, startElement, num_elements * sizeof(rct_tile_element));
-            new_elements_pointer += num_elements;
-        }
-    }
-
-    num_elements = (uint32)(new_elements_pointer - new_tile_elements);
-    memcpy(gTileElements, new_tile_elements, num_elements * sizeof(rct_tile_element));
-    memset(gTileElements + num_elements, 0, (3 * (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL) - num_elements) * sizeof(rct_tile_element));
-
-    free(new_tile_elements);
-
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::vector<rct_tile_element> elements = map_get_tile_elements();
+    map_load_tile_elements(elements.data(), elements.size());
     map_update_tile_pointers();
+
+    auto elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    _tileElementLastReorganiseTime = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    _tileElementReorganisations++;
 }
 
 /**
  *
  *  rct2: 0x0068B044
  *  Returns true on space available for more elements
- *  Reorganises the map elements to check for space
+ *  Reorganises the map elements if map_compact_tile_elements has fallen far behind. New blocks are allocated as
+ *  needed, so there is always space available.
  */
 bool map_check_free_elements_and_reorganise(sint32 num_elements)
 {
-    if ((gNextFreeTileElement + num_elements) <= gTileElements + MAX_TILE_ELEMENTS)
+    if (_tileElementOverlay.active || !tile_element_has_excess_free_slots())
         return true;
 
     for (sint32 i = 1000; i != 0; --i)
         sub_68B089();
 
-    if ((gNextFreeTileElement + num_elements) <= gTileElements + MAX_TILE_ELEMENTS)
+    if (!tile_element_has_excess_free_slots())
         return true;
 
     map_reorganise_elements();
-
-    if ((gNextFreeTileElement + num_elements) <= gTileElements + MAX_TILE_ELEMENTS)
-        return true;
-    else{
-        gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
-        return false;
-    }
+    return true;
 }
 
 /**
@@ -3130,8 +3732,16 @@ rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags
         return nullptr;
     }
 
-    newTileElement = gNextFreeTileElement;
-    originalTileElement = gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+    originalTileElement = map_get_first_element_at(x, y);
+
+    // The tile's elements are moved to a new run with room for one more
+    size_t numElements = 1;
+    for (const rct_tile_element *tileElement = originalTileElement; !tile_element_is_last_for_tile(tileElement); tileElement++)
+        numElements++;
+    newTileElement = tile_element_free_run_take(numElements + 1);
+    if (newTileElement == nullptr)
+        newTileElement = tile_element_allocate(numElements + 1);
+    rct_tile_element *originalRun = originalTileElement;
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newTileElement;
@@ -3171,21 +3781,24 @@ rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags
         } while (!((newTileElement - 1)->flags & TILE_ELEMENT_FLAG_LAST_TILE));
     }
 
-    gNextFreeTileElement = newTileElement;
+    tile_element_free_run_add(originalRun, numElements);
+    _tileElementCount++;
+    tile_element_summary_invalidate(x, y);
+    map_invalidate_surface_height(x, y);
+    gMapModificationGeneration++;
     return insertedElement;
 }
 
 /**
  * This function will validate element address. It will only check if element lies within
- * the user-accessible part of map elements, there is some scratch space behind that is not
- * considered valid here.
+ * the used part of one of the tile element blocks.
  */
 bool tile_element_check_address(const rct_tile_element * const element)
 {
-    if (element >= gTileElements
-        && element < gTileElements + MAX_TILE_ELEMENTS
+    const tile_element_block * block = tile_element_get_block(element);
+    if (block != nullptr
         // condition below checks alignment
-        && gTileElements + (((uintptr_t)element - (uintptr_t)gTileElements) / sizeof(rct_tile_element)) == element)
+        && ((uintptr_t)element - (uintptr_t)block->elements.get()) % sizeof(rct_tile_element) == 0)
     {
         return true;
     }
@@ -3408,19 +4021,43 @@ sint32 map_can_construct_at(sint32 x, sint32 y, sint32 zLow, sint32 zHigh, uint8
     return gCheatsDisableClearanceChecks || map_can_construct_with_clear_at(x, y, zLow, zHigh, nullptr, bl, 0, nullptr, CREATE_CROSSING_MODE_NONE);
 }
 
+static void map_update_tile(sint32 x, sint32 y)
+{
+    rct_tile_element *tileElement = map_get_surface_element_at(x, y);
+    if (tileElement != nullptr) {
+        map_update_grass_length(x * 32, y * 32, tileElement);
+        if (map_tile_may_contain(x, y, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_SMALL_SCENERY) | TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_PATH))) {
+            scenery_update_tile(x * 32, y * 32);
+        }
+    }
+}
+
 /**
- * Updates grass length, scenery age and jumping fountains.
- *
- *  rct2: 0x006646E1
+ * Whether the grass and scenery must be updated exactly as the regular update does it, because the game has to give
+ * the same result elsewhere.
  */
-void map_update_tiles()
+static bool map_must_update_tiles_in_order()
 {
-    sint32 ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
-    if (gScreenFlags & ignoreScreenFlags)
-        return;
+    return network_get_mode() != NETWORK_MODE_NONE || (gScreenFlags & SCREEN_FLAGS_TITLE_DEMO);
+}
+
+/**
+ * At the fastest game speeds in single player the grass and scenery of several ticks is updated together, in blocks of
+ * neighbouring tiles. Every tile is still updated once in each cycle of the tile loop, but not on the same tick or in
+ * the same order as the regular update.
+ */
+static bool map_can_batch_tile_updates()
+{
+    return gGameSpeed >= 4 && !map_must_update_tiles_in_order();
+}
 
-    // Update 43 more tiles
-    for (sint32 j = 0; j < 43; j++) {
+/**
+ * Updates the next tiles of the tile loop, which visits the map with the bits of its position interleaved and reversed
+ * so that the tiles updated one after another are spread over the whole map.
+ */
+static void map_update_tile_loop(sint32 count)
+{
+    for (sint32 j = 0; j < count; j++) {
         sint32 x = 0;
         sint32 y = 0;
 
@@ -3432,17 +4069,84 @@ void map_update_tiles()
             interleaved_xy >>= 1;
         }
 
-        rct_tile_element *tileElement = map_get_surface_element_at(x, y);
-        if (tileElement != nullptr) {
-            map_update_grass_length(x * 32, y * 32, tileElement);
-            scenery_update_tile(x * 32, y * 32);
-        }
+        map_update_tile(x, y);
 
         gGrassSceneryTileLoopPosition++;
         gGrassSceneryTileLoopPosition &= 0xFFFF;
     }
 }
 
+/**
+ * Updates the block of tiles that stands in for the next GRASS_SCENERY_BLOCK_SIZE steps of the tile loop. A cycle of the
+ * loop has a block for each of these stretches and together they cover the map once, though each block holds other
+ * tiles than its stretch would. The tiles are updated a row at a time and those outside the map are skipped.
+ */
+static void map_update_tile_block()
+{
+    sint32 block = gGrassSceneryTileLoopPosition / GRASS_SCENERY_BLOCK_SIZE;
+    sint32 startX = (block % GRASS_SCENERY_BLOCKS_PER_ROW) * GRASS_SCENERY_BLOCK_WIDTH;
+    sint32 startY = (block / GRASS_SCENERY_BLOCKS_PER_ROW) * GRASS_SCENERY_BLOCK_WIDTH;
+    sint32 endX = std::min(startX + GRASS_SCENERY_BLOCK_WIDTH, (sint32)gMapSize);
+    sint32 endY = std::min(startY + GRASS_SCENERY_BLOCK_WIDTH, (sint32)gMapSize);
+    for (sint32 y = startY; y < endY; y++) {
+        for (sint32 x = startX; x < endX; x++) {
+            map_update_tile(x, y);
+        }
+    }
+
+    gGrassSceneryTileLoopPosition += GRASS_SCENERY_BLOCK_SIZE;
+    gGrassSceneryTileLoopPosition &= 0xFFFF;
+}
+
+/**
+ * Updates grass length, scenery age and jumping fountains.
+ *
+ *  rct2: 0x006646E1
+ */
+void map_update_tiles()
+{
+    sint32 ignoreScreenFlags = SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER;
+    if (gScreenFlags & ignoreScreenFlags)
+        return;
+
+    if (_grassSceneryBlockCycle && map_must_update_tiles_in_order()) {
+        map_update_tiles_reset();
+    }
+
+    if (!_grassSceneryBlockCycle) {
+        // Update 43 more tiles, stopping at the end of the cycle if the next one can be updated in blocks
+        sint32 count = 43;
+        sint32 toCycleEnd = 0x10000 - gGrassSceneryTileLoopPosition;
+        if (toCycleEnd <= count && map_can_batch_tile_updates()) {
+            _grassSceneryBlockCycle = true;
+            _grassSceneryBatchBacklog = count - toCycleEnd;
+            count = toCycleEnd;
+        }
+        map_update_tile_loop(count);
+        return;
+    }
+
+    // A cycle started in blocks is finished in blocks at the same rate, so that each tile is still updated once in it
+    _grassSceneryBatchBacklog += 43;
+    while (_grassSceneryBatchBacklog >= GRASS_SCENERY_BLOCK_SIZE) {
+        map_update_tile_block();
+        _grassSceneryBatchBacklog -= GRASS_SCENERY_BLOCK_SIZE;
+        if (gGrassSceneryTileLoopPosition == 0 && !map_can_batch_tile_updates()) {
+            map_update_tile_loop(_grassSceneryBatchBacklog);
+            map_update_tiles_reset();
+        }
+    }
+}
+
+/**
+ * Stops updating the grass and scenery in blocks, the tile loop then continues tile by tile from where it is.
+ */
+void map_update_tiles_reset()
+{
+    _grassSceneryBlockCycle = false;
+    _grassSceneryBatchBacklog = 0;
+}
+
 /**
  *
  *  rct2: 0x006647A1
@@ -3538,13 +4242,12 @@ static void map_set_grass_length(sint32 x, sint32 y, rct_tile_element *tileEleme
     map_invalidate_tile(x, y, z, z + 16);
 }
 
+/**
+ * The provisional footpath stays on the map during the update as the simulation ignores ghost paths and real paths never
+ * connect to them. Ghost track and entrances still change the state of their ride, so they are taken off the map.
+ */
 void map_remove_provisional_elements()
 {
-    if (gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_1)
-    {
-        footpath_provisional_remove();
-        gFootpathProvisionalFlags |= PROVISIONAL_PATH_FLAG_1;
-    }
     if (window_find_by_class(WC_RIDE_CONSTRUCTION ) != nullptr)
     {
         ride_remove_provisional_track_piece();
@@ -3554,15 +4257,6 @@ void map_remove_provisional_elements()
 
 void map_restore_provisional_elements()
 {
-    if (gFootpathProvisionalFlags & PROVISIONAL_PATH_FLAG_1)
-    {
-        gFootpathProvisionalFlags &= ~PROVISIONAL_PATH_FLAG_1;
-        footpath_provisional_set(gFootpathProvisionalType,
-                gFootpathProvisionalPosition.x,
-                gFootpathProvisionalPosition.y,
-                gFootpathProvisionalPosition.z,
-                gFootpathProvisionalSlope);
-    }
     if (window_find_by_class(WC_RIDE_CONSTRUCTION) != nullptr)
     {
         ride_restore_provisional_track_piece();
@@ -3667,6 +4361,7 @@ void map_extend_boundary_surface()
         newTileElement->properties.surface.slope |= slope;
         newTileElement->base_height = z;
         newTileElement->clearance_height = z;
+        map_invalidate_surface_height(x, y);
 
         update_park_fences(x << 5, y << 5);
     }
@@ -3703,6 +4398,7 @@ void map_extend_boundary_surface()
         newTileElement->properties.surface.slope |= slope;
         newTileElement->base_height = z;
         newTileElement->clearance_height = z;
+        map_invalidate_surface_height(x, y);
 
         update_park_fences(x << 5, y << 5);
     }
@@ -3723,6 +4419,7 @@ static void clear_element_at(sint32 x, sint32 y, rct_tile_element **elementPtr)
         element->properties.surface.terrain = 0;
         element->properties.surface.grass_length = GRASS_LENGTH_CLEAR_0;
         element->properties.surface.ownership = 0;
+        map_invalidate_surface_height(x >> 5, y >> 5);
         // Because this element is not completely removed, the pointer must be updated manually
         // The rest of the elements are removed from the array, so the pointer doesn't need to be updated.
         (*elementPtr)++;
@@ -3829,6 +4526,9 @@ bool tile_element_is_underground(rct_tile_element *tileElement)
 
 rct_tile_element *map_get_large_scenery_segment(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 sequence)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_LARGE_SCENERY)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     if (tileElement == nullptr)
     {
@@ -3851,6 +4551,9 @@ rct_tile_element *map_get_large_scenery_segment(sint32 x, sint32 y, sint32 z, si
 
 rct_tile_element * map_get_park_entrance_element_at(sint32 x, sint32 y, sint32 z, bool ghost)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_ENTRANCE)))
+        return nullptr;
+
     rct_tile_element* tileElement = map_get_first_element_at(x >> 5, y >> 5);
     if (tileElement != nullptr)
     {
@@ -3877,6 +4580,9 @@ rct_tile_element * map_get_park_entrance_element_at(sint32 x, sint32 y, sint32 z
 
 rct_tile_element * map_get_ride_entrance_element_at(sint32 x, sint32 y, sint32 z, bool ghost)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_ENTRANCE)))
+        return nullptr;
+
     rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
     if (tileElement != nullptr)
     {
@@ -3903,6 +4609,9 @@ rct_tile_element * map_get_ride_entrance_element_at(sint32 x, sint32 y, sint32 z
 
 rct_tile_element * map_get_ride_exit_element_at(sint32 x, sint32 y, sint32 z, bool ghost)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_ENTRANCE)))
+        return nullptr;
+
     rct_tile_element * tileElement = map_get_first_element_at(x >> 5, y >> 5);
     if (tileElement != nullptr)
     {
@@ -3929,6 +4638,9 @@ rct_tile_element * map_get_ride_exit_element_at(sint32 x, sint32 y, sint32 z, bo
 
 rct_tile_element *map_get_small_scenery_element_at(sint32 x, sint32 y, sint32 z, sint32 type, uint8 quadrant)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_SMALL_SCENERY)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     if (tileElement != nullptr)
     {
@@ -4076,6 +4788,8 @@ CoordsXY translate_3d_to_2d_with_z(sint32 rotation, CoordsXYZ pos)
 
 static void map_invalidate_tile_under_zoom(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 maxZoom)
 {
+    paint_cache_invalidate_tile(x >> 5, y >> 5);
+
     if (gOpenRCT2Headless) return;
 
     sint32 x1, y1, x2, y2;
@@ -4510,6 +5224,11 @@ void game_command_modify_tile(sint32* eax, sint32* ebx, sint32* ecx, sint32* edx
         break;
     }
 
+    if ((flags & GAME_COMMAND_FLAG_APPLY) && *ebx != MONEY32_UNDEFINED)
+    {
+        footpath_invalidate_tile(x << 5, y << 5);
+    }
+
     if (flags & GAME_COMMAND_FLAG_APPLY &&
             gGameCommandNestLevel == 1 &&
             !(flags & GAME_COMMAND_FLAG_GHOST) &&
@@ -4531,6 +5250,9 @@ void game_command_modify_tile(sint32* eax, sint32* ebx, sint32* ecx, sint32* edx
  */
 rct_tile_element *map_get_track_element_at(sint32 x, sint32 y, sint32 z)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_TRACK) continue;
@@ -4551,6 +5273,9 @@ rct_tile_element *map_get_track_element_at(sint32 x, sint32 y, sint32 z)
  */
 rct_tile_element *map_get_track_element_at_of_type(sint32 x, sint32 y, sint32 z, sint32 trackType)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_TRACK) continue;
@@ -4573,6 +5298,9 @@ rct_tile_element *map_get_track_element_at_of_type(sint32 x, sint32 y, sint32 z,
  */
 rct_tile_element *map_get_track_element_at_of_type_seq(sint32 x, sint32 y, sint32 z, sint32 trackType, sint32 sequence)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tileElement == nullptr) break;
@@ -4596,6 +5324,9 @@ rct_tile_element *map_get_track_element_at_of_type_seq(sint32 x, sint32 y, sint3
  * @param ride index
  */
 rct_tile_element *map_get_track_element_at_of_type_from_ride(sint32 x, sint32 y, sint32 z, sint32 trackType, sint32 rideIndex) {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_TRACK) continue;
@@ -4617,6 +5348,9 @@ rct_tile_element *map_get_track_element_at_of_type_from_ride(sint32 x, sint32 y,
  * @param ride index
  */
 rct_tile_element *map_get_track_element_at_from_ride(sint32 x, sint32 y, sint32 z, sint32 rideIndex) {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_TRACK) continue;
@@ -4639,6 +5373,9 @@ rct_tile_element *map_get_track_element_at_from_ride(sint32 x, sint32 y, sint32
  */
 rct_tile_element *map_get_track_element_at_with_direction_from_ride(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 rideIndex)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_TRACK)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_TRACK) continue;
@@ -4676,6 +5413,9 @@ void map_offset_with_rotation(sint16 *x, sint16 *y, sint16 offsetX, sint16 offse
 
 rct_tile_element *map_get_wall_element_at(sint32 x, sint32 y, sint32 z, sint32 direction)
 {
+    if (!map_tile_may_contain(x >> 5, y >> 5, TILE_ELEMENT_TYPE_FLAG(TILE_ELEMENT_TYPE_WALL)))
+        return nullptr;
+
     rct_tile_element *tileElement = map_get_first_element_at(x >> 5, y >> 5);
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_WALL)
@@ -18,6 +18,7 @@
 #define _MAP_H_
 
 #include <initializer_list>
+#include <vector>
 #include "../common.h"
 #include "Location.h"
 
@@ -314,7 +315,12 @@ enum {
 
 #define MAP_MINIMUM_X_Y -MAXIMUM_MAP_SIZE_TECHNICAL
 
-#define MAX_TILE_ELEMENTS 196096 // 0x30000
+// Number of tile elements allocated at a time, about 1 MiB
+#define TILE_ELEMENT_BLOCK_SIZE 0x10000
+// Longest and most free runs of tile elements remembered for reuse per length
+#define TILE_ELEMENT_FREE_RUN_MAX_LENGTH 32
+#define TILE_ELEMENT_FREE_RUN_MAX_COUNT 4096
+#define TILE_ELEMENT_COMPACT_TILES_PER_TICK 256
 #define MAX_TILE_TILE_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 #define MAX_PEEP_SPAWNS 2
 #define PEEP_SPAWN_UNDEFINED 0xFFFF
@@ -323,6 +329,9 @@ enum {
 
 #define TILE_UNDEFINED_TILE_ELEMENT NULL
 
+// Bit for an element type in the masks used by map_tile_may_contain
+#define TILE_ELEMENT_TYPE_FLAG(type) (1 << ((type) >> 2))
+
 typedef CoordsXYZD PeepSpawn;
 
 struct CoordsXYE
@@ -391,15 +400,16 @@ extern bool         gMapVirtualFloorVisible;
 
 extern uint8 gMapGroundFlags;
 
-extern rct_tile_element gTileElements[MAX_TILE_TILE_ELEMENT_POINTERS * 3];
 extern rct_tile_element *gTileElementTilePointers[MAX_TILE_TILE_ELEMENT_POINTERS];
 
 extern LocationXY16 gMapSelectionTiles[300];
 extern PeepSpawn gPeepSpawns[MAX_PEEP_SPAWNS];
 
-extern rct_tile_element *gNextFreeTileElement;
 extern uint32 gNextFreeTileElementPointerIndex;
 
+// Incremented whenever tile elements are added or removed, or paths change in a way peep pathfinding can notice
+extern uint32 gMapModificationGeneration;
+
 // Used in the land tool window to enable mountain tool / land smoothing
 extern bool gLandMountainMode;
 // Used in the land tool window to allow dragging and changing land styles
@@ -420,6 +430,32 @@ void map_init(sint32 size);
 void map_count_remaining_land_rights();
 void map_strip_ghost_flag_from_elements();
 void map_update_tile_pointers();
+bool map_load_tile_elements(const rct_tile_element *elements, size_t count);
+std::vector<rct_tile_element> map_get_tile_elements();
+size_t map_get_tile_element_count();
+
+bool map_tile_may_contain(sint32 x, sint32 y, uint16 typeFlags);
+void map_update_tile_summaries();
+
+struct tile_element_stats
+{
+    size_t elements;
+    size_t free_slots;          // given up slots that are not yet compacted away
+    size_t capacity;
+    size_t blocks;
+    size_t free_runs;           // remembered runs, some may have been filled by compaction since
+    uint32 runs_reused;
+    uint32 tiles_compacted;
+    uint32 reorganisations;
+    uint64 last_reorganise_time; // microseconds
+};
+
+void map_compact_tile_elements();
+tile_element_stats map_get_tile_element_stats();
+
+void map_overlay_begin(const rct_tile_element *blankTile);
+void map_overlay_end();
+bool map_overlay_is_active();
 rct_tile_element *map_get_first_element_at(sint32 x, sint32 y);
 rct_tile_element *map_get_nth_element_at(sint32 x, sint32 y, sint32 n);
 void map_set_tile_elements(sint32 x, sint32 y, rct_tile_element *elements);
@@ -444,10 +480,15 @@ rct_tile_element *map_get_park_entrance_element_at(sint32 x, sint32 y, sint32 z,
 rct_tile_element * map_get_ride_entrance_element_at(sint32 x, sint32 y, sint32 z, bool ghost);
 rct_tile_element * map_get_ride_exit_element_at(sint32 x, sint32 y, sint32 z, bool ghost);
 sint32 tile_element_height(sint32 x, sint32 y);
+sint32 tile_element_height_uncached(sint32 x, sint32 y);
+void map_invalidate_surface_height(sint32 x, sint32 y);
+void map_invalidate_surface_heights();
 void sub_68B089();
 bool map_coord_is_connected(sint32 x, sint32 y, sint32 z, uint8 faceDirection);
 void map_remove_provisional_elements();
 void map_restore_provisional_elements();
+void map_invalidate_path_wide_flags(sint32 x, sint32 y);
+void map_invalidate_all_path_wide_flags();
 void map_update_path_wide_flags();
 bool map_is_location_valid(sint32 x, sint32 y);
 bool map_can_build_at(sint32 x, sint32 y, sint32 z);
@@ -527,6 +568,7 @@ void tile_element_iterator_restart_for_tile(tile_element_iterator *it);
 
 void wall_remove_intersecting_walls(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 direction);
 void map_update_tiles();
+void map_update_tiles_reset();
 sint32 map_get_highest_z(sint32 tileX, sint32 tileY);
 
 sint32 tile_element_get_banner_index(rct_tile_element *tileElement);
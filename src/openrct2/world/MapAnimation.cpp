@@ -14,6 +14,8 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <unordered_set>
+#include <vector>
 #include "../Game.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
@@ -25,13 +27,24 @@
 #include "SmallScenery.h"
 #include "Sprite.h"
 #include "Footpath.h"
+#include "LargeScenery.h"
 
 using map_animation_invalidate_event_handler = bool (*)(sint32 x, sint32 y, sint32 baseZ);
 
 static bool map_animation_invalidate(rct_map_animation *obj);
 
-uint16 gNumMapAnimations;
-rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
+static std::vector<rct_map_animation> _mapAnimations;
+static std::unordered_set<uint64> _mapAnimationKeys;
+
+static uint64 map_animation_get_key(sint32 type, sint32 x, sint32 y, sint32 z)
+{
+    return ((uint64)(uint8)type << 40) | ((uint64)(uint8)z << 32) | ((uint64)(uint16)x << 16) | (uint16)y;
+}
+
+static uint64 map_animation_get_key(const rct_map_animation * obj)
+{
+    return map_animation_get_key(obj->type, obj->x, obj->y, obj->baseZ);
+}
 
 /**
  *
@@ -44,31 +57,18 @@ rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
  */
 void map_animation_create(sint32 type, sint32 x, sint32 y, sint32 z)
 {
-    rct_map_animation *aobj = &gAnimatedObjects[0];
-    sint32 numAnimatedObjects = gNumMapAnimations;
-    if (numAnimatedObjects >= MAX_ANIMATED_OBJECTS) {
-        log_error("Exceeded the maximum number of animations");
-        return;
-    }
-    for (sint32 i = 0; i < numAnimatedObjects; i++, aobj++) {
-        if (aobj->x != x)
-            continue;
-        if (aobj->y != y)
-            continue;
-        if (aobj->baseZ != z)
-            continue;
-        if (aobj->type != type)
-            continue;
+    if (!_mapAnimationKeys.insert(map_animation_get_key(type, x, y, z)).second)
+    {
         // Animation already exists
         return;
     }
 
-    // Create new animation
-    gNumMapAnimations++;
-    aobj->type = type;
-    aobj->x = x;
-    aobj->y = y;
-    aobj->baseZ = z;
+    rct_map_animation aobj;
+    aobj.type = type;
+    aobj.x = x;
+    aobj.y = y;
+    aobj.baseZ = z;
+    _mapAnimations.push_back(aobj);
 }
 
 /**
@@ -77,20 +77,33 @@ void map_animation_create(sint32 type, sint32 x, sint32 y, sint32 z)
  */
 void map_animation_invalidate_all()
 {
-    rct_map_animation *aobj = &gAnimatedObjects[0];
-    sint32 numAnimatedObjects = gNumMapAnimations;
-    while (numAnimatedObjects > 0) {
-        if (map_animation_invalidate(aobj)) {
-            // Remove animated object
-            gNumMapAnimations--;
-            numAnimatedObjects--;
-            if (numAnimatedObjects > 0)
-                memmove(aobj, aobj + 1, numAnimatedObjects * sizeof(rct_map_animation));
-        } else {
-            numAnimatedObjects--;
-            aobj++;
+    // Finished animations are compacted out in a single pass, keeping the remaining ones in their original order
+    size_t numAnimatedObjects = _mapAnimations.size();
+    size_t numKept = 0;
+    for (size_t i = 0; i < numAnimatedObjects; i++)
+    {
+        rct_map_animation aobj = _mapAnimations[i];
+        if (map_animation_invalidate(&aobj))
+        {
+            _mapAnimationKeys.erase(map_animation_get_key(&aobj));
+        }
+        else
+        {
+            _mapAnimations[numKept++] = aobj;
         }
     }
+    _mapAnimations.erase(_mapAnimations.begin() + numKept, _mapAnimations.begin() + numAnimatedObjects);
+}
+
+void map_animation_reset()
+{
+    _mapAnimations.clear();
+    _mapAnimationKeys.clear();
+}
+
+const std::vector<rct_map_animation> &map_animation_get_all()
+{
+    return _mapAnimations;
 }
 
 /**
@@ -554,3 +567,84 @@ static bool map_animation_invalidate(rct_map_animation *obj)
     
     return _animatedObjectEventHandlers[obj->type](obj->x, obj->y, obj->baseZ);
 }
+
+/**
+ * Registers an animation for every element on the map that animates for as long as it exists. Used after loading a
+ * park whose animation list was cut short by the fixed size of the legacy save format. Transient animations such as
+ * opening doors and on-ride photos are left for the vehicles to recreate.
+ */
+void map_animation_auto_create()
+{
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        rct_tile_element * tileElement = it.element;
+        sint32 x = it.x * 32;
+        sint32 y = it.y * 32;
+        rct_scenery_entry * sceneryEntry;
+        switch (tile_element_get_type(tileElement))
+        {
+        case TILE_ELEMENT_TYPE_PATH:
+            if (footpath_element_is_queue(tileElement) && footpath_element_has_queue_banner(tileElement))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_QUEUE_BANNER, x, y, tileElement->base_height);
+            }
+            break;
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            sceneryEntry = get_small_scenery_entry(tileElement->properties.scenery.type);
+            if (sceneryEntry != nullptr && scenery_small_entry_has_flag(sceneryEntry, SMALL_SCENERY_FLAG_ANIMATED))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_SMALL_SCENERY, x, y, tileElement->base_height);
+            }
+            break;
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+            sceneryEntry = get_large_scenery_entry(scenery_large_get_type(tileElement));
+            if (sceneryEntry != nullptr && (sceneryEntry->large_scenery.flags & LARGE_SCENERY_FLAG_ANIMATED))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_LARGE_SCENERY, x, y, tileElement->base_height);
+            }
+            break;
+        case TILE_ELEMENT_TYPE_WALL:
+            sceneryEntry = get_wall_entry(tileElement->properties.scenery.type);
+            if (sceneryEntry != nullptr &&
+                ((sceneryEntry->wall.flags2 & WALL_SCENERY_2_ANIMATED) || sceneryEntry->wall.scrolling_mode != 255))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_WALL, x, y, tileElement->base_height);
+            }
+            break;
+        case TILE_ELEMENT_TYPE_BANNER:
+            map_animation_create(MAP_ANIMATION_TYPE_BANNER, x, y, tileElement->base_height);
+            break;
+        case TILE_ELEMENT_TYPE_ENTRANCE:
+            if (tileElement->properties.entrance.type == ENTRANCE_TYPE_RIDE_ENTRANCE)
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, x, y, tileElement->base_height);
+            }
+            else if (tileElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE &&
+                     !(tileElement->properties.entrance.index & 0x0F))
+            {
+                map_animation_create(MAP_ANIMATION_TYPE_PARK_ENTRANCE, x, y, tileElement->base_height);
+            }
+            break;
+        case TILE_ELEMENT_TYPE_TRACK:
+            switch (track_element_get_type(tileElement))
+            {
+            case TRACK_ELEM_WATERFALL:
+                map_animation_create(MAP_ANIMATION_TYPE_TRACK_WATERFALL, x, y, tileElement->base_height);
+                break;
+            case TRACK_ELEM_RAPIDS:
+                map_animation_create(MAP_ANIMATION_TYPE_TRACK_RAPIDS, x, y, tileElement->base_height);
+                break;
+            case TRACK_ELEM_WHIRLPOOL:
+                map_animation_create(MAP_ANIMATION_TYPE_TRACK_WHIRLPOOL, x, y, tileElement->base_height);
+                break;
+            case TRACK_ELEM_SPINNING_TUNNEL:
+                map_animation_create(MAP_ANIMATION_TYPE_TRACK_SPINNINGTUNNEL, x, y, tileElement->base_height);
+                break;
+            }
+            break;
+        }
+    }
+    while (tile_element_iterator_next(&it));
+}
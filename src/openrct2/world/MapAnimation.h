@@ -17,6 +17,7 @@
 #ifndef _MAP_ANIMATION_H_
 #define _MAP_ANIMATION_H_
 
+#include <vector>
 #include "../common.h"
 
 #pragma pack(push, 1)
@@ -51,12 +52,10 @@ enum {
     MAP_ANIMATION_TYPE_COUNT
 };
 
-#define MAX_ANIMATED_OBJECTS 2000
-
-extern uint16 gNumMapAnimations;
-extern rct_map_animation gAnimatedObjects[MAX_ANIMATED_OBJECTS];
-
 void map_animation_create(sint32 type, sint32 x, sint32 y, sint32 z);
 void map_animation_invalidate_all();
+void map_animation_reset();
+void map_animation_auto_create();
+const std::vector<rct_map_animation> &map_animation_get_all();
 
 #endif
@@ -15,11 +15,14 @@
 #pragma endregion
 
 #include "../common.h"
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 #include "../Context.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Math.hpp"
 #include "../core/String.hpp"
 #include "../core/Util.hpp"
@@ -116,6 +119,28 @@ static void set_height(sint32 x, sint32 y, sint32 height)
         _height[x + y * _heightSize] = height;
 }
 
+/**
+ * Calls func(firstRow, endRow) for bands of the rows in [firstRow, endRow) spread over the job pool. Each row must
+ * only depend on the input of the pass, so the result is the same however the rows are split up.
+ */
+template<typename TFunc>
+static void mapgen_for_each_row_band(sint32 firstRow, sint32 endRow, TFunc func)
+{
+    JobPool * jobPool = JobPool::GetShared();
+    sint32 numRows = endRow - firstRow;
+    sint32 numBands = std::min<sint32>((sint32)jobPool->GetThreadCount() * 4, numRows);
+    for (sint32 i = 0; i < numBands; i++)
+    {
+        sint32 bandFirstRow = firstRow + (numRows * i) / numBands;
+        sint32 bandEndRow = firstRow + (numRows * (i + 1)) / numBands;
+        jobPool->AddTask([func, bandFirstRow, bandEndRow]() -> void
+        {
+            func(bandFirstRow, bandEndRow);
+        });
+    }
+    jobPool->Join();
+}
+
 void mapgen_generate_blank(mapgen_settings * settings)
 {
     sint32 x, y;
@@ -144,7 +169,7 @@ void mapgen_generate(mapgen_settings * settings)
     sint32 x, y, mapSize, floorTexture, wallTexture, waterLevel;
     rct_tile_element * tileElement;
 
-    util_srand((sint32) platform_get_ticks());
+    util_srand(settings->seed != 0 ? (sint32) settings->seed : (sint32) platform_get_ticks());
 
     mapSize      = settings->mapSize;
     floorTexture = settings->floor;
@@ -198,6 +223,7 @@ void mapgen_generate(mapgen_settings * settings)
     // Set the game map to the height map
     mapgen_set_height();
     delete[] _height;
+    map_invalidate_surface_heights();
 
     // Set the tile slopes so that there are no cliffs
     while (map_smooth(1, 1, mapSize - 1, mapSize - 1)) {}
@@ -407,6 +433,7 @@ static void mapgen_set_water_level(sint32 waterLevel)
                 tileElement->properties.surface.terrain |= (waterLevel / 2);
         }
     }
+    map_invalidate_surface_heights();
 }
 
 /**
@@ -414,32 +441,33 @@ static void mapgen_set_water_level(sint32 waterLevel)
  */
 static void mapgen_smooth_height(sint32 iterations)
 {
-    sint32 i, x, y, xx, yy, avg;
-    sint32 arraySize = _heightSize * _heightSize * sizeof(uint8);
-    uint8 * copyHeight = new uint8[arraySize];
+    std::vector<uint8> copyHeight(_heightSize * _heightSize);
 
-    for (i = 0; i < iterations; i++)
+    for (sint32 i = 0; i < iterations; i++)
     {
-        memcpy(copyHeight, _height, arraySize);
-        for (y = 1; y < _heightSize - 1; y++)
+        std::copy_n(_height, copyHeight.size(), copyHeight.begin());
+        mapgen_for_each_row_band(1, _heightSize - 1, [&copyHeight](sint32 firstRow, sint32 endRow) -> void
         {
-            for (x = 1; x < _heightSize - 1; x++)
+            // Each tile becomes the average of the 3x3 tiles around it, summed as three columns of three
+            std::vector<uint16> columnSums(_heightSize);
+            for (sint32 y = firstRow; y < endRow; y++)
             {
-                avg     = 0;
-                for (yy = -1; yy <= 1; yy++)
+                const uint8 * above = &copyHeight[(y - 1) * _heightSize];
+                const uint8 * row   = &copyHeight[y * _heightSize];
+                const uint8 * below = &copyHeight[(y + 1) * _heightSize];
+                for (sint32 x = 0; x < _heightSize; x++)
+                {
+                    columnSums[x] = above[x] + row[x] + below[x];
+                }
+
+                uint8 * dest = &_height[y * _heightSize];
+                for (sint32 x = 1; x < _heightSize - 1; x++)
                 {
-                    for (xx = -1; xx <= 1; xx++)
-                    {
-                        avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
-                    }
+                    dest[x] = (columnSums[x - 1] + columnSums[x] + columnSums[x + 1]) / 9;
                 }
-                avg /= 9;
-                set_height(x, y, avg);
             }
-        }
+        });
     }
-
-    delete[] copyHeight;
 }
 
 /**
@@ -618,8 +646,6 @@ static float grad(sint32 hash, float x, float y)
 
 static void mapgen_simplex(mapgen_settings * settings)
 {
-    sint32 x, y;
-
     float  freq    = settings->simplex_base_freq * (1.0f / _heightSize);
     sint32 octaves = settings->simplex_octaves;
 
@@ -627,53 +653,163 @@ static void mapgen_simplex(mapgen_settings * settings)
     sint32 high = settings->simplex_high;
 
     noise_rand();
-    for (y = 0; y < _heightSize; y++)
+
+    // Every point only reads the permutation table, so the rows can be generated at the same time
+    mapgen_for_each_row_band(0, _heightSize, [freq, octaves, low, high](sint32 firstRow, sint32 endRow) -> void
     {
-        for (x = 0; x < _heightSize; x++)
+        for (sint32 y = firstRow; y < endRow; y++)
         {
-            float noiseValue           = Math::Clamp(-1.0f, fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), 1.0f);
-            float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+            for (sint32 x = 0; x < _heightSize; x++)
+            {
+                float noiseValue           = Math::Clamp(-1.0f, fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), 1.0f);
+                float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-            set_height(x, y, low + (sint32) (normalisedNoiseValue * high));
+                set_height(x, y, low + (sint32) (normalisedNoiseValue * high));
+            }
         }
-    }
+    });
 }
 
 #pragma endregion
 
 #pragma region Heightmap
 
+/**
+ * Averages the rows of a source image into a square height map as they are read, so a large image never has to be
+ * held in memory. Each height map value is the mean grey level of the block of pixels that covers it.
+ */
+class HeightMapDownsampler final
+{
+private:
+    uint32              _sourceSize;
+    uint32              _size;
+    uint8 *             _dest;
+    std::vector<uint16> _columnIndices;
+    std::vector<uint32> _columnCounts;
+    std::vector<uint64> _sums;
+    uint32              _row = 0;
+    uint32              _rowCount = 0;
+
+public:
+    HeightMapDownsampler(uint32 sourceSize, uint32 size, uint8 * dest)
+        : _sourceSize(sourceSize),
+          _size(size),
+          _dest(dest),
+          _columnIndices(sourceSize),
+          _columnCounts(size),
+          _sums(size)
+    {
+        for (uint32 x = 0; x < sourceSize; x++)
+        {
+            _columnIndices[x] = (uint16)(((uint64)x * size) / sourceSize);
+            _columnCounts[_columnIndices[x]]++;
+        }
+    }
+
+    void AddRow(uint32 y, const uint8 * pixels, uint32 numChannels)
+    {
+        uint32 row = (uint32)(((uint64)y * _size) / _sourceSize);
+        if (row != _row)
+        {
+            Flush();
+            _row = row;
+        }
+
+        for (uint32 x = 0; x < _sourceSize; x++)
+        {
+            const uint8 * pixel = &pixels[x * numChannels];
+            _sums[_columnIndices[x]] += (pixel[0] + pixel[1] + pixel[2]) / 3;
+        }
+        _rowCount++;
+    }
+
+    void Flush()
+    {
+        if (_rowCount == 0)
+        {
+            return;
+        }
+
+        uint8 * dest = &_dest[_row * _size];
+        for (uint32 x = 0; x < _size; x++)
+        {
+            dest[x] = (uint8)(_sums[x] / ((uint64)_columnCounts[x] * _rowCount));
+            _sums[x] = 0;
+        }
+        _rowCount = 0;
+    }
+};
+
 bool mapgen_load_heightmap(const utf8 * path)
 {
     const char * extension = path_get_extension(path);
-    uint8      * pixels;
-    size_t pitch;
-    uint32 numChannels;
-    uint32 width, height;
+    uint8 * monoBitmap = nullptr;
+    uint32 size = 0;
+    bool sizeMismatch = false;
+
+    // Images larger than the map are scaled down to fit
+    auto allocateBitmap = [&](uint32 width, uint32 height) -> bool
+    {
+        if (width != height || width == 0)
+        {
+            sizeMismatch = true;
+            return false;
+        }
+        size = Math::Min(width, (uint32)MAXIMUM_MAP_SIZE_PRACTICAL);
+        monoBitmap = new uint8[size * size];
+        return true;
+    };
 
     if (String::Equals(extension, ".png", false))
     {
-        sint32 bitDepth;
-        if (!image_io_png_read(&pixels, &width, &height, true, path, &bitDepth))
+        std::unique_ptr<HeightMapDownsampler> downsampler;
+        bool result = Imaging::PngReadRows(path,
+            [&](uint32 width, uint32 height) -> bool
+            {
+                if (!allocateBitmap(width, height))
+                {
+                    return false;
+                }
+                downsampler = std::make_unique<HeightMapDownsampler>(width, size, monoBitmap);
+                return true;
+            },
+            [&](uint32 y, const uint8 * rgb) -> void
+            {
+                downsampler->AddRow(y, rgb, 3);
+            });
+
+        if (!result && !sizeMismatch)
         {
             log_warning("Error reading PNG");
             context_show_error(STR_HEIGHT_MAP_ERROR, STR_ERROR_READING_PNG);
+            delete[] monoBitmap;
             return false;
         }
-
-        numChannels = 4;
-        pitch       = width * numChannels;
+        if (result)
+        {
+            downsampler->Flush();
+        }
     }
     else if (strcicmp(extension, ".bmp") == 0)
     {
+        uint8 * pixels;
+        uint32 width, height;
         if (!context_read_bmp((void **) &pixels, &width, &height, path))
         {
             // ReadBMP contains context_show_error calls
             return false;
         }
 
-        numChannels = 4;
-        pitch       = width * numChannels;
+        if (allocateBitmap(width, height))
+        {
+            HeightMapDownsampler downsampler(width, size, monoBitmap);
+            for (uint32 y = 0; y < height; y++)
+            {
+                downsampler.AddRow(y, &pixels[y * width * 4], 4);
+            }
+            downsampler.Flush();
+        }
+        free(pixels);
     }
     else
     {
@@ -681,38 +817,16 @@ bool mapgen_load_heightmap(const utf8 * path)
         return false;
     }
 
-    if (width != height)
+    if (sizeMismatch)
     {
         context_show_error(STR_HEIGHT_MAP_ERROR, STR_ERROR_WIDTH_AND_HEIGHT_DO_NOT_MATCH);
-        free(pixels);
         return false;
     }
 
-    if (width > MAXIMUM_MAP_SIZE_PRACTICAL)
-    {
-        context_show_error(STR_HEIGHT_MAP_ERROR, STR_ERROR_HEIHGT_MAP_TOO_BIG);
-        width = height = Math::Min(height, (uint32)MAXIMUM_MAP_SIZE_PRACTICAL);
-    }
-
-    // Allocate memory for the height map values, one byte pixel
     delete[] _heightMapData.mono_bitmap;
-    _heightMapData.mono_bitmap = new uint8[width * height];
-    _heightMapData.width       = width;
-    _heightMapData.height      = height;
-
-    // Copy average RGB value to mono bitmap
-    for (uint32 x = 0; x < _heightMapData.width; x++)
-    {
-        for (uint32 y = 0; y < _heightMapData.height; y++)
-        {
-            const uint8 red   = pixels[x * numChannels + y * pitch];
-            const uint8 green = pixels[x * numChannels + y * pitch + 1];
-            const uint8 blue  = pixels[x * numChannels + y * pitch + 2];
-            _heightMapData.mono_bitmap[x + y * _heightMapData.width] = (red + green + blue) / 3;
-        }
-    }
-
-    free(pixels);
+    _heightMapData.mono_bitmap = monoBitmap;
+    _heightMapData.width       = size;
+    _heightMapData.height      = size;
     return true;
 }
 
@@ -727,51 +841,51 @@ void mapgen_unload_heightmap()
 }
 
 /**
- * Applies box blur to the surface N times
+ * Applies box blur to the surface N times. The 3x3 box is split into a horizontal and a vertical pass, and only the
+ * horizontal sums of the three rows around the one being written are kept, so each pass streams through the map once.
  */
-static void mapgen_smooth_heightmap(uint8 * src, sint32 strength)
+static void mapgen_smooth_heightmap(std::vector<uint8> &src, sint32 strength)
 {
-    // Create buffer to store one channel
-    uint8 * dest = new uint8[_heightMapData.width * _heightMapData.height];
+    const sint32 width = (sint32)_heightMapData.width;
+    const sint32 height = (sint32)_heightMapData.height;
+    std::vector<uint8> dest(src.size());
+    std::vector<uint16> rowSums[3];
+    for (auto &rowSum : rowSums)
+    {
+        rowSum.resize(width);
+    }
 
-    for (sint32 i = 0; i < strength; i++)
+    // Sums each pixel with its left and right neighbour. Clamping to the image assumes the height map is not tiled,
+    // and increases the weight of the edges.
+    auto sumRow = [&](sint32 y, uint16 * rowSum) -> void
     {
-        // Calculate box blur value to all pixels of the surface
-        for (uint32 y = 0; y < _heightMapData.height; y++)
+        const uint8 * row = &src[Math::Clamp(y, 0, height - 1) * width];
+        for (sint32 x = 0; x < width; x++)
         {
-            for (uint32 x = 0; x < _heightMapData.width; x++)
-            {
-                uint32 heightSum = 0;
-
-                // Loop over neighbour pixels, all of them have the same weight
-                for (sint8 offsetX = -1; offsetX <= 1; offsetX++)
-                {
-                    for (sint8 offsetY = -1; offsetY <= 1; offsetY++)
-                    {
-                        // Clamp x and y so they stay within the image
-                        // This assumes the height map is not tiled, and increases the weight of the edges
-                        const sint32 readX = Math::Clamp((sint32) x + offsetX, 0, (sint32) _heightMapData.width - 1);
-                        const sint32 readY = Math::Clamp((sint32) y + offsetY, 0, (sint32) _heightMapData.height - 1);
-                        heightSum += src[readX + readY * _heightMapData.width];
-                    }
-                }
-
-                // Take average
-                dest[x + y * _heightMapData.width] = heightSum / 9;
-            }
+            rowSum[x] = row[Math::Max(x - 1, 0)] + row[x] + row[Math::Min(x + 1, width - 1)];
         }
+    };
 
-        // Now apply the blur to the source pixels
-        for (uint32 y = 0; y < _heightMapData.height; y++)
+    for (sint32 i = 0; i < strength; i++)
+    {
+        sumRow(-1, rowSums[0].data());
+        sumRow(0, rowSums[1].data());
+        for (sint32 y = 0; y < height; y++)
         {
-            for (uint32 x = 0; x < _heightMapData.width; x++)
+            const uint16 * above = rowSums[y % 3].data();
+            const uint16 * centre = rowSums[(y + 1) % 3].data();
+            uint16 * below = rowSums[(y + 2) % 3].data();
+            sumRow(y + 1, below);
+
+            // Take average
+            uint8 * destRow = &dest[y * width];
+            for (sint32 x = 0; x < width; x++)
             {
-                src[x + y * _heightMapData.width] = dest[x + y * _heightMapData.width];
+                destRow[x] = (above[x] + centre[x] + below[x]) / 9;
             }
         }
+        src.swap(dest);
     }
-
-    delete[] dest;
 }
 
 void mapgen_generate_from_heightmap(mapgen_settings * settings)
@@ -781,8 +895,8 @@ void mapgen_generate_from_heightmap(mapgen_settings * settings)
     openrct2_assert(settings->simplex_high != settings->simplex_low, "Low and high setting cannot be the same");
 
     // Make a copy of the original height map that we can edit
-    uint8 * dest = new uint8[_heightMapData.width * _heightMapData.height];
-    memcpy(dest, _heightMapData.mono_bitmap, _heightMapData.width * _heightMapData.width);
+    const uint8 * monoBitmap = _heightMapData.mono_bitmap;
+    std::vector<uint8> dest(monoBitmap, monoBitmap + _heightMapData.width * _heightMapData.height);
 
     map_init(_heightMapData.width + 2); // + 2 for the black tiles around the map
 
@@ -812,7 +926,6 @@ void mapgen_generate_from_heightmap(mapgen_settings * settings)
         if (minValue == maxValue)
         {
             context_show_error(STR_HEIGHT_MAP_ERROR, STR_ERROR_CANNOT_NORMALIZE);
-            delete[] dest;
             return;
         }
     }
@@ -848,6 +961,8 @@ void mapgen_generate_from_heightmap(mapgen_settings * settings)
         }
     }
 
+    map_invalidate_surface_heights();
+
     // Smooth map
     if (settings->smooth)
     {
@@ -867,9 +982,6 @@ void mapgen_generate_from_heightmap(mapgen_settings * settings)
                 break;
         }
     }
-
-    // Clean up
-    delete[] dest;
 }
 
 #pragma endregion
@@ -30,6 +30,9 @@ struct mapgen_settings
     // Features (e.g. tree, rivers, lakes etc.)
     sint32 trees;
 
+    // Seed of the random terrain, 0 for a new one every time
+    uint32 seed = 0;
+
     // Simplex Noise Parameters
     sint32 simplex_low;
     sint32 simplex_high;
@@ -31,6 +31,7 @@ sint32 map_smooth(sint32 l, sint32 t, sint32 r, sint32 b)
         for (x = l; x < r; x++) {
             tileElement = map_get_surface_element_at(x, y);
             tileElement->properties.surface.slope &= ~TILE_ELEMENT_SURFACE_SLOPE_MASK;
+            map_invalidate_surface_height(x, y);
 
             // Raise to edge height - 2
             highest = tileElement->base_height;
@@ -265,6 +266,7 @@ sint32 tile_smooth(sint32 x, sint32 y)
 
     // Remove old slope value
     surfaceElement->properties.surface.slope &= ~TILE_ELEMENT_SURFACE_SLOPE_MASK;
+    map_invalidate_surface_height(x, y);
     if ((slope & TILE_ELEMENT_SLOPE_ALL_CORNERS_UP) == TILE_ELEMENT_SLOPE_ALL_CORNERS_UP)
     {
         // All corners are raised, raise the entire tile instead.
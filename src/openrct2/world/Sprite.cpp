@@ -14,6 +14,9 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include "../audio/audio.h"
 #include "../Cheats.h"
 #include "../core/Math.hpp"
@@ -28,9 +31,19 @@
 
 uint16 gSpriteListHead[6];
 uint16 gSpriteListCount[6];
-static rct_sprite _spriteList[MAX_SPRITES];
+// Sprites are stored in fixed size blocks so that growing the store never moves existing sprites
+#define SPRITE_BLOCK_SHIFT 11
+#define SPRITE_BLOCK_SIZE (1 << SPRITE_BLOCK_SHIFT)
+#define SPRITE_BLOCK_COUNT ((MAX_SPRITES_LIMIT + SPRITE_BLOCK_SIZE - 1) / SPRITE_BLOCK_SIZE)
 
-static bool _spriteFlashingList[MAX_SPRITES];
+static std::unique_ptr<rct_sprite[]> _spriteBlocks[SPRITE_BLOCK_COUNT];
+static size_t _spriteCapacity;
+
+static std::vector<bool> _spriteFlashingList;
+
+/* The list each sprite is in, kept apart from the sprites themselves so
+ * that passes over every slot only touch the sprites they are after. */
+static std::vector<uint8> _spriteListType;
 
 #define SPATIAL_INDEX_LOCATION_NULL 0x10000
 
@@ -51,25 +64,127 @@ const rct_string_id litterNames[12] = {
     STR_SHOP_ITEM_SINGULAR_EMPTY_BOWL_BLUE
 };
 
-static LocationXYZ16 _spritelocations1[MAX_SPRITES];
-static LocationXYZ16 _spritelocations2[MAX_SPRITES];
+static std::vector<LocationXYZ16> _spritelocations1;
+static std::vector<LocationXYZ16> _spritelocations2;
+
+// Litter is indexed in blocks of 4x4 tiles
+#define LITTER_INDEX_BLOCK_SHIFT 7
+#define LITTER_INDEX_SIZE (MAXIMUM_MAP_SIZE_TECHNICAL / 4)
+
+static std::vector<uint16> _litterIndex[LITTER_INDEX_SIZE * LITTER_INDEX_SIZE];
+static bool _litterIndexValid;
+
+/* The position of each sprite in its sprite list, so that spatial queries
+ * can return sprites in the order the lists are iterated. Sprites are
+ * always added to the head of a list, so a higher order is nearer the
+ * head. */
+static std::vector<uint32> _spriteListOrder;
+static uint32 _spriteListNextOrder;
+static bool _spriteListOrderValid;
+
+// How far sprite_query_nearest searches tile by tile before scanning the whole sprite list instead
+#define SPRITE_QUERY_MAX_RING 16
 
 static size_t GetSpatialIndexOffset(sint32 x, sint32 y);
+static void litter_index_remove(rct_litter *litter);
+
+static rct_sprite * get_sprite_slot(size_t spriteIndex)
+{
+    return &_spriteBlocks[spriteIndex >> SPRITE_BLOCK_SHIFT][spriteIndex & (SPRITE_BLOCK_SIZE - 1)];
+}
 
 rct_sprite *try_get_sprite(size_t spriteIndex)
 {
     rct_sprite * sprite = nullptr;
-    if (spriteIndex < MAX_SPRITES)
+    if (spriteIndex < _spriteCapacity)
     {
-        sprite = &_spriteList[spriteIndex];
+        sprite = get_sprite_slot(spriteIndex);
     }
     return sprite;
 }
 
 rct_sprite *get_sprite(size_t sprite_idx)
 {
-    openrct2_assert(sprite_idx < MAX_SPRITES, "Tried getting sprite %u", sprite_idx);
-    return &_spriteList[sprite_idx];
+    openrct2_assert(sprite_idx < _spriteCapacity, "Tried getting sprite %u", sprite_idx);
+    return get_sprite_slot(sprite_idx);
+}
+
+size_t sprite_get_capacity()
+{
+    return _spriteCapacity;
+}
+
+/**
+ * Sets the number of sprite slots. New slots are zeroed and not linked into any list, that is left to the caller.
+ */
+void sprite_set_capacity(size_t capacity)
+{
+    capacity = std::min<size_t>(capacity, MAX_SPRITES_LIMIT);
+    size_t numBlocks = (capacity + SPRITE_BLOCK_SIZE - 1) >> SPRITE_BLOCK_SHIFT;
+    for (size_t i = 0; i < SPRITE_BLOCK_COUNT; i++)
+    {
+        if (i >= numBlocks)
+        {
+            _spriteBlocks[i].reset();
+        }
+        else if (_spriteBlocks[i] == nullptr)
+        {
+            _spriteBlocks[i] = std::make_unique<rct_sprite[]>(SPRITE_BLOCK_SIZE);
+        }
+    }
+    for (size_t i = _spriteCapacity; i < capacity; i++)
+    {
+        memset(get_sprite_slot(i), 0, sizeof(rct_sprite));
+    }
+
+    _spriteCapacity = capacity;
+    _spriteFlashingList.resize(capacity);
+    _spriteListType.resize(capacity);
+    _spritelocations1.resize(capacity);
+    _spritelocations2.resize(capacity);
+    _spriteListOrder.resize(capacity);
+}
+
+/**
+ * The number of sprites that can still be created, including slots the store can grow by.
+ */
+uint32 sprite_get_free_count()
+{
+    return gSpriteListCount[SPRITE_LIST_NULL] + (uint32)(MAX_SPRITES_LIMIT - _spriteCapacity);
+}
+
+/**
+ * Adds a block of slots to the sprite store and links them into the null list, lowest index first.
+ */
+static bool sprite_grow()
+{
+    size_t oldCapacity = _spriteCapacity;
+    if (oldCapacity >= MAX_SPRITES_LIMIT)
+    {
+        return false;
+    }
+
+    sprite_set_capacity(oldCapacity + SPRITE_BLOCK_SIZE);
+    for (size_t i = _spriteCapacity; i-- > oldCapacity;)
+    {
+        rct_unk_sprite * sprite = &get_sprite(i)->unknown;
+        sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        sprite->sprite_index = (uint16)i;
+        sprite->linked_list_type_offset = SPRITE_LIST_NULL * 2;
+        sprite->next_in_quadrant = SPRITE_INDEX_NULL;
+        sprite->previous = SPRITE_INDEX_NULL;
+        sprite->next = gSpriteListHead[SPRITE_LIST_NULL];
+        if (sprite->next != SPRITE_INDEX_NULL)
+        {
+            get_sprite(sprite->next)->unknown.previous = (uint16)i;
+        }
+        gSpriteListHead[SPRITE_LIST_NULL] = (uint16)i;
+        gSpriteListCount[SPRITE_LIST_NULL]++;
+        _spriteListType[i] = SPRITE_LIST_NULL;
+        _spriteListOrder[i] = _spriteListNextOrder++;
+    }
+    log_verbose("Sprite storage grown to %u slots", (uint32)_spriteCapacity);
+    return true;
 }
 
 uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y)
@@ -132,17 +247,19 @@ void invalidate_sprite_2(rct_sprite *sprite)
 void reset_sprite_list()
 {
     gSavedAge = 0;
-    memset(_spriteList, 0, sizeof(rct_sprite) * MAX_SPRITES);
+
+    // Release any blocks the previous park grew by, the remaining slots are cleared to zero
+    sprite_set_capacity(0);
+    sprite_set_capacity(MAX_SPRITES_INITIAL);
 
     for (sint32 i = 0; i < NUM_SPRITE_LISTS; i++) {
         gSpriteListHead[i] = SPRITE_INDEX_NULL;
         gSpriteListCount[i] = 0;
-        _spriteFlashingList[i] = false;
     }
 
     rct_sprite* previous_spr = (rct_sprite*)SPRITE_INDEX_NULL;
 
-    for (sint32 i = 0; i < MAX_SPRITES; ++i){
+    for (sint32 i = 0; i < MAX_SPRITES_INITIAL; ++i){
         rct_sprite *spr = get_sprite(i);
         spr->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
         spr->unknown.sprite_index = i;
@@ -161,7 +278,7 @@ void reset_sprite_list()
         previous_spr = spr;
     }
 
-    gSpriteListCount[SPRITE_LIST_NULL] = MAX_SPRITES;
+    gSpriteListCount[SPRITE_LIST_NULL] = MAX_SPRITES_INITIAL;
 
     reset_sprite_spatial_index();
 }
@@ -174,8 +291,10 @@ void reset_sprite_list()
  */
 void reset_sprite_spatial_index()
 {
+    litter_index_invalidate();
+    sprite_list_order_invalidate();
     memset(gSpriteSpatialIndex, SPRITE_INDEX_NULL, sizeof(gSpriteSpatialIndex));
-    for (size_t i = 0; i < MAX_SPRITES; i++) {
+    for (size_t i = 0; i < _spriteCapacity; i++) {
         rct_sprite *spr = get_sprite(i);
         if (spr->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL) {
             size_t index = GetSpatialIndexOffset(spr->unknown.x, spr->unknown.y);
@@ -202,58 +321,147 @@ static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
     return index;
 }
 
-#ifndef DISABLE_NETWORK
+// clang-format off
+static constexpr const char * SpriteChecksumGroupNames[SPRITE_CHECKSUM_GROUP_COUNT] =
+{
+    "vehicles",
+    "peeps",
+    "litter",
+};
+// clang-format on
+
+static constexpr size_t SPRITE_CHECKSUM_GROUP_LENGTH = 16;
 
-static uint8 _spriteChecksum[EVP_MAX_MD_SIZE + 1];
+static char _spriteChecksum[SPRITE_CHECKSUM_GROUP_COUNT * SPRITE_CHECKSUM_GROUP_LENGTH + 1];
 
-const char * sprite_checksum()
+static sint32 sprite_checksum_get_group(const rct_sprite * sprite)
+{
+    switch (sprite->unknown.sprite_identifier)
+    {
+    case SPRITE_IDENTIFIER_VEHICLE:
+        return SPRITE_CHECKSUM_GROUP_VEHICLES;
+    case SPRITE_IDENTIFIER_PEEP:
+        return SPRITE_CHECKSUM_GROUP_PEEPS;
+    case SPRITE_IDENTIFIER_LITTER:
+        return SPRITE_CHECKSUM_GROUP_LITTER;
+    default:
+        // Misc sprites are partly created by the local UI (e.g. money effects), so they are not compared
+        return -1;
+    }
+}
+
+static uint64 sprite_checksum_mix(uint64 hash, uint64 value)
 {
-    if (EVP_DigestInit_ex(gHashCTX, EVP_sha1(), NULL) <= 0)
+    hash ^= value * 0x9E3779B97F4A7C15ULL;
+    hash = (hash << 31) | (hash >> 33);
+    return hash * 0xBF58476D1CE4E5B9ULL;
+}
+
+static uint64 sprite_checksum_finalise(uint64 hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * Hashes the game state of every vehicle, peep and litter sprite, keeping a separate digest for each group so that a
+ * desync can be narrowed down to the kind of entity that diverged.
+ */
+rct_sprite_checksum sprite_checksum_compute()
+{
+    rct_sprite_checksum checksum;
+    uint64 counts[SPRITE_CHECKSUM_GROUP_COUNT] = { 0 };
+    for (auto &hash : checksum.groups)
     {
-        openrct2_assert(false, "Failed to initialise SHA1 engine");
+        hash = 0x6A09E667F3BCC908ULL;
     }
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+
+    for (size_t i = 0; i < _spriteCapacity; i++)
     {
-        rct_sprite *sprite = get_sprite(i);
-        if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_MISC)
+        const rct_sprite * sprite = get_sprite(i);
+        sint32 group = sprite_checksum_get_group(sprite);
+        if (group == -1)
         {
-            rct_sprite copy = *sprite;
-            copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
+            continue;
+        }
 
-            if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
-                // We set this to 0 because as soon the client selects a guest the window will remove the
-                // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
-                copy.peep.window_invalidate_flags = 0;
-            }
+        rct_sprite copy = *sprite;
+        copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
 
-            if (EVP_DigestUpdate(gHashCTX, &copy, sizeof(rct_sprite)) <= 0)
-            {
-                openrct2_assert(false, "Failed to update digest");
-            }
+        if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+            // We set this to 0 because as soon the client selects a guest the window will remove the
+            // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
+            copy.peep.window_invalidate_flags = 0;
         }
+
+        uint64 hash = checksum.groups[group];
+        for (size_t offset = 0; offset < sizeof(rct_sprite); offset += sizeof(uint64))
+        {
+            uint64 value;
+            memcpy(&value, &copy.pad_00[offset], sizeof(value));
+            hash = sprite_checksum_mix(hash, value);
+        }
+        checksum.groups[group] = hash;
+        counts[group]++;
     }
-    uint8 localhash[EVP_MAX_MD_SIZE + 1];
-    uint32 size = sizeof(localhash);
-    EVP_DigestFinal(gHashCTX, localhash, &size);
-    assert(size <= sizeof(localhash));
-    localhash[sizeof(localhash) - 1] = '\0';
-    char *x = (char *)_spriteChecksum;
-    for (uint32 i = 0; i < size; i++)
+
+    for (sint32 group = 0; group < SPRITE_CHECKSUM_GROUP_COUNT; group++)
     {
-        snprintf(x, EVP_MAX_MD_SIZE + 1, "%02x", localhash[i]);
-        x += 2;
+        checksum.groups[group] = sprite_checksum_finalise(sprite_checksum_mix(checksum.groups[group], counts[group]));
     }
-    *x = '\0';
-    return (char *)_spriteChecksum;
+    return checksum;
 }
-#else
 
+/**
+ * Returns the checksum as a string of one fixed width hexadecimal digest per group.
+ */
 const char * sprite_checksum()
 {
-    return nullptr;
+    rct_sprite_checksum checksum = sprite_checksum_compute();
+    char * dst = _spriteChecksum;
+    for (uint64 hash : checksum.groups)
+    {
+        snprintf(dst, SPRITE_CHECKSUM_GROUP_LENGTH + 1, "%08x%08x", (uint32)(hash >> 32), (uint32)hash);
+        dst += SPRITE_CHECKSUM_GROUP_LENGTH;
+    }
+    return _spriteChecksum;
+}
+
+const char * sprite_checksum_get_group_name(sint32 group)
+{
+    if (group < 0 || group >= SPRITE_CHECKSUM_GROUP_COUNT)
+    {
+        return nullptr;
+    }
+    return SpriteChecksumGroupNames[group];
 }
 
-#endif // DISABLE_NETWORK
+/**
+ * Compares two checksum strings as returned by sprite_checksum.
+ * @returns a mask with a bit set for each group whose digest differs.
+ */
+uint32 sprite_checksum_compare(const char * a, const char * b)
+{
+    if (strlen(a) != sizeof(_spriteChecksum) - 1 || strlen(b) != sizeof(_spriteChecksum) - 1)
+    {
+        return (1 << SPRITE_CHECKSUM_GROUP_COUNT) - 1;
+    }
+
+    uint32 mismatches = 0;
+    for (sint32 group = 0; group < SPRITE_CHECKSUM_GROUP_COUNT; group++)
+    {
+        size_t offset = group * SPRITE_CHECKSUM_GROUP_LENGTH;
+        if (strncmp(a + offset, b + offset, SPRITE_CHECKSUM_GROUP_LENGTH) != 0)
+        {
+            mismatches |= 1 << group;
+        }
+    }
+    return mismatches;
+}
 
 static void sprite_reset(rct_unk_sprite *sprite)
 {
@@ -314,14 +522,18 @@ rct_sprite *create_sprite(uint8 bl)
     if ((bl & 2) != 0) {
         // 69EC96;
         uint16 cx = 0x12C - gSpriteListCount[SPRITE_LIST_MISC];
-        if (cx >= gSpriteListCount[SPRITE_LIST_NULL]) {
+        if (cx >= sprite_get_free_count()) {
             return nullptr;
         }
         linkedListTypeOffset = SPRITE_LIST_MISC * 2;
-    } else if (gSpriteListCount[SPRITE_LIST_NULL] == 0) {
+    } else if (sprite_get_free_count() == 0) {
         return nullptr;
     }
 
+    if (gSpriteListCount[SPRITE_LIST_NULL] == 0) {
+        sprite_grow();
+    }
+
     rct_unk_sprite *sprite = &(get_sprite(gSpriteListHead[SPRITE_LIST_NULL]))->unknown;
 
     move_sprite_to_list((rct_sprite *)sprite, (uint8)linkedListTypeOffset);
@@ -395,6 +607,195 @@ void move_sprite_to_list(rct_sprite *sprite, uint8 newListOffset)
     // Decrement old list counter, increment new list counter.
     gSpriteListCount[oldList]--;
     gSpriteListCount[newList]++;
+
+    _spriteListType[unkSprite->sprite_index] = newList;
+    _spriteListOrder[unkSprite->sprite_index] = _spriteListNextOrder++;
+}
+
+/**
+ * Drops the recorded order and list of each sprite so they are worked out again when next needed. Called whenever a
+ * list is relinked other than by move_sprite_to_list, e.g. when peeps are sorted or a park is loaded.
+ */
+void sprite_list_order_invalidate()
+{
+    _spriteListOrderValid = false;
+}
+
+static void sprite_list_order_validate()
+{
+    if (!_spriteListOrderValid)
+    {
+        uint32 order = 0;
+        for (sint32 list = 0; list < NUM_SPRITE_LISTS; list++)
+        {
+            order += gSpriteListCount[list];
+            uint32 listOrder = order;
+            for (uint16 index = gSpriteListHead[list]; index != SPRITE_INDEX_NULL && listOrder > 0; index = get_sprite(index)->unknown.next)
+            {
+                _spriteListOrder[index] = listOrder--;
+                _spriteListType[index] = list;
+            }
+        }
+        _spriteListNextOrder = order + 1;
+        _spriteListOrderValid = true;
+    }
+}
+
+static uint32 sprite_get_list_order(uint16 spriteIndex)
+{
+    sprite_list_order_validate();
+    return _spriteListOrder[spriteIndex];
+}
+
+static bool sprite_query_matches(const rct_sprite *sprite, sint32 type)
+{
+    switch (type) {
+    case SPRITE_QUERY_TYPE_GUEST:
+        return sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP && sprite->peep.type == PEEP_TYPE_GUEST;
+    case SPRITE_QUERY_TYPE_STAFF:
+        return sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP && sprite->peep.type == PEEP_TYPE_STAFF;
+    case SPRITE_QUERY_TYPE_VEHICLE:
+        return sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE;
+    case SPRITE_QUERY_TYPE_MISC:
+        return sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_MISC;
+    case SPRITE_QUERY_TYPE_LITTER:
+        return sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_LITTER;
+    default:
+        return sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL;
+    }
+}
+
+static void sprite_query_sort_by_list_order(std::vector<uint16> &sprites)
+{
+    std::sort(sprites.begin(), sprites.end(), [](uint16 a, uint16 b) -> bool
+    {
+        return sprite_get_list_order(a) > sprite_get_list_order(b);
+    });
+}
+
+/**
+ * Returns the sprites of the given SPRITE_QUERY_TYPE within range of x, y on both axes, in the order of their sprite
+ * list.
+ */
+std::vector<uint16> sprite_query_in_range(sint32 x, sint32 y, sint32 range, sint32 type)
+{
+    std::vector<uint16> result;
+    sint32 firstTileX = std::max(0, (x - range) >> 5);
+    sint32 firstTileY = std::max(0, (y - range) >> 5);
+    sint32 lastTileX = std::min(MAXIMUM_MAP_SIZE_TECHNICAL - 1, (x + range) >> 5);
+    sint32 lastTileY = std::min(MAXIMUM_MAP_SIZE_TECHNICAL - 1, (y + range) >> 5);
+    for (sint32 tileX = firstTileX; tileX <= lastTileX; tileX++)
+    {
+        for (sint32 tileY = firstTileY; tileY <= lastTileY; tileY++)
+        {
+            uint16 spriteIndex = sprite_get_first_in_quadrant(tileX * 32, tileY * 32);
+            while (spriteIndex != SPRITE_INDEX_NULL)
+            {
+                rct_sprite *sprite = get_sprite(spriteIndex);
+                if (sprite_query_matches(sprite, type) &&
+                    abs(sprite->unknown.x - x) <= range && abs(sprite->unknown.y - y) <= range)
+                {
+                    result.push_back(spriteIndex);
+                }
+                spriteIndex = sprite->unknown.next_in_quadrant;
+            }
+        }
+    }
+
+    sprite_query_sort_by_list_order(result);
+    return result;
+}
+
+/**
+ * Returns up to count sprites of the given SPRITE_QUERY_TYPE that satisfy the predicate, nearest to x, y first by
+ * Manhattan distance. Sprites at the same distance are returned in the order of their sprite list, and sprites not on
+ * the map are never returned.
+ * Nearby tiles are searched first; once the search gets too wide the whole sprite list is scanned instead.
+ */
+std::vector<uint16> sprite_query_nearest(sint32 x, sint32 y, sint32 type, size_t count,
+                                         const std::function<bool(rct_sprite *)> &predicate)
+{
+    struct candidate
+    {
+        uint32 distance;
+        uint32 order;
+        uint16 spriteIndex;
+    };
+    std::vector<candidate> candidates;
+
+    auto consider = [x, y, type, &predicate, &candidates](rct_sprite *sprite) -> void
+    {
+        if (sprite->unknown.x == LOCATION_NULL || !sprite_query_matches(sprite, type) || !predicate(sprite))
+            return;
+
+        uint32 distance = abs(sprite->unknown.x - x) + abs(sprite->unknown.y - y);
+        candidates.push_back({ distance, sprite_get_list_order(sprite->unknown.sprite_index), sprite->unknown.sprite_index });
+    };
+
+    auto isDone = [count, &candidates](sint32 ring) -> bool
+    {
+        if (candidates.size() < count)
+            return false;
+
+        // Sprites on tiles outside the ring are more than ring * 32 away along at least one axis
+        std::nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end(),
+            [](const candidate &a, const candidate &b) { return a.distance < b.distance; });
+        return candidates[count - 1].distance <= (uint32)(ring * 32);
+    };
+
+    bool found = false;
+    if (count > 0)
+    {
+        sint32 centreX = Math::Clamp(0, x >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+        sint32 centreY = Math::Clamp(0, y >> 5, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+        for (sint32 ring = 0; ring <= SPRITE_QUERY_MAX_RING && !found; ring++)
+        {
+            for (sint32 tileX = centreX - ring; tileX <= centreX + ring; tileX++)
+            {
+                // Only the edge of the ring, the inside has been searched already
+                sint32 step = (tileX == centreX - ring || tileX == centreX + ring) ? 1 : std::max(1, ring * 2);
+                for (sint32 tileY = centreY - ring; tileY <= centreY + ring; tileY += step)
+                {
+                    if (tileX < 0 || tileY < 0 || tileX >= MAXIMUM_MAP_SIZE_TECHNICAL || tileY >= MAXIMUM_MAP_SIZE_TECHNICAL)
+                        continue;
+
+                    for (uint16 spriteIndex = sprite_get_first_in_quadrant(tileX * 32, tileY * 32);
+                         spriteIndex != SPRITE_INDEX_NULL;
+                         spriteIndex = get_sprite(spriteIndex)->unknown.next_in_quadrant)
+                    {
+                        consider(get_sprite(spriteIndex));
+                    }
+                }
+            }
+            found = isDone(ring);
+        }
+
+        if (!found)
+        {
+            candidates.clear();
+            for (sint32 list = SPRITE_LIST_NULL + 1; list < NUM_SPRITE_LISTS; list++)
+            {
+                for (uint16 spriteIndex = gSpriteListHead[list]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = get_sprite(spriteIndex)->unknown.next)
+                {
+                    consider(get_sprite(spriteIndex));
+                }
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const candidate &a, const candidate &b) -> bool
+    {
+        if (a.distance != b.distance)
+            return a.distance < b.distance;
+        return a.order > b.order;
+    });
+
+    std::vector<uint16> result;
+    for (size_t i = 0; i < candidates.size() && i < count; i++)
+    {
+        result.push_back(candidates[i].spriteIndex);
+    }
+    return result;
 }
 
 /**
@@ -621,6 +1022,11 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+    if (sprite->unknown.linked_list_type_offset == SPRITE_LIST_LITTER * 2)
+    {
+        litter_index_remove(&sprite->litter);
+    }
+
     move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
     user_string_free(sprite->unknown.name_string_idx);
     sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
@@ -636,6 +1042,91 @@ void sprite_remove(rct_sprite *sprite)
     *spriteIndex = sprite->unknown.next_in_quadrant;
 }
 
+static size_t litter_index_get_block(sint32 x, sint32 y)
+{
+    x = Math::Clamp(0, x, (MAXIMUM_MAP_SIZE_TECHNICAL * 32) - 1);
+    y = Math::Clamp(0, y, (MAXIMUM_MAP_SIZE_TECHNICAL * 32) - 1);
+    return (x >> LITTER_INDEX_BLOCK_SHIFT) * LITTER_INDEX_SIZE + (y >> LITTER_INDEX_BLOCK_SHIFT);
+}
+
+/**
+ * Drops the litter index so it gets rebuilt from the litter sprite list when next used. Called whenever the sprites are
+ * replaced, e.g. when a park is loaded.
+ */
+void litter_index_invalidate()
+{
+    _litterIndexValid = false;
+}
+
+static void litter_index_rebuild()
+{
+    for (auto &block : _litterIndex)
+    {
+        block.clear();
+    }
+
+    for (uint16 spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = get_sprite(spriteIndex)->unknown.next)
+    {
+        rct_litter *litter = &get_sprite(spriteIndex)->litter;
+        _litterIndex[litter_index_get_block(litter->x, litter->y)].push_back(spriteIndex);
+    }
+    _litterIndexValid = true;
+}
+
+static void litter_index_add(rct_litter *litter)
+{
+    if (_litterIndexValid)
+    {
+        _litterIndex[litter_index_get_block(litter->x, litter->y)].push_back(litter->sprite_index);
+    }
+}
+
+static void litter_index_remove(rct_litter *litter)
+{
+    if (_litterIndexValid)
+    {
+        auto &block = _litterIndex[litter_index_get_block(litter->x, litter->y)];
+        auto it = std::find(block.begin(), block.end(), litter->sprite_index);
+        if (it != block.end())
+        {
+            *it = block.back();
+            block.pop_back();
+        }
+    }
+}
+
+/**
+ * Returns the litter within range of x, y on both axes, in the order of the litter sprite list.
+ */
+std::vector<uint16> litter_get_nearby(sint32 x, sint32 y, sint32 range)
+{
+    if (!_litterIndexValid)
+    {
+        litter_index_rebuild();
+    }
+
+    std::vector<uint16> result;
+    size_t firstBlock = litter_index_get_block(x - range, y - range);
+    size_t lastBlock = litter_index_get_block(x + range, y + range);
+    for (size_t blockX = firstBlock / LITTER_INDEX_SIZE; blockX <= lastBlock / LITTER_INDEX_SIZE; blockX++)
+    {
+        for (size_t blockY = firstBlock % LITTER_INDEX_SIZE; blockY <= lastBlock % LITTER_INDEX_SIZE; blockY++)
+        {
+            for (uint16 spriteIndex : _litterIndex[blockX * LITTER_INDEX_SIZE + blockY])
+            {
+                rct_litter *litter = &get_sprite(spriteIndex)->litter;
+                if (abs(litter->x - x) <= range && abs(litter->y - y) <= range)
+                {
+                    result.push_back(spriteIndex);
+                }
+            }
+        }
+    }
+
+    sprite_query_sort_by_list_order(result);
+    return result;
+}
+
 static bool litter_can_be_at(sint32 x, sint32 y, sint32 z)
 {
     rct_tile_element *tileElement;
@@ -647,6 +1138,8 @@ static bool litter_can_be_at(sint32 x, sint32 y, sint32 z)
     do {
         if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH)
             continue;
+        if (tile_element_is_ghost(tileElement))
+            continue;
 
         sint32 pathZ = tileElement->base_height * 8;
         if (pathZ < z || pathZ >= z + 32)
@@ -707,6 +1200,7 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
     sprite_move(x, y, z, (rct_sprite*)litter);
     invalidate_sprite_0((rct_sprite*)litter);
     litter->creationTick = gScenarioTicks;
+    litter_index_add(litter);
 }
 
 /**
@@ -715,6 +1209,10 @@ void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type)
  */
 void litter_remove_at(sint32 x, sint32 y, sint32 z)
 {
+    // Most tiles have no litter, which saves walking the sprites on them
+    if (litter_get_nearby(x, y, 8).empty())
+        return;
+
     uint16 spriteIndex = sprite_get_first_in_quadrant(x, y);
     while (spriteIndex != SPRITE_INDEX_NULL) {
         rct_sprite *sprite = get_sprite(spriteIndex);
@@ -736,9 +1234,9 @@ void litter_remove_at(sint32 x, sint32 y, sint32 z)
 /**
  * Determines whether it's worth tweening a sprite or not when frame smoothing is on.
  */
-static bool sprite_should_tween(rct_sprite *sprite)
+static bool sprite_should_tween(size_t spriteIndex)
 {
-    switch (sprite->unknown.linked_list_type_offset >> 1) {
+    switch (_spriteListType[spriteIndex]) {
     case SPRITE_LIST_TRAIN:
     case SPRITE_LIST_PEEP:
     case SPRITE_LIST_UNKNOWN:
@@ -747,15 +1245,17 @@ static bool sprite_should_tween(rct_sprite *sprite)
     return false;
 }
 
-static void store_sprite_locations(LocationXYZ16 * sprite_locations)
+static void store_sprite_locations(std::vector<LocationXYZ16> &sprite_locations)
 {
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        // skip going through `get_sprite` to not get stalled on assert,
-        // this can get very expensive for busy parks with uncap FPS option on
-        const rct_sprite *sprite = &_spriteList[i];
-        sprite_locations[i].x = sprite->unknown.x;
-        sprite_locations[i].y = sprite->unknown.y;
-        sprite_locations[i].z = sprite->unknown.z;
+    sprite_list_order_validate();
+    for (size_t i = 0; i < _spriteCapacity; i++) {
+        // Only sprites that are tweened are read, the positions of the others are never used
+        if (sprite_should_tween(i)) {
+            const rct_sprite *sprite = get_sprite_slot(i);
+            sprite_locations[i].x = sprite->unknown.x;
+            sprite_locations[i].y = sprite->unknown.y;
+            sprite_locations[i].z = sprite->unknown.z;
+        }
     }
 }
 
@@ -773,14 +1273,15 @@ void sprite_position_tween_all(float alpha)
 {
     const float inv = (1.0f - alpha);
 
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        rct_sprite * sprite = get_sprite(i);
-        if (sprite_should_tween(sprite)) {
+    sprite_list_order_validate();
+    for (size_t i = 0; i < _spriteCapacity; i++) {
+        if (sprite_should_tween(i)) {
             LocationXYZ16 posA = _spritelocations1[i];
             LocationXYZ16 posB = _spritelocations2[i];
             if (posA.x == posB.x && posA.y == posB.y && posA.z == posB.z) {
                 continue;
             }
+            rct_sprite * sprite = get_sprite_slot(i);
             sprite_set_coordinates(
                 posB.x * alpha + posA.x * inv,
                 posB.y * alpha + posA.y * inv,
@@ -797,9 +1298,10 @@ void sprite_position_tween_all(float alpha)
  */
 void sprite_position_tween_restore()
 {
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        rct_sprite * sprite = get_sprite(i);
-        if (sprite_should_tween(sprite)) {
+    sprite_list_order_validate();
+    for (size_t i = 0; i < _spriteCapacity; i++) {
+        if (sprite_should_tween(i)) {
+            rct_sprite * sprite = get_sprite_slot(i);
             invalidate_sprite_2(sprite);
 
             LocationXYZ16 pos = _spritelocations2[i];
@@ -810,8 +1312,8 @@ void sprite_position_tween_restore()
 
 void sprite_position_tween_reset()
 {
-    for (uint16 i = 0; i < MAX_SPRITES; i++) {
-        rct_sprite * sprite = get_sprite(i);
+    for (size_t i = 0; i < _spriteCapacity; i++) {
+        rct_sprite * sprite = get_sprite_slot(i);
         _spritelocations1[i].x =
         _spritelocations2[i].x = sprite->unknown.x;
         _spritelocations1[i].y =
@@ -823,13 +1325,13 @@ void sprite_position_tween_reset()
 
 void sprite_set_flashing(rct_sprite *sprite, bool flashing)
 {
-    assert(sprite->unknown.sprite_index < MAX_SPRITES);
+    assert(sprite->unknown.sprite_index < _spriteCapacity);
     _spriteFlashingList[sprite->unknown.sprite_index] = flashing;
 }
 
 bool sprite_get_flashing(rct_sprite *sprite)
 {
-    assert(sprite->unknown.sprite_index < MAX_SPRITES);
+    assert(sprite->unknown.sprite_index < _spriteCapacity);
     return _spriteFlashingList[sprite->unknown.sprite_index];
 }
 
@@ -963,7 +1465,7 @@ sint32 check_for_sprite_list_cycles(bool fix)
 sint32 fix_disjoint_sprites()
 {
     // Find reachable sprites
-    bool reachable[MAX_SPRITES] = { false };
+    std::vector<bool> reachable(_spriteCapacity, false);
     uint16 sprite_idx = gSpriteListHead[SPRITE_LIST_NULL];
     rct_sprite * null_list_tail = nullptr;
     while (sprite_idx != SPRITE_INDEX_NULL)
@@ -977,7 +1479,7 @@ sint32 fix_disjoint_sprites()
     sint32 count = 0;
 
     // Find all null sprites
-    for (sprite_idx = 0; sprite_idx < MAX_SPRITES; sprite_idx++)
+    for (sprite_idx = 0; sprite_idx < _spriteCapacity; sprite_idx++)
     {
         rct_sprite * spr = get_sprite(sprite_idx);
         if (spr->unknown.sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -17,12 +17,17 @@
 #ifndef _SPRITE_H_
 #define _SPRITE_H_
 
+#include <functional>
+#include <vector>
 #include "../common.h"
 #include "../peep/Peep.h"
 #include "../ride/Vehicle.h"
 
 #define SPRITE_INDEX_NULL       0xFFFF
-#define MAX_SPRITES             10000
+// Sprite slots in a new park, the same number as RCT2 saves hold
+#define MAX_SPRITES_INITIAL     10000
+// Sprites link to each other by 16-bit index, the highest of which is SPRITE_INDEX_NULL
+#define MAX_SPRITES_LIMIT       0xFFFF
 #define NUM_SPRITE_LISTS        6
 
 enum SPRITE_IDENTIFIER {
@@ -363,6 +368,15 @@ enum {
     SPRITE_FLAGS_PEEP_FLASHING = 1 << 9, // Deprecated: Use sprite_set_flashing/sprite_get_flashing instead.
 };
 
+enum SPRITE_QUERY_TYPE {
+    SPRITE_QUERY_TYPE_ANY,
+    SPRITE_QUERY_TYPE_GUEST,
+    SPRITE_QUERY_TYPE_STAFF,
+    SPRITE_QUERY_TYPE_VEHICLE,
+    SPRITE_QUERY_TYPE_MISC,
+    SPRITE_QUERY_TYPE_LITTER,
+};
+
 enum {
     LITTER_TYPE_SICK,
     LITTER_TYPE_SICK_ALT,
@@ -380,6 +394,9 @@ enum {
 
 rct_sprite *try_get_sprite(size_t spriteIndex);
 rct_sprite *get_sprite(size_t sprite_idx);
+size_t sprite_get_capacity();
+void sprite_set_capacity(size_t capacity);
+uint32 sprite_get_free_count();
 
 extern uint16 gSpriteListHead[6];
 extern uint16 gSpriteListCount[6];
@@ -402,6 +419,12 @@ void invalidate_sprite_2(rct_sprite *sprite);
 void sprite_remove(rct_sprite *sprite);
 void litter_create(sint32 x, sint32 y, sint32 z, sint32 direction, sint32 type);
 void litter_remove_at(sint32 x, sint32 y, sint32 z);
+void litter_index_invalidate();
+std::vector<uint16> litter_get_nearby(sint32 x, sint32 y, sint32 range);
+void sprite_list_order_invalidate();
+std::vector<uint16> sprite_query_in_range(sint32 x, sint32 y, sint32 range, sint32 type);
+std::vector<uint16> sprite_query_nearest(sint32 x, sint32 y, sint32 type, size_t count,
+                                         const std::function<bool(rct_sprite *)> &predicate);
 void sprite_misc_explosion_cloud_create(sint32 x, sint32 y, sint32 z);
 void sprite_misc_explosion_flare_create(sint32 x, sint32 y, sint32 z);
 uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y);
@@ -443,7 +466,23 @@ void crashed_vehicle_particle_update(rct_crashed_vehicle_particle *particle);
 void crash_splash_create(sint32 x, sint32 y, sint32 z);
 void crash_splash_update(rct_crash_splash *splash);
 
+enum
+{
+    SPRITE_CHECKSUM_GROUP_VEHICLES,
+    SPRITE_CHECKSUM_GROUP_PEEPS,
+    SPRITE_CHECKSUM_GROUP_LITTER,
+    SPRITE_CHECKSUM_GROUP_COUNT
+};
+
+struct rct_sprite_checksum
+{
+    uint64 groups[SPRITE_CHECKSUM_GROUP_COUNT];
+};
+
+rct_sprite_checksum sprite_checksum_compute();
 const char *sprite_checksum();
+const char *sprite_checksum_get_group_name(sint32 group);
+uint32 sprite_checksum_compare(const char *a, const char *b);
 
 void sprite_set_flashing(rct_sprite *sprite, bool flashing);
 bool sprite_get_flashing(rct_sprite *sprite);
@@ -169,6 +169,7 @@ sint32 tile_inspector_remove_element_at(sint32 x, sint32 y, sint16 elementIndex,
         }
         tile_element_remove(tileElement);
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         // Update the window
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -203,6 +204,7 @@ sint32 tile_inspector_swap_elements_at(sint32 x, sint32 y, sint16 first, sint16
             return MONEY32_UNDEFINED;
         }
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         // Update the window
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -296,6 +298,7 @@ sint32 tile_inspector_paste_element_at(sint32 x, sint32 y, rct_tile_element elem
         }
 
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && (uint32)x == windowTileInspectorTileX && (uint32)y == windowTileInspectorTileY)
@@ -359,6 +362,7 @@ sint32 tile_inspector_sort_elements_at(sint32 x, sint32 y, sint32 flags)
         }
 
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         // Deselect tile for clients who had it selected
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -393,6 +397,7 @@ sint32 tile_inspector_any_base_height_offset(sint32 x, sint32 y, sint16 elementI
         tileElement->clearance_height += heightOffset;
 
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && (uint32)x == windowTileInspectorTileX && (uint32)y == windowTileInspectorTileY)
@@ -484,6 +489,7 @@ sint32 tile_inspector_surface_toggle_corner(sint32 x, sint32 y, sint32 cornerInd
         }
 
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && (uint32)x == windowTileInspectorTileX && (uint32)y == windowTileInspectorTileY)
@@ -520,6 +526,7 @@ sint32 tile_inspector_surface_toggle_diagonal(sint32 x, sint32 y, sint32 flags)
         }
 
         map_invalidate_tile_full(x << 5, y << 5);
+        map_invalidate_surface_height(x, y);
 
         rct_window * const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && (uint32)x == windowTileInspectorTileX && (uint32)y == windowTileInspectorTileY)
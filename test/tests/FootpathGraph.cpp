@@ -0,0 +1,385 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/util/Util.h>
+#include <openrct2/world/Entrance.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/FootpathGraph.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+static bool IsOnMap(sint32 x, sint32 y)
+{
+    return x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+/**
+ * Returns the path that the given edge of the path leads onto, or nullptr if there is none. Takes tile coordinates.
+ */
+static rct_tile_element * GetNextPath(sint32 x, sint32 y, const rct_tile_element * pathElement, sint32 direction,
+                                      sint32 * outX, sint32 * outY)
+{
+    sint32 z = pathElement->base_height;
+    if (footpath_element_is_sloped(pathElement) && footpath_element_get_slope_direction(pathElement) == direction)
+        z += 2;
+
+    *outX = x + TileDirectionDelta[direction].x / 32;
+    *outY = y + TileDirectionDelta[direction].y / 32;
+    if (!IsOnMap(*outX, *outY))
+        return nullptr;
+
+    rct_tile_element * tileElement = map_get_first_element_at(*outX, *outY);
+    do
+    {
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tileElement) &&
+            is_valid_path_z_and_direction(tileElement, z, direction))
+        {
+            return tileElement;
+        }
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+    return nullptr;
+}
+
+static uint8 GetConnectedEdges(sint32 x, sint32 y, const rct_tile_element * pathElement)
+{
+    uint8 connected = 0;
+    for (sint32 direction = 0; direction < 4; direction++)
+    {
+        sint32 nextX, nextY;
+        if ((pathElement->properties.path.edges & (1 << direction)) &&
+            GetNextPath(x, y, pathElement, direction, &nextX, &nextY) != nullptr)
+        {
+            connected |= 1 << direction;
+        }
+    }
+    return connected;
+}
+
+static bool HasEntrance(sint32 x, sint32 y, sint32 z)
+{
+    if (!IsOnMap(x, y))
+        return false;
+
+    const rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    do
+    {
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_ENTRANCE && !tile_element_is_ghost(tileElement) &&
+            tileElement->base_height == z)
+        {
+            return true;
+        }
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+    return false;
+}
+
+/**
+ * Walks along the path from a node the way a guest would until it reaches the next node, then checks that the edge
+ * of the graph ends there and has the length of the walk.
+ */
+static void CheckPathEdge(sint32 x, sint32 y, const rct_tile_element * pathElement, sint32 direction,
+                          const footpath_graph_edge &edge)
+{
+    sint32 startX = x;
+    sint32 startY = y;
+    for (uint32 length = 1; length <= MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL; length++)
+    {
+        sint32 nextX, nextY;
+        const rct_tile_element * nextElement = GetNextPath(x, y, pathElement, direction, &nextX, &nextY);
+        ASSERT_NE(nextElement, nullptr) << "edge " << direction << " of " << startX << ", " << startY;
+
+        uint8 connected = GetConnectedEdges(nextX, nextY, nextElement);
+        footpath_graph_node_info info;
+        bool isNode = footpath_graph_get_node_info(nextX, nextY, nextElement->base_height, false, &info);
+        if (isNode || !(connected & (1 << (direction ^ 2))))
+        {
+            EXPECT_EQ(edge.target.x, nextX) << "edge " << direction << " of " << startX << ", " << startY;
+            EXPECT_EQ(edge.target.y, nextY) << "edge " << direction << " of " << startX << ", " << startY;
+            EXPECT_EQ(edge.target.z, nextElement->base_height) << "edge " << direction << " of " << startX << ", " << startY;
+            EXPECT_EQ(edge.length, length) << "edge " << direction << " of " << startX << ", " << startY;
+            EXPECT_FALSE(edge.targetIsEntrance);
+            return;
+        }
+
+        // Not a node, so the path simply carries on
+        uint8 onwards = connected & ~(1 << (direction ^ 2));
+        ASSERT_EQ(bitcount(onwards), 1) << nextX << ", " << nextY << " is not a node";
+        direction = bitscanforward(onwards);
+        x = nextX;
+        y = nextY;
+        pathElement = nextElement;
+    }
+    FAIL() << "edge " << direction << " of " << startX << ", " << startY << " never ends";
+}
+
+/**
+ * Checks every node of the graph against the paths and entrances on the map. Returns how many ride and park entrance
+ * nodes have a path leading onto them.
+ */
+static void CheckGraph(sint32 * outConnectedRideEntrances, sint32 * outConnectedParkEntrances)
+{
+    *outConnectedRideEntrances = 0;
+    *outConnectedParkEntrances = 0;
+
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        const rct_tile_element * tileElement = it.element;
+        if (tile_element_is_ghost(tileElement))
+            continue;
+
+        footpath_graph_node_info info;
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH)
+        {
+            uint8 connected = GetConnectedEdges(it.x, it.y, tileElement);
+            bool isNode = footpath_graph_get_node_info(it.x, it.y, tileElement->base_height, false, &info);
+            if (bitcount(connected) != 2)
+            {
+                EXPECT_TRUE(isNode) << it.x << ", " << it.y << " has " << bitcount(connected) << " connections";
+            }
+            if (!isNode)
+                continue;
+
+            for (sint32 direction = 0; direction < 4; direction++)
+            {
+                if (!(info.edges & (1 << direction)))
+                    continue;
+
+                const footpath_graph_edge &edge = info.edgesTo[direction];
+                if (edge.targetIsEntrance)
+                {
+                    EXPECT_EQ(edge.length, 1u);
+                    EXPECT_EQ(edge.target.x, it.x + TileDirectionDelta[direction].x / 32);
+                    EXPECT_EQ(edge.target.y, it.y + TileDirectionDelta[direction].y / 32);
+                    EXPECT_TRUE(HasEntrance(edge.target.x, edge.target.y, edge.target.z));
+                }
+                else
+                {
+                    CheckPathEdge(it.x, it.y, tileElement, direction, edge);
+                }
+            }
+        }
+        else if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_ENTRANCE)
+        {
+            ASSERT_TRUE(footpath_graph_get_node_info(it.x, it.y, tileElement->base_height, true, &info))
+                << "entrance at " << it.x << ", " << it.y;
+
+            for (sint32 direction = 0; direction < 4; direction++)
+            {
+                if (!(info.edges & (1 << direction)))
+                    continue;
+
+                // The path has an edge back onto the entrance
+                const footpath_graph_edge &edge = info.edgesTo[direction];
+                EXPECT_EQ(edge.length, 1u);
+                EXPECT_EQ(edge.target.x, it.x + TileDirectionDelta[direction].x / 32);
+                EXPECT_EQ(edge.target.y, it.y + TileDirectionDelta[direction].y / 32);
+                EXPECT_FALSE(edge.targetIsEntrance);
+
+                footpath_graph_node_info pathInfo;
+                ASSERT_TRUE(footpath_graph_get_node_info(edge.target.x, edge.target.y, edge.target.z, false, &pathInfo))
+                    << "path leading onto the entrance at " << it.x << ", " << it.y;
+                ASSERT_TRUE(pathInfo.edges & (1 << (direction ^ 2)));
+                const footpath_graph_edge &backEdge = pathInfo.edgesTo[direction ^ 2];
+                EXPECT_TRUE(backEdge.targetIsEntrance);
+                EXPECT_EQ(backEdge.target.x, it.x);
+                EXPECT_EQ(backEdge.target.y, it.y);
+                EXPECT_EQ(backEdge.target.z, tileElement->base_height);
+            }
+
+            if (info.edges != 0)
+            {
+                if (tileElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE)
+                    (*outConnectedParkEntrances)++;
+                else
+                    (*outConnectedRideEntrances)++;
+            }
+        }
+    }
+    while (tile_element_iterator_next(&it));
+}
+
+/**
+ * Whether a no entry banner on the path stops guests leaving it along the given edge.
+ */
+static bool IsBlockedByBanner(const rct_tile_element * pathElement, sint32 direction)
+{
+    const rct_tile_element * tileElement = pathElement;
+    while (!tile_element_is_last_for_tile(tileElement++))
+    {
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_PATH && !tile_element_is_ghost(tileElement))
+            break;
+        if (tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_BANNER &&
+            !(tileElement->properties.banner.flags & (1 << direction)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Checks that a junction next to an entrance chooses the edge onto it when the entrance is the goal, both for staff and
+ * for guests where no banner is in the way. Returns how many junctions were checked.
+ */
+static sint32 CheckRoutingOntoEntrances()
+{
+    sint32 junctions = 0;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        const rct_tile_element * tileElement = it.element;
+        if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_PATH || tile_element_is_ghost(tileElement))
+            continue;
+
+        footpath_graph_node_info info;
+        if (!footpath_graph_get_node_info(it.x, it.y, tileElement->base_height, false, &info) || bitcount(info.edges) < 2)
+            continue;
+
+        for (sint32 direction = 0; direction < 4; direction++)
+        {
+            const footpath_graph_edge &edge = info.edgesTo[direction];
+            if (!(info.edges & (1 << direction)) || !edge.targetIsEntrance)
+                continue;
+
+            footpath_graph_query query;
+            query.goal                = { (sint16)(edge.target.x * 32), (sint16)(edge.target.y * 32), (sint16)edge.target.z };
+            query.queueRideIndex      = 255;
+            query.ignoreForeignQueues = false;
+            query.ignoreBanners       = true;
+            EXPECT_EQ(footpath_graph_choose_direction(it.x * 32, it.y * 32, tileElement->base_height, info.edges, &query),
+                      direction)
+                << "staff at " << it.x << ", " << it.y;
+
+            if (!IsBlockedByBanner(tileElement, direction))
+            {
+                query.ignoreBanners = false;
+                EXPECT_EQ(footpath_graph_choose_direction(it.x * 32, it.y * 32, tileElement->base_height, info.edges, &query),
+                          direction)
+                    << "guest at " << it.x << ", " << it.y;
+            }
+            junctions++;
+        }
+    }
+    while (tile_element_iterator_next(&it));
+    return junctions;
+}
+
+/**
+ * Lists every node of the graph with its edges, so that the graph can be compared with another one.
+ */
+static std::vector<sint32> GetGraph()
+{
+    std::vector<sint32> graph;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        sint32 type = tile_element_get_type(it.element);
+        if (tile_element_is_ghost(it.element) || (type != TILE_ELEMENT_TYPE_PATH && type != TILE_ELEMENT_TYPE_ENTRANCE))
+            continue;
+
+        footpath_graph_node_info info;
+        bool entrance = type == TILE_ELEMENT_TYPE_ENTRANCE;
+        if (!footpath_graph_get_node_info(it.x, it.y, it.element->base_height, entrance, &info))
+            continue;
+
+        graph.insert(graph.end(), { it.x, it.y, it.element->base_height, entrance, info.edges });
+        for (const footpath_graph_edge &edge : info.edgesTo)
+        {
+            graph.insert(graph.end(), { edge.target.x, edge.target.y, edge.target.z, (sint32)edge.length, edge.targetIsEntrance });
+        }
+    }
+    while (tile_element_iterator_next(&it));
+    return graph;
+}
+
+/**
+ * Checks the graph as it has been kept up to date, then against one built again from scratch.
+ */
+static void CheckGraphUpToDate()
+{
+    sint32 connectedRideEntrances, connectedParkEntrances;
+    CheckGraph(&connectedRideEntrances, &connectedParkEntrances);
+
+    std::vector<sint32> graph = GetGraph();
+    footpath_graph_reset();
+    EXPECT_EQ(GetGraph(), graph);
+}
+
+TEST(FootpathGraphTest, matches_map)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    ParkLoadResult * plr = load_from_sv6(path.c_str());
+    ASSERT_EQ(ParkLoadResult_GetError(plr), PARK_LOAD_ERROR_OK);
+    ParkLoadResult_Delete(plr);
+
+    game_load_init();
+    game_logic_update();
+
+    sint32 connectedRideEntrances, connectedParkEntrances;
+    CheckGraph(&connectedRideEntrances, &connectedParkEntrances);
+    EXPECT_GT(connectedRideEntrances, 0);
+    EXPECT_GT(connectedParkEntrances, 0);
+    EXPECT_GT(CheckRoutingOntoEntrances(), 0);
+    CheckGraphUpToDate();
+
+    // Remove every seventh path and put every other one of those back, with the graph built before each change
+    struct PathLocation
+    {
+        sint32 x, y, z, type, slope;
+    };
+    std::vector<PathLocation> paths;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (tile_element_get_type(it.element) == TILE_ELEMENT_TYPE_PATH && !footpath_element_is_queue(it.element))
+        {
+            sint32 slope = footpath_element_is_sloped(it.element) ?
+                (footpath_element_get_slope_direction(it.element) | TILE_ELEMENT_SLOPE_S_CORNER_UP) : 0;
+            paths.push_back({ it.x * 32, it.y * 32, it.element->base_height, footpath_element_get_type(it.element), slope });
+        }
+    }
+    while (tile_element_iterator_next(&it));
+    ASSERT_FALSE(paths.empty());
+
+    gCheatsSandboxMode = true;
+    gCheatsBuildInPauseMode = true;
+    for (size_t i = 0; i < paths.size(); i += 7)
+    {
+        const PathLocation &location = paths[i];
+        footpath_remove(location.x, location.y, location.z, GAME_COMMAND_FLAG_APPLY);
+    }
+    CheckGraphUpToDate();
+
+    for (size_t i = 0; i < paths.size(); i += 14)
+    {
+        const PathLocation &location = paths[i];
+        footpath_place(location.type, location.x, location.y, location.z, location.slope, GAME_COMMAND_FLAG_APPLY);
+    }
+    CheckGraphUpToDate();
+
+    delete context;
+    SUCCEED();
+}
@@ -0,0 +1,98 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+/**
+ * Compares the cached height of every tile against the surface element, at each corner and at the centre of the tile.
+ * Returns the number of mismatching positions.
+ */
+static sint32 CountHeightMismatches()
+{
+    static constexpr const sint32 SubPositions[] = { 0, 8, 16, 24, 31 };
+
+    sint32 mismatches = 0;
+    for (sint32 y = 0; y < gMapSize; y++)
+    {
+        for (sint32 x = 0; x < gMapSize; x++)
+        {
+            for (sint32 subY : SubPositions)
+            {
+                for (sint32 subX : SubPositions)
+                {
+                    sint32 worldX = (x << 5) + subX;
+                    sint32 worldY = (y << 5) + subY;
+                    if (tile_element_height(worldX, worldY) != tile_element_height_uncached(worldX, worldY))
+                    {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+TEST(MapHeightCacheTest, matches_surface)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    ParkLoadResult * plr = load_from_sv6(path.c_str());
+    ASSERT_EQ(ParkLoadResult_GetError(plr), PARK_LOAD_ERROR_OK);
+    ParkLoadResult_Delete(plr);
+
+    game_load_init();
+    ASSERT_EQ(CountHeightMismatches(), 0);
+
+    for (sint32 i = 0; i < 10; i++)
+    {
+        game_logic_update();
+    }
+    ASSERT_EQ(CountHeightMismatches(), 0);
+
+    // Landscape a few areas, whether the commands succeed or not the cache must follow the surface
+    gCheatsSandboxMode = true;
+    gCheatsBuildInPauseMode = true;
+    for (sint32 i = 0; i < 16; i++)
+    {
+        sint32 x = 16 + i * 12;
+        sint32 y = 16 + i * 9;
+        sint32 left = x << 5;
+        sint32 top = y << 5;
+        sint32 right = (x + 2) << 5;
+        sint32 bottom = (y + 2) << 5;
+        sint32 command = (i % 2 == 0) ? GAME_COMMAND_RAISE_LAND : GAME_COMMAND_LOWER_LAND;
+
+        // Query the heights first so that stale entries would be noticed
+        tile_element_height(left, top);
+        tile_element_height(right, bottom);
+        game_do_command(left + 32, GAME_COMMAND_FLAG_APPLY, top + 32, left | (right << 16), command, MAP_SELECT_TYPE_FULL,
+            top | (bottom << 16));
+        game_do_command(left, GAME_COMMAND_FLAG_APPLY, top, 20, GAME_COMMAND_SET_WATER_HEIGHT, 0, 0);
+    }
+    ASSERT_EQ(CountHeightMismatches(), 0);
+
+    for (sint32 i = 0; i < 10; i++)
+    {
+        game_logic_update();
+    }
+    ASSERT_EQ(CountHeightMismatches(), 0);
+
+    delete context;
+    SUCCEED();
+}
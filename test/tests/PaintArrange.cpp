@@ -0,0 +1,68 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/platform/platform.h>
+#include "PaintHelpers.h"
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+static constexpr const char * ParkFiles[] =
+{
+    "bpb.sv6",
+};
+
+/**
+ * Compares both arranges on every column of a view of the whole map. Returns the number of columns drawn differently.
+ */
+static sint32 CountMismatchingColumns(uint8 rotation, uint8 zoom)
+{
+    sint32 mismatches = 0;
+    for (rct_drawpixelinfo &dpi : PaintHelpers::GetMapColumns(rotation, zoom))
+    {
+        if (PaintHelpers::GetDrawOrder(&dpi) != PaintHelpers::GetDrawOrder(&dpi, true))
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+TEST(PaintArrangeTest, matches_reference)
+{
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    for (const char * parkFile : ParkFiles)
+    {
+        std::string path = TestData::GetParkPath(parkFile);
+        ParkLoadResult * plr = load_from_sv6(path.c_str());
+        ASSERT_EQ(ParkLoadResult_GetError(plr), PARK_LOAD_ERROR_OK);
+        ParkLoadResult_Delete(plr);
+
+        game_load_init();
+        for (sint32 i = 0; i < 10; i++)
+        {
+            game_logic_update();
+        }
+
+        for (uint8 rotation = 0; rotation < 4; rotation++)
+        {
+            for (uint8 zoom = 0; zoom < 4; zoom++)
+            {
+                EXPECT_EQ(CountMismatchingColumns(rotation, zoom), 0)
+                    << parkFile << ", rotation " << (sint32)rotation << ", zoom " << (sint32)zoom;
+            }
+        }
+    }
+
+    delete context;
+    SUCCEED();
+}
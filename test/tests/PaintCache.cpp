@@ -0,0 +1,268 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/object/ObjectLimits.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Park.h>
+#include <openrct2/world/Scenery.h>
+#include <openrct2/world/SmallScenery.h>
+#include "PaintHelpers.h"
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+static constexpr const char * ParkFiles[] =
+{
+    "bpb.sv6",
+};
+
+static std::vector<uint32> GetDrawOrder(rct_drawpixelinfo * dpi, bool useCache)
+{
+    gConfigGeneral.paint_cache = useCache;
+    return PaintHelpers::GetDrawOrder(dpi);
+}
+
+/**
+ * Paints every column of a view of the whole map without the cache, then twice with it so that the tiles are first
+ * recorded, or replayed if they already were, and then replayed. Returns the number of columns drawn differently.
+ */
+static sint32 CountMismatchingColumns(uint8 rotation, uint8 zoom)
+{
+    sint32 mismatches = 0;
+    for (rct_drawpixelinfo &dpi : PaintHelpers::GetMapColumns(rotation, zoom))
+    {
+        std::vector<uint32> expected = GetDrawOrder(&dpi, false);
+        if (GetDrawOrder(&dpi, true) != expected || GetDrawOrder(&dpi, true) != expected)
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static void LoadPark(const char * parkFile)
+{
+    std::string path = TestData::GetParkPath(parkFile);
+    ParkLoadResult * plr = load_from_sv6(path.c_str());
+    ASSERT_EQ(ParkLoadResult_GetError(plr), PARK_LOAD_ERROR_OK);
+    ParkLoadResult_Delete(plr);
+
+    game_load_init();
+    for (sint32 i = 0; i < 10; i++)
+    {
+        game_logic_update();
+    }
+}
+
+static rct_tile_element * GetElementOfType(sint32 x, sint32 y, sint32 type)
+{
+    rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    do
+    {
+        if (tile_element_get_type(tileElement) == type)
+        {
+            return tileElement;
+        }
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+    return nullptr;
+}
+
+static bool IsFlatLand(sint32 x, sint32 y)
+{
+    const rct_tile_element * tileElement = map_get_first_element_at(x, y);
+    return tile_element_get_type(tileElement) == TILE_ELEMENT_TYPE_SURFACE && tile_element_is_last_for_tile(tileElement) &&
+        (tileElement->properties.surface.slope & TILE_ELEMENT_SURFACE_SLOPE_MASK) == 0 &&
+        map_get_water_height(tileElement) == 0;
+}
+
+/**
+ * Finds a tile holding only land and a piece of small scenery that is not animated, preferably one that can be
+ * recoloured, next to a tile holding only flat land. Takes and returns tile coordinates.
+ */
+static bool FindSceneryNextToFlatLand(sint32 * sceneryX, sint32 * sceneryY, sint32 * direction)
+{
+    for (bool needsColour : { true, false })
+    {
+        for (sint32 y = 2; y < gMapSize - 2; y++)
+        {
+            for (sint32 x = 2; x < gMapSize - 2; x++)
+            {
+                rct_tile_element * tileElement = map_get_first_element_at(x, y);
+                if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_SURFACE ||
+                    tile_element_is_last_for_tile(tileElement))
+                {
+                    continue;
+                }
+                tileElement++;
+                if (tile_element_get_type(tileElement) != TILE_ELEMENT_TYPE_SMALL_SCENERY ||
+                    !tile_element_is_last_for_tile(tileElement))
+                {
+                    continue;
+                }
+
+                rct_scenery_entry * entry = get_small_scenery_entry(tileElement->properties.scenery.type);
+                if (entry == nullptr || scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED))
+                    continue;
+                if (needsColour && !scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_HAS_PRIMARY_COLOUR))
+                    continue;
+
+                for (sint32 i = 0; i < 4; i++)
+                {
+                    if (IsFlatLand(x + TileDirectionDelta[i].x / 32, y + TileDirectionDelta[i].y / 32))
+                    {
+                        *sceneryX = x;
+                        *sceneryY = y;
+                        *direction = i;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+static sint32 FindStaticWallType()
+{
+    for (sint32 i = 0; i < MAX_WALL_SCENERY_OBJECTS; i++)
+    {
+        rct_scenery_entry * entry = get_wall_entry(i);
+        if (entry != nullptr && !(entry->wall.flags2 & WALL_SCENERY_2_ANIMATED) && entry->wall.scrolling_mode == 0xFF)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+TEST(PaintCacheTest, matches_uncached)
+{
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    bool paintCache = gConfigGeneral.paint_cache;
+    for (const char * parkFile : ParkFiles)
+    {
+        LoadPark(parkFile);
+
+        for (uint8 rotation = 0; rotation < 4; rotation++)
+        {
+            for (uint8 zoom = 0; zoom < 4; zoom++)
+            {
+                EXPECT_EQ(CountMismatchingColumns(rotation, zoom), 0)
+                    << parkFile << ", rotation " << (sint32)rotation << ", zoom " << (sint32)zoom;
+            }
+        }
+
+        // The tiles keep the recordings of the last few views, which are replayed when one of these is painted again
+        EXPECT_EQ(CountMismatchingColumns(3, 1), 0) << parkFile << " painting an earlier view again";
+
+        // Sprites have moved on, the cached tiles must still be drawn around them in the same order
+        for (sint32 i = 0; i < 10; i++)
+        {
+            game_logic_update();
+        }
+        EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after game_logic_update";
+    }
+    gConfigGeneral.paint_cache = paintCache;
+
+    delete context;
+    SUCCEED();
+}
+
+TEST(PaintCacheTest, invalidated_by_changes)
+{
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    bool paintCache = gConfigGeneral.paint_cache;
+    for (const char * parkFile : ParkFiles)
+    {
+        LoadPark(parkFile);
+        gCheatsSandboxMode = true;
+        gParkFlags |= PARK_FLAGS_NO_MONEY;
+
+        sint32 sceneryX, sceneryY, direction;
+        ASSERT_TRUE(FindSceneryNextToFlatLand(&sceneryX, &sceneryY, &direction)) << parkFile;
+        sint32 x = sceneryX * 32;
+        sint32 y = sceneryY * 32;
+        sint32 landX = x + TileDirectionDelta[direction].x;
+        sint32 landY = y + TileDirectionDelta[direction].y;
+        sint32 wallType = FindStaticWallType();
+        ASSERT_NE(wallType, -1) << parkFile;
+
+        // Record the tiles before each change, a tile replayed from before it would be drawn differently
+        ASSERT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile;
+
+        // A wall on the edge of the land facing the scenery
+        sint32 wallEdge = (direction + 2) & 3;
+        money32 cost = game_do_command(
+            landX, GAME_COMMAND_FLAG_APPLY | (wallType << 8), landY, wallEdge | (COLOUR_BRIGHT_RED << 8), GAME_COMMAND_PLACE_WALL,
+            0, 0);
+        ASSERT_NE(cost, MONEY32_UNDEFINED) << parkFile;
+        EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after placing a wall";
+
+        rct_tile_element * wallElement = GetElementOfType(landX / 32, landY / 32, TILE_ELEMENT_TYPE_WALL);
+        ASSERT_NE(wallElement, nullptr) << parkFile;
+        cost = game_do_command(
+            landX, GAME_COMMAND_FLAG_APPLY, landY, wallEdge | (wallElement->base_height << 8), GAME_COMMAND_REMOVE_WALL, 0, 0);
+        ASSERT_NE(cost, MONEY32_UNDEFINED) << parkFile;
+        EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after removing a wall";
+
+        rct_tile_element * sceneryElement = GetElementOfType(sceneryX, sceneryY, TILE_ELEMENT_TYPE_SMALL_SCENERY);
+        sint32 primaryColour = (scenery_small_get_primary_colour(sceneryElement) + 1) % COLOUR_COUNT;
+        sint32 secondaryColour = scenery_small_get_secondary_colour(sceneryElement);
+        cost = game_do_command(
+            x, GAME_COMMAND_FLAG_APPLY | (sceneryElement->type << 8), y,
+            sceneryElement->base_height | (sceneryElement->properties.scenery.type << 8), GAME_COMMAND_SET_SCENERY_COLOUR, 0,
+            primaryColour | (secondaryColour << 8));
+        ASSERT_NE(cost, MONEY32_UNDEFINED) << parkFile;
+        EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after recolouring scenery";
+
+        // Only the neighbour changes, so the scenery tile is replayed unless the change invalidated it too
+        sint32 xBounds = landX | (landX << 16);
+        sint32 yBounds = landY | (landY << 16);
+        cost = game_do_command(
+            landX + 16, GAME_COMMAND_FLAG_APPLY, landY + 16, xBounds, GAME_COMMAND_RAISE_LAND, MAP_SELECT_TYPE_FULL, yBounds);
+        ASSERT_NE(cost, MONEY32_UNDEFINED) << parkFile;
+        EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after raising the land next to the scenery";
+
+        for (sint32 i = 0; i < 2; i++)
+        {
+            cost = game_do_command(
+                landX + 16, GAME_COMMAND_FLAG_APPLY, landY + 16, xBounds, GAME_COMMAND_LOWER_LAND, MAP_SELECT_TYPE_FULL,
+                yBounds);
+            ASSERT_NE(cost, MONEY32_UNDEFINED) << parkFile;
+            EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after lowering the land next to the scenery";
+        }
+
+        sceneryElement = GetElementOfType(sceneryX, sceneryY, TILE_ELEMENT_TYPE_SMALL_SCENERY);
+        cost = game_do_command(
+            x, GAME_COMMAND_FLAG_APPLY | (sceneryElement->type << 8), y,
+            sceneryElement->base_height | (sceneryElement->properties.scenery.type << 8), GAME_COMMAND_REMOVE_SCENERY, 0, 0);
+        ASSERT_NE(cost, MONEY32_UNDEFINED) << parkFile;
+        EXPECT_EQ(CountMismatchingColumns(0, 0), 0) << parkFile << " after removing scenery";
+
+        gCheatsSandboxMode = false;
+    }
+    gConfigGeneral.paint_cache = paintCache;
+
+    delete context;
+    SUCCEED();
+}
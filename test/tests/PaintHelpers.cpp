@@ -0,0 +1,52 @@
+#include <openrct2/Game.h>
+#include <openrct2/interface/Viewport.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/world/Map.h>
+#include "PaintHelpers.h"
+
+namespace PaintHelpers
+{
+    std::vector<uint32> GetDrawOrder(rct_drawpixelinfo * dpi, bool referenceArrange)
+    {
+        paint_session * session = paint_session_alloc(dpi);
+        paint_session_generate(session);
+        paint_struct psHead = referenceArrange ? paint_session_arrange_reference(session) : paint_session_arrange(session);
+
+        std::vector<uint32> order;
+        for (const paint_struct * ps = psHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            order.push_back(ps->image_id);
+            order.push_back(ps->bounds.x | (ps->bounds.y << 16));
+            order.push_back(ps->bounds.z | (ps->bounds.x_end << 16));
+            order.push_back(ps->bounds.y_end | (ps->bounds.z_end << 16));
+        }
+        paint_session_free(session);
+        return order;
+    }
+
+    std::vector<rct_drawpixelinfo> GetMapColumns(uint8 rotation, uint8 zoom)
+    {
+        gCurrentRotation = rotation;
+        reset_all_sprite_quadrant_placements();
+
+        rct_viewport viewport = {};
+        viewport.view_width = gMapSize * 32 * 2 + 8;
+        viewport.view_height = gMapSize * 32 + 128;
+        sint32 centre = (gMapSize / 2) * 32 + 16;
+        sint32 viewX, viewY;
+        centre_2d_coordinates(centre, centre, tile_element_height(centre, centre) & 0xFFFF, &viewX, &viewY, &viewport);
+
+        std::vector<rct_drawpixelinfo> columns;
+        for (sint32 x = floor2(viewX, 32); x < viewX + viewport.view_width; x += 32)
+        {
+            rct_drawpixelinfo dpi = {};
+            dpi.x = x;
+            dpi.y = viewY;
+            dpi.width = 32;
+            dpi.height = viewport.view_height;
+            dpi.zoom_level = zoom;
+            columns.push_back(dpi);
+        }
+        return columns;
+    }
+}
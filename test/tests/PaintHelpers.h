@@ -0,0 +1,19 @@
+#include <vector>
+#include <openrct2/common.h>
+#include <openrct2/drawing/Drawing.h>
+
+#pragma once
+
+namespace PaintHelpers
+{
+    /**
+     * Paints the given column and returns the paint structs in the order they would be drawn, each as its image
+     * followed by its bounding box.
+     */
+    std::vector<uint32> GetDrawOrder(rct_drawpixelinfo * dpi, bool referenceArrange = false);
+
+    /**
+     * Rotates the view and returns the columns of a view of the whole map at the given zoom.
+     */
+    std::vector<rct_drawpixelinfo> GetMapColumns(uint8 rotation, uint8 zoom);
+};
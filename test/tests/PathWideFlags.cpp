@@ -0,0 +1,102 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+#include "TestData.h"
+
+using namespace OpenRCT2;
+
+static std::vector<bool> GetWideFlags()
+{
+    std::vector<bool> wideFlags;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (tile_element_get_type(it.element) == TILE_ELEMENT_TYPE_PATH)
+        {
+            wideFlags.push_back(footpath_element_is_wide(it.element));
+        }
+    }
+    while (tile_element_iterator_next(&it));
+    return wideFlags;
+}
+
+/**
+ * Recalculates the wide flags of the whole map and checks that nothing changes.
+ */
+static void CheckWideFlagsSettled()
+{
+    std::vector<bool> wideFlags = GetWideFlags();
+    map_invalidate_all_path_wide_flags();
+    map_update_path_wide_flags();
+    ASSERT_EQ(GetWideFlags(), wideFlags);
+}
+
+TEST(PathWideFlagsTest, only_changed_tiles_need_updating)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    gOpenRCT2Headless = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    ParkLoadResult * plr = load_from_sv6(path.c_str());
+    ASSERT_EQ(ParkLoadResult_GetError(plr), PARK_LOAD_ERROR_OK);
+    ParkLoadResult_Delete(plr);
+
+    game_load_init();
+    game_logic_update();
+    CheckWideFlagsSettled();
+
+    // Remove every fifth path and put every other one of those back, so both sides of each change are covered
+    struct PathLocation
+    {
+        sint32 x, y, z, type, slope;
+    };
+    std::vector<PathLocation> paths;
+    tile_element_iterator it;
+    tile_element_iterator_begin(&it);
+    do
+    {
+        if (tile_element_get_type(it.element) == TILE_ELEMENT_TYPE_PATH && !footpath_element_is_queue(it.element))
+        {
+            sint32 slope = footpath_element_is_sloped(it.element) ?
+                (footpath_element_get_slope_direction(it.element) | TILE_ELEMENT_SLOPE_S_CORNER_UP) : 0;
+            paths.push_back({ it.x * 32, it.y * 32, it.element->base_height, footpath_element_get_type(it.element), slope });
+        }
+    }
+    while (tile_element_iterator_next(&it));
+    ASSERT_FALSE(paths.empty());
+
+    gCheatsSandboxMode = true;
+    gCheatsBuildInPauseMode = true;
+    for (size_t i = 0; i < paths.size(); i += 5)
+    {
+        const PathLocation &location = paths[i];
+        footpath_remove(location.x, location.y, location.z, GAME_COMMAND_FLAG_APPLY);
+    }
+    game_logic_update();
+    CheckWideFlagsSettled();
+
+    for (size_t i = 0; i < paths.size(); i += 10)
+    {
+        const PathLocation &location = paths[i];
+        footpath_place(location.type, location.x, location.y, location.z, location.slope, GAME_COMMAND_FLAG_APPLY);
+    }
+    game_logic_update();
+    CheckWideFlagsSettled();
+
+    delete context;
+    SUCCEED();
+}
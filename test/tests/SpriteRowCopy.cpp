@@ -0,0 +1,66 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+
+using SpriteRowCopyFunc = void (*)(const uint8 * src, uint8 * dst, sint32 count, sint32 zoomLevel);
+
+/**
+ * Copies rows of every length up to a few vectors at each zoom level with both the given function and the scalar one.
+ * The source ends exactly at the last pixel sampled and the destination is surrounded by guard bytes, so reading or
+ * writing past the row shows up (the former with a memory checker). Returns the number of rows that differ.
+ */
+static sint32 CountMismatchingRows(SpriteRowCopyFunc func, SpriteRowCopyFunc reference)
+{
+    constexpr sint32 Guard = 64;
+    std::mt19937 rng(42);
+    sint32 mismatches = 0;
+    for (sint32 zoomLevel = 0; zoomLevel < 4; zoomLevel++)
+    {
+        for (sint32 count = 0; count < 200; count++)
+        {
+            std::vector<uint8> src(count == 0 ? 0 : ((count - 1) << zoomLevel) + 1);
+            for (auto &pixel : src)
+            {
+                // Plenty of zeros, both alone and in runs, for the skip zero functions
+                pixel = (rng() % 3 == 0) ? 0 : (uint8)rng();
+            }
+
+            std::vector<uint8> expected(count + Guard * 2);
+            for (auto &pixel : expected)
+            {
+                pixel = (uint8)rng();
+            }
+            std::vector<uint8> actual = expected;
+
+            reference(src.data(), expected.data() + Guard, count, zoomLevel);
+            func(src.data(), actual.data() + Guard, count, zoomLevel);
+            if (actual != expected)
+            {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+TEST(SpriteRowCopyTest, sse4_1_matches_scalar)
+{
+    if (!sse41_available())
+    {
+        return;
+    }
+    EXPECT_EQ(CountMismatchingRows(sprite_row_copy_sse4_1, sprite_row_copy_scalar), 0);
+    EXPECT_EQ(CountMismatchingRows(sprite_row_copy_skip_zero_sse4_1, sprite_row_copy_skip_zero_scalar), 0);
+}
+
+TEST(SpriteRowCopyTest, avx2_matches_scalar)
+{
+    if (!avx2_available())
+    {
+        return;
+    }
+    EXPECT_EQ(CountMismatchingRows(sprite_row_copy_avx2, sprite_row_copy_scalar), 0);
+    EXPECT_EQ(CountMismatchingRows(sprite_row_copy_skip_zero_avx2, sprite_row_copy_skip_zero_scalar), 0);
+}